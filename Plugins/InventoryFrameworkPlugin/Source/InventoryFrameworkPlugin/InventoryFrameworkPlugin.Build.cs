@@ -43,6 +43,7 @@ public class InventoryFrameworkPlugin : ModuleRules
 				"SlateCore",
 				"GameplayTags",
 				"InputCore",
+				"ImageCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -5,9 +5,13 @@
 #include "Core/Components/ItemComponent.h"
 #include "Engine/GameInstance.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Data/IFP_MemoryTracking.h"
 #include "Core/Interfaces/I_Inventory.h"
+#include "Core/Subsystems/InventoryIconCacheSubsystem.h"
+#include "Core/Subsystems/InventoryWidgetPoolSubsystem.h"
 #include "Core/Traits/IT_ItemComponentTrait.h"
 #include "Core/Widgets/W_Container.h"
+#include "Core/Widgets/W_InventoryItem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
@@ -16,6 +20,7 @@
 #include "Core/Objects/Parents/ItemInstance.h"
 #include "Core/Widgets/W_AttachmentParent.h"
 #include "Engine/ActorChannel.h"
+#include "Engine/AssetManager.h"
 #include "LootTableSystem/Components/AC_LootTable.h"
 #include "LootTableSystem/Data/FL_LootTableHelpers.h"
 #include "Net/UnrealNetwork.h"
@@ -66,6 +71,9 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 	}
 	if(!Initialized)
 	{
+		LLM_SCOPE_BYTAG(InventoryFramework);
+		InvalidateItemPlacements();
+		
 		TArray<FS_ContainerSettings> ContainersToRemove;
 		//We need to call ItemEquipStatusUpdated AFTER everything has been processed,
 		//so keep a record of all items that were equipped.
@@ -528,6 +536,11 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 		RefreshIndexes();
 		Initialized = true;
 
+		/**Start streaming in everything the items are going to need.
+		 * Anything that isn't ready yet gets deferred instead of
+		 * stalling the game thread with a synchronous load.*/
+		PreLoadItemAssets();
+
 		if(GetOwner()->Implements<UI_Inventory>())
 		{
 			if(!II_Inventory::Execute_IsPreviewActor(GetOwner()))
@@ -547,8 +560,15 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 								continue;
 							}
 
-							//Try to load and get the default object.
-							Template = Cast<UItemInstance>(CurrentItem.ItemAsset->ItemInstance.LoadSynchronous()->GetDefaultObject());
+							UClass* InstanceClass = CurrentItem.ItemAsset->ItemInstance.Get();
+							if(!InstanceClass)
+							{
+								//Class is still streaming in, create the instance once it's ready.
+								DeferredItemInstances.Add(CurrentItem.UniqueID);
+								continue;
+							}
+							
+							Template = Cast<UItemInstance>(InstanceClass->GetDefaultObject());
 							if(!Template)
 							{
 								//Neither item struct nor item asset has a template
@@ -569,23 +589,159 @@ void UAC_Inventory::StartComponent(bool RemoveSkipValidationTags)
 			}
 		}
 
-		/**Alert any systems that want to work with the initialized inventory
-		 * data that everything is ready. Since we are about to initialize
-		 * equipment, which can be heavy, this is the ideal place to run
-		 * parallel work. Main example is the ItemQuery system*/
-		StartMultithreadWork.Broadcast();
+		/**Listeners expect every item to have its instance once the component
+		 * has started, so wait for the instances that had to be deferred.*/
+		if(DeferredItemInstances.IsEmpty())
+		{
+			FinishStartComponent();
+		}
+		else
+		{
+			WaitingForItemInstances = true;
+		}
+	}
+}
+
+void UAC_Inventory::FinishStartComponent()
+{
+	/**Alert any systems that want to work with the initialized inventory
+	 * data that everything is ready. Since we are about to initialize
+	 * equipment, which can be heavy, this is the ideal place to run
+	 * parallel work. Main example is the ItemQuery system*/
+	StartMultithreadWork.Broadcast();
 
-		for(auto& CurrentEquippedItem : EquippedItems)
+	for(auto& CurrentEquippedItem : EquippedItems)
+	{
+		UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(CurrentEquippedItem, true, TArray<FName>());
+	}
+	
+	for(auto& CurrentTable : LootTables)
+	{
+		CurrentTable->PostInventoryInitialized(this);
+	}
+
+	ComponentStarted.Broadcast();
+}
+
+void UAC_Inventory::PreLoadItemAssets()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PreLoadItemAssets)
+
+	//Clear out any handles that were canceled, completed ones are kept to keep their assets resident.
+	PreLoadHandles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Handle)
+	{
+		return !Handle.IsValid() || Handle->WasCanceled();
+	});
+	
+	TArray<FSoftObjectPath> ItemInstancePaths;
+	for(auto& CurrentInstance : GetUnloadedItemInstances())
+	{
+		ItemInstancePaths.Add(CurrentInstance.ToSoftObjectPath());
+	}
+	
+	TArray<FSoftObjectPath> ItemComponentPaths;
+	TArray<FSoftObjectPath> ItemIconPaths;
+	TArray<UDA_CoreItem*> ProcessedAssets;
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		for(auto& CurrentItem : CurrentContainer.Items)
 		{
-			UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(CurrentEquippedItem, true, TArray<FName>());
+			if(!IsValid(CurrentItem.ItemAsset) || ProcessedAssets.Contains(CurrentItem.ItemAsset))
+			{
+				continue;
+			}
+			ProcessedAssets.Add(CurrentItem.ItemAsset);
+
+			/**Traits are instanced inside the data asset, so they are already
+			 * loaded alongside it. Their component classes are not.*/
+			for(auto& CurrentComponent : CurrentItem.ItemAsset->GetItemComponentsFromTraits())
+			{
+				if(!CurrentComponent.IsNull() && !CurrentComponent.Get())
+				{
+					ItemComponentPaths.AddUnique(CurrentComponent.ToSoftObjectPath());
+				}
+			}
+
+			if(!CurrentItem.ItemAsset->UseGeneratedItemIcon && !CurrentItem.ItemAsset->InventoryImage.IsNull() && !CurrentItem.ItemAsset->InventoryImage.Get())
+			{
+				ItemIconPaths.AddUnique(CurrentItem.ItemAsset->InventoryImage.ToSoftObjectPath());
+			}
 		}
-		
-		for(auto& CurrentTable : LootTables)
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	
+	if(ItemInstancePaths.IsValidIndex(0))
+	{
+		PreLoadHandles.Add(StreamableManager.RequestAsyncLoad(ItemInstancePaths,
+			FStreamableDelegate::CreateUObject(this, &UAC_Inventory::OnItemInstancesPreLoaded), ItemInstancePreLoadPriority));
+	}
+
+	if(ItemComponentPaths.IsValidIndex(0))
+	{
+		PreLoadHandles.Add(StreamableManager.RequestAsyncLoad(ItemComponentPaths, FStreamableDelegate(), ItemComponentPreLoadPriority));
+	}
+
+	if(ItemIconPaths.IsValidIndex(0))
+	{
+		PreLoadHandles.Add(StreamableManager.RequestAsyncLoad(ItemIconPaths, FStreamableDelegate(), ItemIconPreLoadPriority));
+	}
+}
+
+bool UAC_Inventory::IsPreLoadingItemAssets() const
+{
+	for(auto& CurrentHandle : PreLoadHandles)
+	{
+		if(CurrentHandle.IsValid() && CurrentHandle->IsLoadingInProgress())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UAC_Inventory::IsItemInstanceDeferred(FS_UniqueID UniqueID) const
+{
+	return DeferredItemInstances.Contains(UniqueID);
+}
+
+void UAC_Inventory::OnItemInstancesPreLoaded()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(OnItemInstancesPreLoaded)
+	
+	TArray<FS_UniqueID> ItemsToProcess = DeferredItemInstances;
+	DeferredItemInstances.Empty();
+	
+	for(auto& CurrentID : ItemsToProcess)
+	{
+		FS_InventoryItem Item = GetItemByUniqueID(CurrentID);
+		if(!Item.IsValid() || IsValid(Item.ItemInstance))
+		{
+			//Item was removed or already received its instance
+			//through GetItemsInstance while we were loading.
+			continue;
+		}
+
+		UClass* InstanceClass = Item.ItemAsset->ItemInstance.Get();
+		if(!InstanceClass)
 		{
-			CurrentTable->PostInventoryInitialized(this);
+			//Load failed or the asset changed its item instance while loading.
+			continue;
 		}
 
-		ComponentStarted.Broadcast();
+		if(Cast<UItemInstance>(InstanceClass->GetDefaultObject())->ConstructOnRequest)
+		{
+			continue;
+		}
+
+		CreateItemInstanceForItem(Item);
+	}
+
+	if(WaitingForItemInstances && Initialized && DeferredItemInstances.IsEmpty())
+	{
+		WaitingForItemInstances = false;
+		FinishStartComponent();
 	}
 }
 
@@ -612,6 +768,9 @@ void UAC_Inventory::RefreshIndexes()
 	RefreshIDMap();
 	
 	UFL_InventoryFramework::SortContainers(ContainerSettings, ContainerSettings);
+
+	//Indexes and the container order may have changed.
+	InvalidateItemPlacements();
 }
 
 void UAC_Inventory::RefreshItemsIndexes(const FS_ContainerSettings Container)
@@ -629,6 +788,7 @@ void UAC_Inventory::RefreshItemsIndexes(const FS_ContainerSettings Container)
 
 	TArray<FS_ContainerSettings> ProcessedContainers;
 	UFL_InventoryFramework::SortItemsByIndex(ContainerRef.Items, ContainerRef.Items);
+	MarkContainerIndexDirty(Container.ContainerIndex);
 	for(int32 CurrentItem = 0; CurrentItem < ContainerRef.Items.Num(); CurrentItem++)
 	{
 		UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(ContainerRef.Items[CurrentItem]);
@@ -774,7 +934,9 @@ void UAC_Inventory::S_SendContainerDataToClient_Implementation(bool CallServerDa
 
 void UAC_Inventory::C_ReceiveServerContainerData_Implementation(const TArray<FS_ContainerSettings> &ServerContainerSettings, bool CallServerDataReceived)
 {
+	LLM_SCOPE_BYTAG(InventoryFramework);
 	ContainerSettings = ServerContainerSettings;
+	InvalidateItemPlacements();
 
 	//Clients receive container settings with no tile map, rebuild them.
 	for(auto& CurrentContainer : ContainerSettings)
@@ -825,9 +987,17 @@ void UAC_Inventory::StopComponent_Implementation()
 
 	//Set initialized to false so StartComponent can be called again.
 	Initialized = false;
+	WaitingForItemInstances = false;
 
 	GeneratedItemIcons.Empty();
 
+	//Every attachment widget is destroyed below.
+	for(auto& CurrentHandle : AttachmentReleaseHandles)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CurrentHandle.Value);
+	}
+	AttachmentReleaseHandles.Empty();
+
 	//Go through all items in all containers and wipe their attachment widget reference and item components.
 	for(auto& CurrentContainer : ContainerSettings)
 	{
@@ -887,51 +1057,58 @@ void UAC_Inventory::StopComponent_Implementation()
 	TArray<FS_ContainerSettings> NewContainerSettings = GetContainersForSaveState();
 
 	ContainerSettings = NewContainerSettings;
+	InvalidateItemPlacements();
 	ComponentStopped.Broadcast();
 }
 
 TArray<FS_ContainerSettings> UAC_Inventory::GetContainersForSaveState()
 {
 	TArray<FS_ContainerSettings> CleanedUpContainers;
+	CleanedUpContainers.Reserve(ContainerSettings.Num());
 
 	for(auto& CurrentContainer : ContainerSettings)
 	{
-		//Make a copy, we don't want to modify the containers.
-		FS_ContainerSettings ContainerCopy = CurrentContainer;
-		for(auto& CurrentItem : ContainerCopy.Items)
-		{
-			//While the save file already can't save object references,
-			//if we store object references inside the game instance they
-			//won't get garbage collected properly.
-			CurrentItem.UniqueID.ParentComponent = nullptr;
-			CurrentItem.ItemComponents.Empty();
-			CurrentItem.ExternalObjects.Empty();
-			CurrentItem.Widget = nullptr;
-			CurrentItem.ItemInstance = nullptr;
+		//Data has been cleaned, add it to the array.
+		CleanedUpContainers.Add(GetContainerForSaveState(CurrentContainer));
+	}
 
-			/**If the component has already been initialized, we can
-			 * safely assume that all validation has been processed,
-			 * so we can skip it for when we load the save, and all
-			 * loot tables have been processed.*/
-			if(Initialized)
-			{
-				CurrentItem.Tags.AddTagFast(IFP_SkipValidation);
-				CurrentItem.Tags.RemoveTag(IFP_IncludeLootTables);
-			}
-		}
-		
-		ContainerCopy.UniqueID.ParentComponent = nullptr;
-		ContainerCopy.Widget = nullptr;
+	return CleanedUpContainers;
+}
+
+FS_ContainerSettings UAC_Inventory::GetContainerForSaveState(const FS_ContainerSettings& Container)
+{
+	//Make a copy, we don't want to modify the containers.
+	FS_ContainerSettings ContainerCopy = Container;
+	for(auto& CurrentItem : ContainerCopy.Items)
+	{
+		//While the save file already can't save object references,
+		//if we store object references inside the game instance they
+		//won't get garbage collected properly.
+		CurrentItem.UniqueID.ParentComponent = nullptr;
+		CurrentItem.ItemComponents.Empty();
+		CurrentItem.ExternalObjects.Empty();
+		CurrentItem.Widget = nullptr;
+		CurrentItem.ItemInstance = nullptr;
+
+		/**If the component has already been initialized, we can
+		 * safely assume that all validation has been processed,
+		 * so we can skip it for when we load the save, and all
+		 * loot tables have been processed.*/
 		if(Initialized)
 		{
-			ContainerCopy.Tags.AddTagFast(IFP_SkipValidation);
+			CurrentItem.Tags.AddTagFast(IFP_SkipValidation);
+			CurrentItem.Tags.RemoveTag(IFP_IncludeLootTables);
 		}
-		
-		//Data has been cleaned, add it to the array.
-		CleanedUpContainers.Add(ContainerCopy);
+	}
+	
+	ContainerCopy.UniqueID.ParentComponent = nullptr;
+	ContainerCopy.Widget = nullptr;
+	if(Initialized)
+	{
+		ContainerCopy.Tags.AddTagFast(IFP_SkipValidation);
 	}
 
-	return CleanedUpContainers;
+	return ContainerCopy;
 }
 
 void UAC_Inventory::ResetAllUniqueIDs()
@@ -1127,6 +1304,249 @@ void UAC_Inventory::RemoveUniqueIDFromIDMap(FS_UniqueID UniqueID)
 	ID_Map.Remove(UniqueID.IdentityNumber);
 }
 
+void UAC_Inventory::MarkContainerDirty(FS_UniqueID ContainerID)
+{
+	UAC_Inventory* ParentComponent = IsValid(ContainerID.ParentComponent) ? ContainerID.ParentComponent : this;
+	
+	if(ContainerID.IdentityNumber < 1)
+	{
+		//Can't tell which container this is, throw all the item placements away.
+		ParentComponent->InvalidateItemPlacements();
+		return;
+	}
+
+	ParentComponent->DirtyContainers.Add(ContainerID.IdentityNumber);
+
+	const int32 ContainerIndex = ParentComponent->FindContainerIndex(ContainerID);
+	if(!ParentComponent->ContainerSettings.IsValidIndex(ContainerIndex))
+	{
+		return;
+	}
+
+	/**Only this containers table gets rebuilt. The Internal_ functions mark their
+	 * containers before modifying them and any nested modification marks again,
+	 * so a table built halfway through a modification is never reused.*/
+	if(ParentComponent->ItemPlacementTables.IsValidIndex(ContainerIndex))
+	{
+		ParentComponent->ItemPlacementTables[ContainerIndex].Version++;
+	}
+
+	//Virtualized grids draw straight from the container settings.
+	UW_Container* ContainerWidget = ParentComponent->ContainerSettings[ContainerIndex].Widget;
+	if(IsValid(ContainerWidget) && ContainerWidget->UseVirtualizedGrid)
+	{
+		ContainerWidget->MarkVirtualizedGridDirty();
+	}
+}
+
+void UAC_Inventory::MarkAllContainersDirty()
+{
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		MarkContainerDirty(CurrentContainer.UniqueID);
+	}
+}
+
+TSet<int32> UAC_Inventory::ConsumeDirtyContainers()
+{
+	TSet<int32> ConsumedContainers = MoveTemp(DirtyContainers);
+	DirtyContainers.Reset();
+	return ConsumedContainers;
+}
+
+void UAC_Inventory::MarkItemsContainerDirty(const FS_InventoryItem& Item)
+{
+	if(UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent)
+	{
+		ParentComponent->MarkContainerIndexDirty(Item.ContainerIndex);
+	}
+}
+
+void UAC_Inventory::MarkContainerIndexDirty(int32 ContainerIndex)
+{
+	if(ContainerSettings.IsValidIndex(ContainerIndex))
+	{
+		MarkContainerDirty(ContainerSettings[ContainerIndex].UniqueID);
+	}
+}
+
+const TArray<FIFP_ItemPlacement>& UAC_Inventory::GetItemPlacements(int32 ContainerIndex)
+{
+	static const TArray<FIFP_ItemPlacement> EmptyPlacements;
+	if(!ContainerSettings.IsValidIndex(ContainerIndex))
+	{
+		return EmptyPlacements;
+	}
+
+	if(ItemPlacementTables.Num() != ContainerSettings.Num())
+	{
+		ItemPlacementTables.SetNum(ContainerSettings.Num());
+	}
+
+	FItemPlacementTable& Table = ItemPlacementTables[ContainerIndex];
+	const TArray<FS_InventoryItem>& Items = ContainerSettings[ContainerIndex].Items;
+	const int32 ContainerIdentity = ContainerSettings[ContainerIndex].UniqueID.IdentityNumber;
+	if(Table.BuiltVersion == Table.Version && Table.ContainerIdentity == ContainerIdentity && Table.Placements.Num() == Items.Num())
+	{
+		return Table.Placements;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::BuildItemPlacements)
+	Table.Placements.Reset(Items.Num());
+	for(const FS_InventoryItem& CurrentItem : Items)
+	{
+		FIFP_ItemPlacement& Placement = Table.Placements.AddDefaulted_GetRef();
+		Placement.ItemAsset = CurrentItem.ItemAsset;
+		Placement.IdentityNumber = CurrentItem.UniqueID.IdentityNumber;
+		Placement.ItemIndex = CurrentItem.ItemIndex;
+		Placement.TileIndex = CurrentItem.TileIndex;
+		Placement.Count = CurrentItem.Count;
+		Placement.Rotation = CurrentItem.Rotation;
+	}
+	Table.BuiltVersion = Table.Version;
+	Table.ContainerIdentity = ContainerIdentity;
+	
+	return Table.Placements;
+}
+
+FS_InventoryMemoryReport UAC_Inventory::GetMemoryReport()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::GetMemoryReport)
+	
+	FS_InventoryMemoryReport Report;
+
+	auto GetObjectSize = [](const UObject* Object) -> int64
+	{
+		return IsValid(Object) ? Object->GetClass()->GetStructureSize() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive) : 0;
+	};
+
+	Report.Containers = ContainerSettings.GetAllocatedSize() + DirtyContainers.GetAllocatedSize();
+	for(auto& CurrentContainer : ContainerSettings)
+	{
+		Report.TileMaps += CurrentContainer.GetTileMapAllocatedSize();
+		Report.Containers += CurrentContainer.GetAllocatedSize(false) - CurrentContainer.GetTileMapAllocatedSize();
+		Report.Items += CurrentContainer.Items.GetAllocatedSize();
+		Report.Widgets += GetObjectSize(CurrentContainer.Widget);
+		
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			Report.Items += CurrentItem.GetAllocatedSize();
+			Report.Widgets += GetObjectSize(CurrentItem.Widget);
+			Report.ItemInstances += GetObjectSize(CurrentItem.ItemInstance);
+			for(auto& CurrentItemComponent : CurrentItem.ItemComponents)
+			{
+				Report.ItemComponents += GetObjectSize(CurrentItemComponent);
+			}
+		}
+	}
+
+	Report.Items += ItemPlacementTables.GetAllocatedSize();
+	for(auto& CurrentTable : ItemPlacementTables)
+	{
+		Report.Items += CurrentTable.Placements.GetAllocatedSize();
+	}
+
+	Report.IDMap = ID_Map.GetAllocatedSize();
+
+	Report.Icons = GeneratedItemIcons.GetAllocatedSize();
+	for(auto& CurrentIcon : GeneratedItemIcons)
+	{
+		if(IsValid(CurrentIcon.Value))
+		{
+			Report.Icons += CurrentIcon.Value->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	return Report;
+}
+
+void UAC_Inventory::InvalidateItemPlacements()
+{
+	ItemPlacementTables.Reset();
+}
+
+int32 UAC_Inventory::FindContainerIndex(FS_UniqueID ContainerID) const
+{
+	const FS_IDMapEntry* Entry = ID_Map.Find(ContainerID.IdentityNumber);
+	if(Entry && Entry->IsContainer && ContainerSettings.IsValidIndex(Entry->Directions.X) && ContainerSettings[Entry->Directions.X].UniqueID.IdentityNumber == ContainerID.IdentityNumber)
+	{
+		return Entry->Directions.X;
+	}
+
+	return ContainerSettings.IndexOfByPredicate([ContainerID](const FS_ContainerSettings& Container)
+	{
+		return Container.UniqueID.IdentityNumber == ContainerID.IdentityNumber;
+	});
+}
+
+void UAC_Inventory::BenchmarkItemPlacements(UDA_CoreItem* ItemAsset, int32 Iterations)
+{
+	if(Iterations <= 0)
+	{
+		return;
+	}
+
+	int32 ItemCount = 0;
+	SIZE_T ItemsMemory = 0;
+	SIZE_T PlacementsMemory = 0;
+	for(int32 ContainerIndex = 0; ContainerIndex < ContainerSettings.Num(); ContainerIndex++)
+	{
+		ItemCount += ContainerSettings[ContainerIndex].Items.Num();
+		ItemsMemory += ContainerSettings[ContainerIndex].Items.GetAllocatedSize();
+		for(auto& CurrentItem : ContainerSettings[ContainerIndex].Items)
+		{
+			ItemsMemory += CurrentItem.GetAllocatedSize();
+		}
+		PlacementsMemory += GetItemPlacements(ContainerIndex).GetAllocatedSize();
+	}
+
+	//Same query both ways, the total count of the asset across every container.
+	int32 ItemsResult = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for(int32 CurrentIteration = 0; CurrentIteration < Iterations; CurrentIteration++)
+	{
+		ItemsResult = 0;
+		for(auto& CurrentContainer : ContainerSettings)
+		{
+			for(auto& CurrentItem : CurrentContainer.Items)
+			{
+				if(CurrentItem.ItemAsset == ItemAsset)
+				{
+					ItemsResult += CurrentItem.Count;
+				}
+			}
+		}
+	}
+	const double ItemsTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 PlacementsResult = 0;
+	StartTime = FPlatformTime::Seconds();
+	for(int32 CurrentIteration = 0; CurrentIteration < Iterations; CurrentIteration++)
+	{
+		PlacementsResult = 0;
+		for(int32 ContainerIndex = 0; ContainerIndex < ContainerSettings.Num(); ContainerIndex++)
+		{
+			for(const FIFP_ItemPlacement& CurrentPlacement : GetItemPlacements(ContainerIndex))
+			{
+				if(CurrentPlacement.ItemAsset == ItemAsset)
+				{
+					PlacementsResult += CurrentPlacement.Count;
+				}
+			}
+		}
+	}
+	const double PlacementsTime = FPlatformTime::Seconds() - StartTime;
+
+	const double ToAverageUs = 1000000.0 / Iterations;
+	UKismetSystemLibrary::PrintString(this, FString::Printf(
+		TEXT("IFP item placement benchmark: %d containers, %d items, %d iterations\n")
+		TEXT("Items: %llu bytes (%d per item), scan %.3fus, found %d\n")
+		TEXT("Placements: %llu bytes (%d per item), scan %.3fus, found %d"),
+		ContainerSettings.Num(), ItemCount, Iterations,
+		(uint64)ItemsMemory, (int32)sizeof(FS_InventoryItem), ItemsTime * ToAverageUs, ItemsResult,
+		(uint64)PlacementsMemory, (int32)sizeof(FIFP_ItemPlacement), PlacementsTime * ToAverageUs, PlacementsResult), true, true, FLinearColor::Green, 15);
+}
+
 bool UAC_Inventory::ValidateIDMap(TArray<FS_ContainerSettings>& MissingContainers,
 	TArray<FS_InventoryItem>& MissingItems, TArray<FS_UniqueID>& UnknownIDs, TArray<FS_UniqueID> &IncorrectDirections)
 {
@@ -1552,6 +1972,13 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE("Move Item")
 	
+	//Both the origin and destination container are being modified.
+	MarkItemsContainerDirty(ItemToMove);
+	if(IsValid(ToComponent))
+	{
+		ToComponent->MarkContainerIndexDirty(ToContainer);
+	}
+	
 	if(!IsValid(FromComponent) || !IsValid(ToComponent))
 	{
 		return;
@@ -1632,7 +2059,7 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 				
 					if(ContainerWidget)
 					{
-						ContainerWidget->CreateWidgetForItem(NewStackItem, ItemWidget);
+						ItemWidget = ContainerWidget->RequestWidgetForItem(NewStackItem);
 					}
 
 					UFL_ExternalObjects::BroadcastItemCountUpdated(ItemToMove, ItemToMove.Count, NewCount);
@@ -1659,7 +2086,7 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 		{
 			if(IsValid(ContainerWidget))
 			{
-				ContainerWidget->CreateWidgetForItem(NewlyCreatedItem, ItemWidget);
+				ItemWidget = ContainerWidget->RequestWidgetForItem(NewlyCreatedItem);
 			}
 		}
 		
@@ -1898,7 +2325,7 @@ void UAC_Inventory::Internal_MoveItem(FS_InventoryItem ItemToMove, UAC_Inventory
 			ContainerWidget = UFL_InventoryFramework::GetWidgetForContainer(ToComponent->ContainerSettings[ToContainer]);
 			if(IsValid(ContainerWidget))
 			{
-				ContainerWidget->CreateWidgetForItem(NewlyCreatedItem, ItemWidget);
+				ItemWidget = ContainerWidget->RequestWidgetForItem(NewlyCreatedItem);
 			}
 			ToComponent->RefreshItemsIndexes(ToComponent->ContainerSettings[ToContainer]);
 		}
@@ -2460,6 +2887,8 @@ void UAC_Inventory::C_RemoveItemFromInventory_Implementation(FS_UniqueID ItemID,
 void UAC_Inventory::Internal_RemoveItemFromInventory_Implementation(FS_InventoryItem Item, bool CallItemRemoved, bool CallItemUnequipped, bool RemoveItemComponents,
 	bool RemoveItemsContainers, bool RemoveItemInstance, FRandomStream Seed, bool& Success)
 {
+	MarkItemsContainerDirty(Item);
+	
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
 	if(!ParentComponent)
 	{
@@ -2603,7 +3032,11 @@ UW_AttachmentParent* UAC_Inventory::CreateAttachmentWidgetForItem(FS_InventoryIt
 		if(ItemsContainers.IsValidIndex(0))
 		{
 			//Create the attachment widget and assign it to the item.
-			NewWidget = CreateWidget<UW_AttachmentParent>(GetWorld(), AttachmentWidget);
+			NewWidget = UInventoryWidgetPoolSubsystem::AcquireWidget<UW_AttachmentParent>(GetWorld(), AttachmentWidget);
+			if(!NewWidget)
+			{
+				return nullptr;
+			}
 			ContainerSettings[Item.ContainerIndex].Items[Item.ItemIndex].ExternalObjects.Add(NewWidget);
 			if(DoNotBind)
 			{
@@ -2643,6 +3076,174 @@ UW_AttachmentParent* UAC_Inventory::CreateAttachmentWidgetForItem(FS_InventoryIt
 	return NewWidget;
 }
 
+UW_AttachmentParent* UAC_Inventory::ExpandAttachmentWidget(FS_InventoryItem Item)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::ExpandAttachmentWidget)
+
+	if(Item.UniqueID.ParentComponent && Item.UniqueID.ParentComponent != this)
+	{
+		return Item.UniqueID.ParentComponent->ExpandAttachmentWidget(Item);
+	}
+
+	CancelAttachmentRelease(Item.UniqueID.IdentityNumber);
+	Item = GetItemByUniqueID(Item.UniqueID);
+	if(!Item.IsValid())
+	{
+		return nullptr;
+	}
+
+	return UFL_InventoryFramework::GetItemsAttachmentWidget(Item, true);
+}
+
+void UAC_Inventory::CollapseAttachmentWidget(FS_InventoryItem Item)
+{
+	if(Item.UniqueID.ParentComponent && Item.UniqueID.ParentComponent != this)
+	{
+		Item.UniqueID.ParentComponent->CollapseAttachmentWidget(Item);
+		return;
+	}
+
+	if(AttachmentWidgetIdleTime < 0 || AttachmentReleaseHandles.Contains(Item.UniqueID.IdentityNumber))
+	{
+		return;
+	}
+
+	Item = GetItemByUniqueID(Item.UniqueID);
+	UW_AttachmentParent* AttachmentWidget = Item.IsValid() ? UFL_InventoryFramework::GetItemsAttachmentWidget(Item, false) : nullptr;
+	if(!IsValid(AttachmentWidget) || AttachmentWidget->IsInViewport() || AttachmentWidget->GetParent())
+	{
+		//Nothing to release, or the item is still opened.
+		return;
+	}
+
+	if(AttachmentWidgetIdleTime == 0)
+	{
+		ReleaseAttachmentWidget(Item);
+		return;
+	}
+
+	const FS_UniqueID ItemID = Item.UniqueID;
+	AttachmentReleaseHandles.Add(ItemID.IdentityNumber, FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, ItemID](float DeltaTime)
+	{
+		AttachmentReleaseHandles.Remove(ItemID.IdentityNumber);
+		FS_InventoryItem IdleItem = GetItemByUniqueID(ItemID);
+		UW_AttachmentParent* IdleWidget = IdleItem.IsValid() ? UFL_InventoryFramework::GetItemsAttachmentWidget(IdleItem, false) : nullptr;
+		if(IsValid(IdleWidget) && (IdleWidget->IsInViewport() || IdleWidget->GetParent()))
+		{
+			//The item was opened since it was collapsed, keep it until it's collapsed again.
+			return false;
+		}
+		ReleaseAttachmentWidget(IdleItem);
+		return false;
+	}), AttachmentWidgetIdleTime));
+}
+
+void UAC_Inventory::ReleaseAttachmentWidget(FS_InventoryItem Item)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAC_Inventory::ReleaseAttachmentWidget)
+
+	if(Item.UniqueID.ParentComponent && Item.UniqueID.ParentComponent != this)
+	{
+		Item.UniqueID.ParentComponent->ReleaseAttachmentWidget(Item);
+		return;
+	}
+
+	CancelAttachmentRelease(Item.UniqueID.IdentityNumber);
+	Item = GetItemByUniqueID(Item.UniqueID);
+	UW_AttachmentParent* AttachmentWidget = Item.IsValid() ? UFL_InventoryFramework::GetItemsAttachmentWidget(Item, false) : nullptr;
+	if(!IsValid(AttachmentWidget))
+	{
+		return;
+	}
+
+	for(const int32 ContainerIndex : GetItemsChildrenContainerIndexes(Item))
+	{
+		//Attachment widgets of the items inside are usually hosted by this widget.
+		TArray<FS_UniqueID> ChildItems;
+		for(auto& CurrentItem : ContainerSettings[ContainerIndex].Items)
+		{
+			ChildItems.Add(CurrentItem.UniqueID);
+		}
+
+		for(auto& CurrentItemID : ChildItems)
+		{
+			FS_InventoryItem ChildItem;
+			ChildItem.UniqueID = CurrentItemID;
+			ReleaseAttachmentWidget(ChildItem);
+		}
+
+		if(UW_Container* ContainerWidget = ContainerSettings[ContainerIndex].Widget)
+		{
+			ContainerWidget->ReleaseWidgetsToPool();
+			II_ExternalObjects::Execute_RemoveWidgetReferences(ContainerWidget);
+			ContainerSettings[ContainerIndex].Widget = nullptr;
+		}
+	}
+
+	UFL_InventoryFramework::RemoveItemAttachmentWidget(Item, false);
+	if(UInventoryWidgetPoolSubsystem* WidgetPool = UInventoryWidgetPoolSubsystem::Get(AttachmentWidget))
+	{
+		WidgetPool->ReleaseWidget(AttachmentWidget);
+	}
+}
+
+bool UAC_Inventory::FindItemIcon(UDA_CoreItem* ItemAsset, FSlateBrush& Icon)
+{
+	if(!IsValid(ItemAsset))
+	{
+		return false;
+	}
+
+	UInventoryIconCacheSubsystem* IconCache = UInventoryIconCacheSubsystem::Get(this);
+	if(IconCache && UInventoryIconCacheSubsystem::CanCacheIcon(ItemAsset))
+	{
+		return IconCache->FindIcon(ItemAsset, Icon);
+	}
+
+	UTextureRenderTarget2D* RenderTarget = GeneratedItemIcons.FindRef(ItemAsset->GetFName());
+	if(!IsValid(RenderTarget))
+	{
+		return false;
+	}
+
+	Icon.SetResourceObject(RenderTarget);
+	Icon.SetImageSize(FVector2D(RenderTarget->SizeX, RenderTarget->SizeY));
+	return true;
+}
+
+void UAC_Inventory::StoreItemIcon(UDA_CoreItem* ItemAsset, UTextureRenderTarget2D* RenderTarget, FSlateBrush& Icon)
+{
+	if(!IsValid(ItemAsset) || !IsValid(RenderTarget))
+	{
+		return;
+	}
+
+	UInventoryIconCacheSubsystem* IconCache = UInventoryIconCacheSubsystem::Get(this);
+	if(IconCache && IconCache->StoreIcon(ItemAsset, RenderTarget, Icon))
+	{
+		//The atlas owns the icon now, don't keep the render target alive as well.
+		GeneratedItemIcons.Remove(ItemAsset->GetFName());
+		return;
+	}
+
+	Icon.SetResourceObject(RenderTarget);
+	Icon.SetImageSize(FVector2D(RenderTarget->SizeX, RenderTarget->SizeY));
+
+	if(ItemAsset->OptimizeIconCreation)
+	{
+		GeneratedItemIcons.Add(ItemAsset->GetFName(), RenderTarget);
+	}
+}
+
+void UAC_Inventory::CancelAttachmentRelease(int32 ItemIdentityNumber)
+{
+	FTSTicker::FDelegateHandle Handle;
+	if(AttachmentReleaseHandles.RemoveAndCopyValue(ItemIdentityNumber, Handle))
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Handle);
+	}
+}
+
 void UAC_Inventory::TryAddNewItem(FS_InventoryItem Item, TArray<FS_ContainerSettings> ItemsContainers, UAC_Inventory* DestinationComponent, bool CallItemAdded, bool SkipStacking, bool& Result, FS_InventoryItem& NewItem, int32& StackDelta)
 {
 	if(!UKismetSystemLibrary::IsServer(this))
@@ -2744,6 +3345,7 @@ void UAC_Inventory::C_TryAddNewItem_Implementation(FS_InventoryItem Item, const
 void UAC_Inventory::Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_ContainerSettings> ItemsContainers, UAC_Inventory* DestinationComponent, bool CallItemAdded, bool SkipStacking,
 	FRandomStream Seed, bool& Result, FS_InventoryItem& NewItem, int32& StackDelta)
 {
+	LLM_SCOPE_BYTAG(InventoryFramework);
 	StackDelta = 0;
 	
 	if(!IsValid(Item.ItemAsset) || !IsValid(DestinationComponent))
@@ -2842,6 +3444,7 @@ void UAC_Inventory::Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_Cont
 								NewItem = CurrentItem;
 								Result = true;
 								NewItem = DestinationComponent->GetItemByUniqueID(CurrentItem.UniqueID);
+								MarkItemsContainerDirty(NewItem);
 								return;
 							}
 						}
@@ -3042,7 +3645,7 @@ void UAC_Inventory::Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_Cont
 	if(IsValid(WidgetContainer))
 	{
 		UW_InventoryItem* ItemWidget;
-		WidgetContainer->CreateWidgetForItem(Item, ItemWidget);
+		ItemWidget = WidgetContainer->RequestWidgetForItem(Item);
 	}
 	DestinationComponent->RefreshIndexes();
 	DestinationComponent->RefreshItemsIndexes(DestinationComponent->ContainerSettings[AvailableContainer.ContainerIndex]);
@@ -3057,6 +3660,7 @@ void UAC_Inventory::Internal_TryAddNewItem(FS_InventoryItem Item, TArray<FS_Cont
 	Item = DestinationComponent->GetItemByUniqueID(Item.UniqueID);
 	NewItem = Item;
 	StackDelta = NewItem.Count;
+	MarkItemsContainerDirty(NewItem);
 
 	if(CallItemAdded)
 	{
@@ -3216,6 +3820,9 @@ void UAC_Inventory::C_StackTwoItems_Implementation(FS_UniqueID Item1ID, FS_Uniqu
 
 void UAC_Inventory::Internal_StackTwoItems(FS_InventoryItem Item1, FS_InventoryItem Item2, int32& Item1RemainingCount, int32& Item2NewStackCount)
 {
+	MarkItemsContainerDirty(Item1);
+	MarkItemsContainerDirty(Item2);
+	
 	if(UFL_InventoryFramework::IsItemValid(Item1) && UFL_InventoryFramework::IsItemValid(Item2))
 	{
 		FS_InventoryItem& Item1Ref = Item1.UniqueID.ParentComponent->ContainerSettings[Item1.ContainerIndex].Items[Item1.ItemIndex];
@@ -3368,6 +3975,9 @@ void UAC_Inventory::C_SplitItem_Implementation(FS_InventoryItem Item, int32 Spli
 void UAC_Inventory::Internal_SplitItem(FS_InventoryItem Item, int32 SplitAmount, UAC_Inventory* DestinationComponent, int32 NewStackContainerIndex, int32 NewStackTileIndex,
 	FS_UniqueID NewStackUniqueID, int32& Item1RemainingCount, int32& Item2NewStackCount, FRandomStream Seed)
 {
+	MarkItemsContainerDirty(Item);
+	DestinationComponent->MarkContainerIndexDirty(NewStackContainerIndex);
+	
 	//First check if there's a colliding item. If we can stack with it, attempt to stack.
 	bool SpotAvailable;
 	int32 AvailableTile;
@@ -3454,7 +4064,7 @@ void UAC_Inventory::Internal_SplitItem(FS_InventoryItem Item, int32 SplitAmount,
 	if(UW_Container* ContainerWidget = UFL_InventoryFramework::GetWidgetForContainer(DestinationComponent->ContainerSettings[NewStackContainerIndex]))
 	{
 		UW_InventoryItem* ItemWidget = nullptr;
-		ContainerWidget->CreateWidgetForItem(NewStackItem, ItemWidget);
+		ItemWidget = ContainerWidget->RequestWidgetForItem(NewStackItem);
 	}
 	
 	DestinationComponent->RefreshItemsIndexes(ContainerSettings[NewStackContainerIndex]);
@@ -3564,6 +4174,8 @@ void UAC_Inventory::Internal_IncreaseItemCount(FS_UniqueID ItemID, int32 Count,
 		return;
 	}
 
+	MarkItemsContainerDirty(Item);
+
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
 	if(!ParentComponent)
 	{
@@ -3677,6 +4289,8 @@ void UAC_Inventory::C_ReduceItemCount_Implementation(FS_UniqueID ItemID, int32 C
 
 void UAC_Inventory::Internal_ReduceItemCount(FS_InventoryItem Item, int32 Count, bool RemoveItemIf0, FRandomStream Seed)
 {
+	MarkItemsContainerDirty(Item);
+	
 	if(!IsValid(Item.UniqueID.ParentComponent))
 	{
 		return;
@@ -3822,6 +4436,11 @@ void UAC_Inventory::Internal_MassReduceCount(UDA_CoreItem* Item, int32 Count, UA
 		return;
 	}
 
+	for(auto& CurrentMatch : MatchingItems)
+	{
+		MarkItemsContainerDirty(CurrentMatch.Item);
+	}
+
 	for(auto& CurrentItem : MatchingItems)
 	{
 		TargetComponent->Internal_ReduceItemCount(CurrentItem.Item, CurrentItem.Count, RemoveItemsIf0, Seed);
@@ -3934,6 +4553,8 @@ void UAC_Inventory::C_UpdateItemsOverrideSettings_Implementation(FS_UniqueID Ite
 
 void UAC_Inventory::Internal_UpdateItemsOverrideSettings(FS_InventoryItem Item, FS_ItemOverwriteSettings NewSettings)
 {
+	MarkItemsContainerDirty(Item);
+	
 	//Store old settings for interface call.
 	FS_ItemOverwriteSettings OldOverride = Item.OverrideSettings;
 	
@@ -4080,6 +4701,8 @@ void UAC_Inventory::C_AddTagToItem_Implementation(FS_UniqueID ItemID, FGameplayT
 
 void UAC_Inventory::Internal_AddTagToItem(FS_InventoryItem Item, FGameplayTag Tag)
 {
+	MarkItemsContainerDirty(Item);
+	
 	if(Item.Tags.HasTagExact(Tag))
 	{
 		return;
@@ -4207,6 +4830,8 @@ void UAC_Inventory::C_RemoveTagFromItem_Implementation(FS_UniqueID ItemID, FGame
 
 void UAC_Inventory::Internal_RemoveTagFromItem(FS_InventoryItem Item, FGameplayTag Tag)
 {
+	MarkItemsContainerDirty(Item);
+	
 	if(!Item.Tags.HasTagExact(Tag))
 	{
 		return;
@@ -4426,6 +5051,8 @@ void UAC_Inventory::C_SetTagValueForItem_Implementation(FS_UniqueID ItemID, FGam
 
 void UAC_Inventory::Internal_SetTagValueForItem(FS_InventoryItem Item, FGameplayTag Tag, float Value, bool AddIfNotFound, TSubclassOf<UO_TagValueCalculation> CalculationClass, bool& Success)
 {
+	MarkItemsContainerDirty(Item);
+	
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
 	Success = false;
 	
@@ -4607,6 +5234,8 @@ void UAC_Inventory::C_RemoveTagValueFromItem_Implementation(FS_UniqueID ItemID,
 
 void UAC_Inventory::Internal_RemoveTagValueFromItem(FS_InventoryItem Item, FGameplayTag Tag)
 {
+	MarkItemsContainerDirty(Item);
+	
 	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
 	
 	if(!IsValid(ParentComponent))
@@ -4880,6 +5509,8 @@ void UAC_Inventory::C_SortAndMoveItems_Implementation(ESortingType SortType, FS_
 
 void UAC_Inventory::Internal_SortAndMoveItems(TEnumAsByte<ESortingType> SortType, const FS_ContainerSettings& Container, float StaggerTimer, FRandomStream Seed)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	UAC_Inventory* ParentComponent = Container.UniqueID.ParentComponent;
 
 	if(!IsValid(ParentComponent))
@@ -4984,6 +5615,7 @@ void UAC_Inventory::Internal_SortAndMoveItems(TEnumAsByte<ESortingType> SortType
 void UAC_Inventory::T_SortAndMoveItems(UAC_Inventory* ParentComponent, const FS_ContainerSettings& Container, FS_InventoryItem Item, FRandomStream Seed, bool bLastItem)
 {
 	ParentComponent->ContainerSettings[Container.ContainerIndex].Items.Add(Item);
+	ParentComponent->MarkContainerIndexDirty(Container.ContainerIndex);
 	Item.ItemIndex = ParentComponent->ContainerSettings[Container.ContainerIndex].Items.Num() - 1;
 	bool SpotFound;
 	int32 AvailableTile;
@@ -5088,6 +5720,15 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 		return nullptr;
 	}
 
+	/**If the component class isn't loaded, then no component of that class can exist
+	 * yet either. Request it and construct the component once it has finished loading.*/
+	TSubclassOf<UItemComponent> ItemComponentClass = Trait->ItemComponent.Get();
+	if(!ItemComponentClass && CreateComponent && Trait->ConstructionPolicy != Custom)
+	{
+		RequestItemComponentClass(Item, Trait, Instigator, Event, Payload);
+		return nullptr;
+	}
+
 	if(!UKismetSystemLibrary::IsServer(this) && !UKismetSystemLibrary::IsStandalone(this))
 	{
 		C_AddItemToNetworkQueue(Item.UniqueID);
@@ -5118,7 +5759,7 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 		{
 			if(UKismetSystemLibrary::IsServer(this) || Trait->NetworkingMethod == Both)
 			{
-				S_ConstructServerItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, Trait->ItemComponent.LoadSynchronous(), Event, Payload);
+				S_ConstructServerItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, ItemComponentClass, Event, Payload);
 				if(UKismetSystemLibrary::IsServer(this))
 				{
 					//Server has created the item component, try and find it and return it.
@@ -5149,7 +5790,7 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 		{
 			if(!UKismetSystemLibrary::IsDedicatedServer(this))
 			{
-				C_ConstructClientItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, Trait->ItemComponent.LoadSynchronous(), Event, Payload);
+				C_ConstructClientItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, ItemComponentClass, Event, Payload);
 				UItemComponent* LatestItemComponent = nullptr;
 				//Item Struct might not be valid, so search all components
 				for(auto& CurrentComponent : GetItemComponentOwner()->GetComponents())
@@ -5196,7 +5837,7 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 			{
 				if(UKismetSystemLibrary::IsServer(this) || Trait->NetworkingMethod == Both)
 				{
-					S_ConstructServerItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, Trait->ItemComponent.LoadSynchronous(), Event, Payload);
+					S_ConstructServerItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, ItemComponentClass, Event, Payload);
 					//Item Component should now exist, so search for it again.
 					//Item Struct might not be valid, so search all components
 					for(auto& CurrentComponent : GetItemComponentOwner()->GetComponents())
@@ -5216,7 +5857,7 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 			}
 			else if(Trait->NetworkingMethod == Client)
 			{
-				C_ConstructClientItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, Trait->ItemComponent.LoadSynchronous(), Event, Payload);
+				C_ConstructClientItemComponent(Item.ItemAsset, Item.UniqueID, Trait, Instigator, ItemComponentClass, Event, Payload);
 				//In the case a server calls this through an RPC, the server won't be able to return
 				//a copy, because it only exists on the client. Hence why we skip searching for
 				//the recently added component if this is the server.
@@ -5255,9 +5896,40 @@ UItemComponent* UAC_Inventory::GetItemComponent(FS_InventoryItem Item, UIT_ItemC
 	return nullptr;
 }
 
+void UAC_Inventory::RequestItemComponentClass(FS_InventoryItem Item, UIT_ItemComponentTrait* Trait, AActor* Instigator, FGameplayTag Event, FItemComponentPayload Payload)
+{
+	TWeakObjectPtr<UIT_ItemComponentTrait> WeakTrait = Trait;
+	TWeakObjectPtr<AActor> WeakInstigator = Instigator;
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(Trait->ItemComponent.ToSoftObjectPath(),
+		FStreamableDelegate::CreateWeakLambda(this, [this, Item, WeakTrait, WeakInstigator, Event, Payload]()
+		{
+			if(!WeakTrait.IsValid() || !WeakTrait->ItemComponent.Get())
+			{
+				UKismetSystemLibrary::PrintString(this, TEXT("Item component class failed to load - AC_Inventory -> RequestItemComponentClass"), true, true);
+				return;
+			}
+
+			//The item might have been removed or moved while the class was loading.
+			UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+			if(!IsValid(ParentComponent))
+			{
+				return;
+			}
+			
+			FS_InventoryItem UpdatedItem = ParentComponent->GetItemByUniqueID(Item.UniqueID);
+			if(!UpdatedItem.IsValid())
+			{
+				return;
+			}
+			
+			GetItemComponent(UpdatedItem, WeakTrait.Get(), true, WeakInstigator.Get(), Event, Payload);
+		}), FStreamableManager::AsyncLoadHighPriority);
+}
+
 UItemInstance* UAC_Inventory::CreateItemInstanceForItem(FS_InventoryItem& Item)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(CreateItemInstance)
+	LLM_SCOPE_BYTAG(InventoryFramework);
 	
 	//Only server should be creating objects
 	if(!GetOwner()->HasAuthority())
@@ -5278,7 +5950,21 @@ UItemInstance* UAC_Inventory::CreateItemInstanceForItem(FS_InventoryItem& Item)
 
 	if(!Item.ItemAsset->ItemInstance.IsNull() || IsValid(Item.ItemInstance))
 	{
-		UItemInstance* Template = Item.ItemInstance ? Item.ItemInstance : Cast<UItemInstance>(Item.ItemAsset->ItemInstance.LoadSynchronous()->GetDefaultObject());
+		UItemInstance* Template = Item.ItemInstance;
+		if(!Template)
+		{
+			/**Callers use the returned instance straight away (GetItemsInstance,
+			 * LoadAllItemInstances), so this can't wait on the streamable manager.
+			 * PreLoadItemAssets has normally loaded the class already, which
+			 * makes this a lookup. If it hasn't, this is the one load we stall on.*/
+			UClass* InstanceClass = Item.ItemAsset->ItemInstance.LoadSynchronous();
+			Template = InstanceClass ? Cast<UItemInstance>(InstanceClass->GetDefaultObject()) : nullptr;
+			if(!Template)
+			{
+				return nullptr;
+			}
+		}
+		
 		if(Template->ItemID.IsValid())
 		{
 			return Template;
@@ -5312,12 +5998,26 @@ UItemInstance* UAC_Inventory::CreateItemInstanceForItem(FS_InventoryItem& Item)
 
 int32 UAC_Inventory::GetItemCount(UDA_CoreItem* ItemAsset, TArray<FS_ContainerSettings> OptionalFilter)
 {
+	int32 TotalCount = 0;
+	
 	if(!OptionalFilter.IsValidIndex(0))
 	{
-		OptionalFilter = ContainerSettings;
-	}
+		/**No need to copy every container. This reads the items directly instead of
+		 * the item placements, as the ContainerSettings can be modified from
+		 * blueprints without the placements being invalidated.*/
+		for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
+		{
+			for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+			{
+				if(CurrentItem.ItemAsset == ItemAsset)
+				{
+					TotalCount += CurrentItem.Count;
+				}
+			}
+		}
 
-	int32 TotalCount = 0;
+		return TotalCount;
+	}
 
 	for(auto& CurrentContainer : OptionalFilter)
 	{
@@ -5516,6 +6216,9 @@ int32 UAC_Inventory::Internal_MassSplitStack(FS_InventoryItem Item, int32 StackS
                                             int32 SplitAmount, FS_ContainerSettings DestinationContainer, FRandomStream Seed,
                                             int32 ItemCountReduction)
 {
+	MarkItemsContainerDirty(Item);
+	MarkContainerDirty(DestinationContainer.UniqueID);
+	
 	int32 AmountReduced = 0;
 	StackSize = FMath::Clamp(StackSize, 0, Item.Count);
 	FS_ContainerSettings ContainerRef = DestinationContainer.ParentComponent()->GetContainerByUniqueID(DestinationContainer.UniqueID);
@@ -5602,7 +6305,7 @@ int32 UAC_Inventory::Internal_MassSplitStack(FS_InventoryItem Item, int32 StackS
 		if(UW_Container* ContainerWidget = UFL_InventoryFramework::GetWidgetForContainer(ContainerRef.ParentComponent()->ContainerSettings[ContainerRef.ContainerIndex]))
 		{
 			UW_InventoryItem* ItemWidget = nullptr;
-			ContainerWidget->CreateWidgetForItem(NewStackItem, ItemWidget);
+			ItemWidget = ContainerWidget->RequestWidgetForItem(NewStackItem);
 		}
 
 		Count = FMath::Clamp(Count - StackSize, 0, Item.Count);
@@ -5632,7 +6335,7 @@ TArray<TSoftClassPtr<UItemInstance>> UAC_Inventory::GetUnloadedItemInstances()
 		for(auto& CurrentItem : CurrentContainer.Items)
 		{
 			
-			if(CurrentItem.ItemInstance || CurrentItem.ItemAsset->ItemInstance.IsNull())
+			if(!IsValid(CurrentItem.ItemAsset) || CurrentItem.ItemInstance || CurrentItem.ItemAsset->ItemInstance.IsNull())
 			{
 				/**If the ItemInstance is valid, that means this component is hard-referencing
 				 * it, so no need to load it.
@@ -5640,9 +6343,11 @@ TArray<TSoftClassPtr<UItemInstance>> UAC_Inventory::GetUnloadedItemInstances()
 				continue;
 			}
 			
-			if(CurrentItem.ItemAsset->ItemInstance.Get() || CurrentItem.ItemAsset->ItemInstance.IsPending())
+			if(CurrentItem.ItemAsset->ItemInstance.Get())
 			{
-				/**ItemInstance is valid, but the class is already loaded or is being loaded*/
+				/**ItemInstance is valid, but the class is already loaded.
+				 * IsPending can't be used here, it's true for any unloaded
+				 * soft reference, not just ones currently being loaded.*/
 				continue;
 			}
 
@@ -6527,6 +7232,25 @@ void UAC_Inventory::GetFirstAvailableContainerAndTile_Implementation(FS_Inventor
 TArray<FS_ContainerSettings> UAC_Inventory::GetItemsChildrenContainers(FS_InventoryItem Item)
 {
 	TArray<FS_ContainerSettings> Containers;
+	const TArray<int32> ContainerIndexes = GetItemsChildrenContainerIndexes(Item);
+	if(!ContainerIndexes.IsValidIndex(0))
+	{
+		return Containers;
+	}
+
+	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+	Containers.Reserve(ContainerIndexes.Num());
+	for(const int32 ContainerIndex : ContainerIndexes)
+	{
+		Containers.Add(ParentComponent->ContainerSettings[ContainerIndex]);
+	}
+
+	return Containers;
+}
+
+TArray<int32> UAC_Inventory::GetItemsChildrenContainerIndexes(FS_InventoryItem Item)
+{
+	TArray<int32> Containers;
 	
 	if(Item.ItemAsset)
 	{
@@ -6568,11 +7292,12 @@ TArray<FS_ContainerSettings> UAC_Inventory::GetItemsChildrenContainers(FS_Invent
 		Y = Item.ItemIndex;
 	}
 	
-	for(auto& CurrentContainer : ParentComponent->ContainerSettings)
+	for(int32 ContainerIndex = 0; ContainerIndex < ParentComponent->ContainerSettings.Num(); ContainerIndex++)
 	{
-		if(CurrentContainer.BelongsToItem.X == X && CurrentContainer.BelongsToItem.Y == Y)
+		const FS_IntPoint& BelongsToItem = ParentComponent->ContainerSettings[ContainerIndex].BelongsToItem;
+		if(BelongsToItem.X == X && BelongsToItem.Y == Y)
 		{
-			Containers.Add(CurrentContainer);
+			Containers.Add(ContainerIndex);
 		}
 	}
 
@@ -6760,11 +7485,12 @@ void UAC_Inventory::GetAllItemsWithDataAsset(UDA_CoreItem* DataAsset, int32 Cont
 	TArray<FS_InventoryItem> ReturnedItems;
 	TotalCountFound = 0;
 	
+	//Same as GetItemCount, read the items directly as the item placements might be stale.
 	if(ContainerIndex == -1)
 	{
-		for(auto& CurrentContainer : ContainerSettings)
+		for(const FS_ContainerSettings& CurrentContainer : ContainerSettings)
 		{
-			for(auto& CurrentItem : CurrentContainer.Items)
+			for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
 			{
 				if(DataAsset == CurrentItem.ItemAsset)
 				{
@@ -6778,7 +7504,7 @@ void UAC_Inventory::GetAllItemsWithDataAsset(UDA_CoreItem* DataAsset, int32 Cont
 	{
 		if(ContainerSettings.IsValidIndex(ContainerIndex))
 		{
-			for(auto& CurrentItem : ContainerSettings[ContainerIndex].Items)
+			for(const FS_InventoryItem& CurrentItem : ContainerSettings[ContainerIndex].Items)
 			{
 				if(DataAsset == CurrentItem.ItemAsset)
 				{
@@ -7151,6 +7877,8 @@ void UAC_Inventory::C_AddTagsToTile_Implementation(FS_UniqueID ContainerID, int3
 
 void UAC_Inventory::Internal_AddTagsToTile(FS_ContainerSettings Container, int32 TileIndex, FGameplayTagContainer Tags)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	if(!Container.TileMap.IsValidIndex(TileIndex))
 	{
 		UKismetSystemLibrary::PrintString(this, "Can't add tags to tile, tile index is invalid");
@@ -7253,6 +7981,8 @@ void UAC_Inventory::C_RemoveTagsFromTile_Implementation(FS_UniqueID ContainerID,
 void UAC_Inventory::Internal_RemoveTagsFromTile(FS_ContainerSettings Container, int32 TileIndex,
 	FGameplayTagContainer Tags)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	if(!Container.TileMap.IsValidIndex(TileIndex))
 	{
 		UKismetSystemLibrary::PrintString(this, "Can't add tags to tile, tile index is invalid");
@@ -7505,6 +8235,8 @@ void UAC_Inventory::C_AdjustContainerSize_Implementation(FS_UniqueID ContainerID
 
 bool UAC_Inventory::Internal_AdjustContainerSize(FS_ContainerSettings Container, FMargin Adjustments, bool ClampToItems, FRandomStream Seed)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	if(Container.UniqueID.IdentityNumber < 1)
 	{
 		return false;
@@ -8313,6 +9045,8 @@ void UAC_Inventory::C_AddTagToContainer_Implementation(FS_UniqueID ContainerID,
 
 void UAC_Inventory::Internal_AddTagToContainer(FS_ContainerSettings Container, FGameplayTag Tag)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	if(!UFL_InventoryFramework::IsContainerValid(Container))
 	{
 		return;
@@ -8418,6 +9152,8 @@ void UAC_Inventory::C_RemoveTagFromContainer_Implementation(FS_UniqueID ItemID,
 
 void UAC_Inventory::Internal_RemoveTagFromContainer(FS_ContainerSettings Container, FGameplayTag Tag)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	if(!UFL_InventoryFramework::IsContainerValid(Container))
 	{
 		return;
@@ -8580,6 +9316,8 @@ void UAC_Inventory::C_SetTagValueForContainer_Implementation(FS_UniqueID Contain
 
 void UAC_Inventory::Internal_SetTagValueForContainer(FS_ContainerSettings Container, FGameplayTag Tag, float Value, bool AddIfNotFound, TSubclassOf<UO_TagValueCalculation> CalculationClass, bool& Success)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	UAC_Inventory* ParentComponent = Container.UniqueID.ParentComponent;
 	Success = false;
 	
@@ -8738,6 +9476,8 @@ void UAC_Inventory::C_RemoveTagValueFromContainer_Implementation(FS_UniqueID Con
 
 void UAC_Inventory::Internal_RemoveTagValueFromContainer(FS_ContainerSettings Container, FGameplayTag Tag)
 {
+	MarkContainerDirty(Container.UniqueID);
+	
 	UAC_Inventory* ParentComponent = Container.UniqueID.ParentComponent;
 	
 	if(!IsValid(ParentComponent))
@@ -9147,6 +9887,7 @@ void UAC_Inventory::S_SendDataFromOtherComponent_Implementation(UAC_Inventory* O
 void UAC_Inventory::C_ReceiveDataFromOtherComponent_Implementation(UAC_Inventory* OtherComponent, const TArray<FS_ContainerSettings> &Containers, bool CallDataReceived, bool CallComponentStarted)
 {
 	OtherComponent->ContainerSettings = Containers;
+	OtherComponent->InvalidateItemPlacements();
 	
 	//Clients receive container settings with no tile map, rebuild them.
 	for(auto& CurrentContainer : OtherComponent->ContainerSettings)
@@ -1173,7 +1173,7 @@ FGameplayTagContainer UFL_InventoryFramework::GetItemsTags(FS_InventoryItem Item
     }
 }
 
-TArray<FS_TagValue> UFL_InventoryFramework::GetItemsTagValues(FS_InventoryItem Item, const bool IncludeAssetTagValues)
+TArray<FS_TagValue> UFL_InventoryFramework::GetItemsTagValues(const FS_InventoryItem& Item, const bool IncludeAssetTagValues)
 {
     TArray<FS_TagValue> CombinedValues;
     if(!UGameplayStatics::GetGameInstance(Item.UniqueID.ParentComponent))
@@ -1265,7 +1265,18 @@ UItemInstance* UFL_InventoryFramework::GetItemsInstance(FS_InventoryItem Item, b
         
         if(!Item.ItemInstance || !Item.ItemInstance->ItemID.IsValid())
         {
-            if(!Item.ItemAsset->ItemInstance.IsNull() && Cast<UItemInstance>(Item.ItemAsset->ItemInstance.LoadSynchronous()->GetDefaultObject())->ConstructOnRequest)
+            if(ParentComponent->IsItemInstanceDeferred(Item.UniqueID))
+            {
+                //The instance is still waiting for its class to stream in, but
+                //it's needed right now. Construct it, which will finish the load.
+                return ParentComponent->CreateItemInstanceForItem(Item);
+            }
+            
+            /**This is a getter that has to return the instance right away, so it can't
+             * use the async path. The class is normally resident through PreLoadItemAssets,
+             * the synchronous load only happens if it was requested before that finished.*/
+            UClass* InstanceClass = Item.ItemAsset->ItemInstance.IsNull() ? nullptr : Item.ItemAsset->ItemInstance.LoadSynchronous();
+            if(InstanceClass && Cast<UItemInstance>(InstanceClass->GetDefaultObject())->ConstructOnRequest)
             {
                 //Object isn't valid but is being requested,
                 //and it wants to be created on request.
@@ -2080,22 +2091,21 @@ void UFL_InventoryFramework::GetContainerMemorySize(FS_ContainerSettings Contain
                                                     int32& ItemsArraySize, int32& TileMap)
 {
     ContainerSize = Container.GetMemorySize(false);
-    ItemsArraySize = 0;
-    TileMap = Container.TileMap.GetAllocatedSize();
+    ItemsArraySize = Container.Items.GetAllocatedSize();
+    TileMap = Container.GetTileMapAllocatedSize();
     
     for(auto& CurrentItem : Container.Items)
     {
-        ItemsArraySize += CurrentItem.GetMemorySize();
+        ItemsArraySize += CurrentItem.GetAllocatedSize();
     }
 }
 
 int32 UFL_InventoryFramework::GetItemMemorySize(FS_InventoryItem Item)
 {
-    UE_LOG(LogTemp, Warning, TEXT("Fixed size of FMyStruct: %llu bytes"), sizeof(Item.OverrideSettings));
-   return Item.GetMemorySize();
+    return Item.GetMemorySize();
 }
 
-bool UFL_InventoryFramework::DoesTagValuesHaveTag(TArray<FS_TagValue> TagValues, FGameplayTag Tag,
+bool UFL_InventoryFramework::DoesTagValuesHaveTag(const TArray<FS_TagValue>& TagValues, FGameplayTag Tag,
                                                   FS_TagValue& FoundTagValue, int32& TagIndex)
 {
     FS_TagValue NullTag;
@@ -2115,7 +2125,7 @@ bool UFL_InventoryFramework::DoesTagValuesHaveTag(TArray<FS_TagValue> TagValues,
     return false;
 }
 
-float UFL_InventoryFramework::GetValueForTag(TArray<FS_TagValue> TagValues, FGameplayTag Tag,
+float UFL_InventoryFramework::GetValueForTag(const TArray<FS_TagValue>& TagValues, FGameplayTag Tag,
     FS_TagValue& FoundTagValue, bool& TagFound)
 {
     FS_TagValue NullTag;
@@ -2135,7 +2145,7 @@ float UFL_InventoryFramework::GetValueForTag(TArray<FS_TagValue> TagValues, FGam
     return 0;
 }
 
-FGameplayTagContainer UFL_InventoryFramework::ConvertTagValuesToTagContainer(TArray<FS_TagValue> TagValues)
+FGameplayTagContainer UFL_InventoryFramework::ConvertTagValuesToTagContainer(const TArray<FS_TagValue>& TagValues)
 {
     FGameplayTagContainer TagContainer;
     if(TagValues.IsEmpty())
@@ -0,0 +1,652 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Data/IFP_ContainerSerializer.h"
+
+#include "Core/Data/SG_InventorySerialization.h"
+#include "Core/Items/DA_CoreItem.h"
+#include "Core/Items/IDA_Currency.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace IFP_ContainerSerializer
+{
+	enum EItemFlags : uint8
+	{
+		HasOverrideSettings = 1 << 0
+	};
+
+	/**Writes the container body while building the asset and tag tables.
+	 * Table indexes are offset by one, so 0 means "none".*/
+	class FWriter
+	{
+	public:
+
+		explicit FWriter(FArchive& InArchive) : Ar(InArchive) {}
+
+		FArchive& Ar;
+
+		//If set, object paths are looked up here instead of asking the object.
+		const TMap<const UObject*, FSoftObjectPath>* AssetPaths = nullptr;
+
+		TArray<FString> Assets;
+		TMap<FString, uint32> AssetLookup;
+		TArray<FName> Tags;
+		TMap<FName, uint32> TagLookup;
+
+		void WriteCount(const int32 Count)
+		{
+			uint32 PackedCount = Count;
+			Ar.SerializeIntPacked(PackedCount);
+		}
+
+		void WriteInt(int32 Value)
+		{
+			Ar << Value;
+		}
+
+		void WriteByte(uint8 Value)
+		{
+			Ar << Value;
+		}
+
+		void WritePoint(const FIntPoint& Point)
+		{
+			WriteInt(Point.X);
+			WriteInt(Point.Y);
+		}
+
+		void WriteAsset(const FSoftObjectPath& Path)
+		{
+			uint32 Index = 0;
+			if(!Path.IsNull())
+			{
+				const FString PathString = Path.ToString();
+				if(const uint32* FoundIndex = AssetLookup.Find(PathString))
+				{
+					Index = *FoundIndex;
+				}
+				else
+				{
+					Index = Assets.Add(PathString) + 1;
+					AssetLookup.Add(PathString, Index);
+				}
+			}
+			Ar.SerializeIntPacked(Index);
+		}
+
+		void WriteObject(const UObject* Object)
+		{
+			if(!Object)
+			{
+				WriteAsset(FSoftObjectPath());
+				return;
+			}
+
+			if(AssetPaths)
+			{
+				const FSoftObjectPath* Path = AssetPaths->Find(Object);
+				WriteAsset(Path ? *Path : FSoftObjectPath());
+				return;
+			}
+
+			WriteAsset(FSoftObjectPath(Object));
+		}
+
+		void WriteTag(const FGameplayTag& Tag)
+		{
+			uint32 Index = 0;
+			if(Tag.IsValid())
+			{
+				const FName TagName = Tag.GetTagName();
+				if(const uint32* FoundIndex = TagLookup.Find(TagName))
+				{
+					Index = *FoundIndex;
+				}
+				else
+				{
+					Index = Tags.Add(TagName) + 1;
+					TagLookup.Add(TagName, Index);
+				}
+			}
+			Ar.SerializeIntPacked(Index);
+		}
+
+		void WriteTags(const FGameplayTagContainer& Container)
+		{
+			const TArray<FGameplayTag>& TagArray = Container.GetGameplayTagArray();
+			WriteCount(TagArray.Num());
+			for(const FGameplayTag& CurrentTag : TagArray)
+			{
+				WriteTag(CurrentTag);
+			}
+		}
+
+		void WriteTagValues(const TArray<FS_TagValue>& TagValues)
+		{
+			WriteCount(TagValues.Num());
+			for(const FS_TagValue& CurrentTagValue : TagValues)
+			{
+				WriteTag(CurrentTagValue.Tag);
+				float Value = CurrentTagValue.Value;
+				Ar << Value;
+			}
+		}
+
+		template<typename T>
+		void WriteAssetArray(const TArray<T*>& Objects)
+		{
+			WriteCount(Objects.Num());
+			for(const T* CurrentObject : Objects)
+			{
+				WriteObject(CurrentObject);
+			}
+		}
+
+		void WriteItem(const FS_InventoryItem& Item)
+		{
+			WriteObject(Item.ItemAsset);
+			WriteInt(Item.TileIndex);
+			WriteByte(Item.Rotation);
+			WriteInt(Item.Count);
+			WritePoint(Item.RandomMinMaxCount);
+			WriteInt(Item.UniqueID.IdentityNumber);
+			WriteTags(Item.Tags);
+			WriteTagValues(Item.TagValues);
+
+			const FS_ItemOverwriteSettings& Override = Item.OverrideSettings;
+			const bool HasOverride = !Override.ItemName.IsEmpty() || !Override.Description.IsEmpty() || !Override.InventoryImage.IsNull()
+				|| Override.AcceptedCurrenciesOverwrite.IsValidIndex(0) || Override.VendorOrStorageMaxStack != 0;
+
+			WriteByte(HasOverride ? HasOverrideSettings : 0);
+			if(HasOverride)
+			{
+				FText ItemName = Override.ItemName;
+				FText Description = Override.Description;
+				Ar << ItemName;
+				Ar << Description;
+				WriteAsset(Override.InventoryImage.ToSoftObjectPath());
+				WriteAssetArray(Override.AcceptedCurrenciesOverwrite);
+				WriteInt(Override.VendorOrStorageMaxStack);
+			}
+		}
+
+		void WriteContainer(const FS_ContainerSettings& Container)
+		{
+			WriteTag(Container.ContainerIdentifier);
+			WriteByte(Container.ContainerType);
+			WriteByte(Container.Style);
+			WriteByte(Container.InfinityDirection);
+			WritePoint(Container.Dimensions);
+			WriteTags(Container.Tags);
+			WriteTagValues(Container.TagValues);
+
+			WriteTags(Container.CompatibilitySettings.RequiredTags);
+			WriteTags(Container.CompatibilitySettings.BlockingTags);
+			WriteTags(Container.CompatibilitySettings.ItemTagTypes);
+			WriteAssetArray(Container.CompatibilitySettings.ItemWhitelist);
+			WriteAssetArray(Container.CompatibilitySettings.ItemBlacklist);
+
+			WriteCount(Container.TileTags.Num());
+			for(const FS_TileTag& CurrentTileTag : Container.TileTags)
+			{
+				WriteInt(CurrentTileTag.TileIndex);
+				WriteTags(CurrentTileTag.Tags);
+			}
+
+			WritePoint(Container.BelongsToItem);
+			WriteInt(Container.UniqueID.IdentityNumber);
+
+			//The tile map is the bulk of a large container, write it as one block.
+			WriteCount(Container.TileMap.Num());
+			Ar.Serialize(const_cast<int32*>(Container.TileMap.GetData()), Container.TileMap.Num() * sizeof(int32));
+
+			WriteCount(Container.Items.Num());
+			for(const FS_InventoryItem& CurrentItem : Container.Items)
+			{
+				WriteItem(CurrentItem);
+			}
+		}
+
+		void WriteInstanceRecord(const FItemInstanceRecord& Record)
+		{
+			WriteInt(Record.ContainerIndex);
+			WriteInt(Record.ItemIndex);
+			WriteInt(Record.ItemID);
+			WriteObject(Record.ObjectClass);
+			WriteCount(Record.PropertyData.Num());
+			Ar.Serialize(const_cast<uint8*>(Record.PropertyData.GetData()), Record.PropertyData.Num());
+		}
+	};
+
+	/**Mirror of FWriter. Assets are only loaded the first time they are referenced.*/
+	class FReader
+	{
+	public:
+
+		explicit FReader(FArchive& InArchive) : Ar(InArchive) {}
+
+		FArchive& Ar;
+		uint16 Version = 0;
+
+		TArray<FSoftObjectPath> Assets;
+		TArray<UObject*> LoadedAssets;
+		TArray<FGameplayTag> Tags;
+
+		/**Read a count and make sure the archive can actually hold
+		 * that many elements, so corrupt data can't make us allocate
+		 * an absurd amount of memory.*/
+		int32 ReadCount(const int32 MinElementSize = 1)
+		{
+			uint32 Count = 0;
+			Ar.SerializeIntPacked(Count);
+			const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+			if(static_cast<int64>(Count) * MinElementSize > Remaining)
+			{
+				Ar.SetError();
+				return 0;
+			}
+			return static_cast<int32>(Count);
+		}
+
+		int32 ReadInt()
+		{
+			int32 Value = 0;
+			Ar << Value;
+			return Value;
+		}
+
+		uint8 ReadByte()
+		{
+			uint8 Value = 0;
+			Ar << Value;
+			return Value;
+		}
+
+		FIntPoint ReadPoint()
+		{
+			const int32 X = ReadInt();
+			const int32 Y = ReadInt();
+			return FIntPoint(X, Y);
+		}
+
+		uint32 ReadTableIndex(const int32 TableSize)
+		{
+			uint32 Index = 0;
+			Ar.SerializeIntPacked(Index);
+			if(Index > static_cast<uint32>(TableSize))
+			{
+				Ar.SetError();
+				return 0;
+			}
+			return Index;
+		}
+
+		void ReadAssetTable()
+		{
+			const int32 AssetCount = ReadCount();
+			Assets.Reserve(AssetCount);
+			for(int32 CurrentIndex = 0; CurrentIndex < AssetCount && !Ar.IsError(); CurrentIndex++)
+			{
+				FString AssetPath;
+				Ar << AssetPath;
+				Assets.Add(FSoftObjectPath(AssetPath));
+			}
+			LoadedAssets.SetNumZeroed(Assets.Num());
+		}
+
+		FSoftObjectPath ReadAssetPath()
+		{
+			const uint32 Index = ReadTableIndex(Assets.Num());
+			return Index == 0 ? FSoftObjectPath() : Assets[Index - 1];
+		}
+
+		UObject* ReadObject()
+		{
+			const uint32 Index = ReadTableIndex(Assets.Num());
+			if(Index == 0)
+			{
+				return nullptr;
+			}
+
+			if(!LoadedAssets[Index - 1])
+			{
+				//Only blocks if the caller didn't stream the asset in through GetAssetPaths.
+				UObject* Asset = Assets[Index - 1].ResolveObject();
+				LoadedAssets[Index - 1] = Asset ? Asset : Assets[Index - 1].TryLoad();
+			}
+			return LoadedAssets[Index - 1];
+		}
+
+		FGameplayTag ReadTag()
+		{
+			const uint32 Index = ReadTableIndex(Tags.Num());
+			return Index == 0 ? FGameplayTag() : Tags[Index - 1];
+		}
+
+		void ReadTags(FGameplayTagContainer& Container)
+		{
+			const int32 Count = ReadCount();
+			for(int32 CurrentIndex = 0; CurrentIndex < Count; CurrentIndex++)
+			{
+				const FGameplayTag Tag = ReadTag();
+				if(Tag.IsValid())
+				{
+					Container.AddTagFast(Tag);
+				}
+			}
+		}
+
+		void ReadTagValues(TArray<FS_TagValue>& TagValues)
+		{
+			const int32 Count = ReadCount();
+			TagValues.Reserve(Count);
+			for(int32 CurrentIndex = 0; CurrentIndex < Count; CurrentIndex++)
+			{
+				FS_TagValue TagValue;
+				TagValue.Tag = ReadTag();
+				Ar << TagValue.Value;
+				if(TagValue.Tag.IsValid())
+				{
+					TagValues.Add(TagValue);
+				}
+			}
+		}
+
+		template<typename T>
+		void ReadAssetArray(TArray<T*>& Objects)
+		{
+			const int32 Count = ReadCount();
+			Objects.Reserve(Count);
+			for(int32 CurrentIndex = 0; CurrentIndex < Count; CurrentIndex++)
+			{
+				if(T* Object = Cast<T>(ReadObject()))
+				{
+					Objects.Add(Object);
+				}
+			}
+		}
+
+		void ReadItem(FS_InventoryItem& Item)
+		{
+			Item.ItemAsset = Cast<UDA_CoreItem>(ReadObject());
+			Item.TileIndex = ReadInt();
+			Item.Rotation = static_cast<ERotation>(ReadByte());
+			Item.Count = ReadInt();
+			Item.RandomMinMaxCount = ReadPoint();
+			Item.UniqueID.IdentityNumber = ReadInt();
+			ReadTags(Item.Tags);
+			ReadTagValues(Item.TagValues);
+
+			const uint8 Flags = ReadByte();
+			if(Flags & HasOverrideSettings)
+			{
+				FS_ItemOverwriteSettings& Override = Item.OverrideSettings;
+				Ar << Override.ItemName;
+				Ar << Override.Description;
+				Override.InventoryImage = TSoftObjectPtr<UTexture2D>(ReadAssetPath());
+				ReadAssetArray(Override.AcceptedCurrenciesOverwrite);
+				Override.VendorOrStorageMaxStack = ReadInt();
+			}
+		}
+
+		void ReadContainer(FS_ContainerSettings& Container)
+		{
+			Container.ContainerIdentifier = ReadTag();
+			Container.ContainerType = static_cast<EContainerType>(ReadByte());
+			Container.Style = static_cast<EContainerStyle>(ReadByte());
+			Container.InfinityDirection = static_cast<EContainerInfinityDirection>(ReadByte());
+			Container.Dimensions = ReadPoint();
+			ReadTags(Container.Tags);
+			ReadTagValues(Container.TagValues);
+
+			ReadTags(Container.CompatibilitySettings.RequiredTags);
+			ReadTags(Container.CompatibilitySettings.BlockingTags);
+			ReadTags(Container.CompatibilitySettings.ItemTagTypes);
+			ReadAssetArray(Container.CompatibilitySettings.ItemWhitelist);
+			ReadAssetArray(Container.CompatibilitySettings.ItemBlacklist);
+
+			const int32 TileTagCount = ReadCount();
+			Container.TileTags.Reserve(TileTagCount);
+			for(int32 CurrentIndex = 0; CurrentIndex < TileTagCount; CurrentIndex++)
+			{
+				FS_TileTag& TileTag = Container.TileTags.AddDefaulted_GetRef();
+				TileTag.TileIndex = ReadInt();
+				ReadTags(TileTag.Tags);
+			}
+
+			Container.BelongsToItem = ReadPoint();
+			Container.UniqueID.IdentityNumber = ReadInt();
+
+			const int32 TileCount = ReadCount(sizeof(int32));
+			Container.TileMap.SetNumUninitialized(TileCount);
+			Ar.Serialize(Container.TileMap.GetData(), TileCount * sizeof(int32));
+
+			//Same loop as UAC_Inventory::InitializeTileMap
+			if(Container.SupportsTileMap())
+			{
+				Container.IndexCoordinates.Reserve(Container.Dimensions.X * Container.Dimensions.Y);
+				int32 CurrentIndex = 0;
+				for(int32 ColumnY = 0; ColumnY < Container.Dimensions.Y; ColumnY++)
+				{
+					for(int32 RowX = 0; RowX < Container.Dimensions.X; RowX++)
+					{
+						Container.IndexCoordinates.Add(FIntPoint(RowX, ColumnY), CurrentIndex);
+						CurrentIndex++;
+					}
+				}
+			}
+
+			const int32 ItemCount = ReadCount();
+			Container.Items.SetNum(ItemCount);
+			for(int32 ItemIndex = 0; ItemIndex < ItemCount && !Ar.IsError(); ItemIndex++)
+			{
+				FS_InventoryItem& Item = Container.Items[ItemIndex];
+				ReadItem(Item);
+				Item.ContainerIndex = Container.ContainerIndex;
+				Item.ItemIndex = ItemIndex;
+			}
+		}
+
+		void ReadInstanceRecord(FItemInstanceRecord& Record)
+		{
+			Record.ContainerIndex = ReadInt();
+			Record.ItemIndex = ReadInt();
+			if(Version >= EIFP_ContainerFormatVersion::InstanceRecordItemID)
+			{
+				Record.ItemID = ReadInt();
+			}
+			Record.ObjectClass = Cast<UClass>(ReadObject());
+			const int32 DataSize = ReadCount();
+			Record.PropertyData.SetNumUninitialized(DataSize);
+			Ar.Serialize(Record.PropertyData.GetData(), DataSize);
+		}
+	};
+}
+
+void FIFP_ContainerSerializer::WriteContainers(const TArray<FS_ContainerSettings>& Containers,
+	const TArray<FItemInstanceRecord>& InstanceRecords, TArray<uint8>& OutData, const TMap<const UObject*, FSoftObjectPath>* AssetPaths)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIFP_ContainerSerializer::WriteContainers)
+
+	//The tables are only complete once the body has been written,
+	//so the body goes into its own buffer first.
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body);
+	IFP_ContainerSerializer::FWriter Writer(BodyWriter);
+	Writer.AssetPaths = AssetPaths;
+
+	Writer.WriteCount(Containers.Num());
+	for(const FS_ContainerSettings& CurrentContainer : Containers)
+	{
+		Writer.WriteContainer(CurrentContainer);
+	}
+
+	Writer.WriteCount(InstanceRecords.Num());
+	for(const FItemInstanceRecord& CurrentRecord : InstanceRecords)
+	{
+		Writer.WriteInstanceRecord(CurrentRecord);
+	}
+
+	OutData.Reset();
+	FMemoryWriter HeaderWriter(OutData);
+	uint32 FormatMagic = Magic;
+	uint16 Version = EIFP_ContainerFormatVersion::Latest;
+	uint16 Flags = 0;
+	HeaderWriter << FormatMagic;
+	HeaderWriter << Version;
+	HeaderWriter << Flags;
+
+	uint32 AssetCount = Writer.Assets.Num();
+	HeaderWriter.SerializeIntPacked(AssetCount);
+	for(FString& CurrentAsset : Writer.Assets)
+	{
+		HeaderWriter << CurrentAsset;
+	}
+
+	uint32 TagCount = Writer.Tags.Num();
+	HeaderWriter.SerializeIntPacked(TagCount);
+	for(const FName& CurrentTag : Writer.Tags)
+	{
+		FString TagString = CurrentTag.ToString();
+		HeaderWriter << TagString;
+	}
+
+	HeaderWriter.Serialize(Body.GetData(), Body.Num());
+}
+
+void FIFP_ContainerSerializer::GatherAssetPaths(const TArray<FS_ContainerSettings>& Containers,
+	const TArray<FItemInstanceRecord>& InstanceRecords, TMap<const UObject*, FSoftObjectPath>& OutAssetPaths)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIFP_ContainerSerializer::GatherAssetPaths)
+
+	//Same objects as FWriter::WriteObject is called with.
+	auto AddObject = [&OutAssetPaths](const UObject* Object)
+	{
+		if(Object && !OutAssetPaths.Contains(Object))
+		{
+			OutAssetPaths.Add(Object, FSoftObjectPath(Object));
+		}
+	};
+
+	for(const FS_ContainerSettings& CurrentContainer : Containers)
+	{
+		for(const UDA_CoreItem* CurrentAsset : CurrentContainer.CompatibilitySettings.ItemWhitelist)
+		{
+			AddObject(CurrentAsset);
+		}
+		for(const UDA_CoreItem* CurrentAsset : CurrentContainer.CompatibilitySettings.ItemBlacklist)
+		{
+			AddObject(CurrentAsset);
+		}
+
+		for(const FS_InventoryItem& CurrentItem : CurrentContainer.Items)
+		{
+			AddObject(CurrentItem.ItemAsset);
+			for(const UIDA_Currency* CurrentCurrency : CurrentItem.OverrideSettings.AcceptedCurrenciesOverwrite)
+			{
+				AddObject(CurrentCurrency);
+			}
+		}
+	}
+
+	for(const FItemInstanceRecord& CurrentRecord : InstanceRecords)
+	{
+		AddObject(CurrentRecord.ObjectClass);
+	}
+}
+
+bool FIFP_ContainerSerializer::ReadContainers(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& OutContainers,
+	TArray<FItemInstanceRecord>& OutInstanceRecords)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIFP_ContainerSerializer::ReadContainers)
+
+	OutContainers.Reset();
+	OutInstanceRecords.Reset();
+
+	const uint16 Version = GetVersion(Data);
+	if(Version == 0 || Version > EIFP_ContainerFormatVersion::Latest)
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(Data);
+	MemoryReader.Seek(sizeof(uint32) + sizeof(uint16) * 2);
+	IFP_ContainerSerializer::FReader Reader(MemoryReader);
+	Reader.Version = Version;
+
+	Reader.ReadAssetTable();
+
+	const int32 TagCount = Reader.ReadCount();
+	Reader.Tags.Reserve(TagCount);
+	for(int32 CurrentIndex = 0; CurrentIndex < TagCount; CurrentIndex++)
+	{
+		FString TagName;
+		MemoryReader << TagName;
+		//Tags that have been removed from the project resolve to an empty tag and are dropped.
+		Reader.Tags.Add(FGameplayTag::RequestGameplayTag(FName(TagName), false));
+	}
+
+	const int32 ContainerCount = Reader.ReadCount();
+	OutContainers.SetNum(ContainerCount);
+	for(int32 ContainerIndex = 0; ContainerIndex < ContainerCount && !MemoryReader.IsError(); ContainerIndex++)
+	{
+		OutContainers[ContainerIndex].ContainerIndex = ContainerIndex;
+		Reader.ReadContainer(OutContainers[ContainerIndex]);
+	}
+
+	const int32 RecordCount = Reader.ReadCount();
+	OutInstanceRecords.SetNum(RecordCount);
+	for(int32 RecordIndex = 0; RecordIndex < RecordCount && !MemoryReader.IsError(); RecordIndex++)
+	{
+		Reader.ReadInstanceRecord(OutInstanceRecords[RecordIndex]);
+	}
+
+	if(MemoryReader.IsError())
+	{
+		OutContainers.Reset();
+		OutInstanceRecords.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FIFP_ContainerSerializer::GetAssetPaths(const TArray<uint8>& Data, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	OutAssetPaths.Reset();
+
+	const uint16 Version = GetVersion(Data);
+	if(Version == 0 || Version > EIFP_ContainerFormatVersion::Latest)
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(Data);
+	MemoryReader.Seek(sizeof(uint32) + sizeof(uint16) * 2);
+	IFP_ContainerSerializer::FReader Reader(MemoryReader);
+	Reader.Version = Version;
+	Reader.ReadAssetTable();
+	if(MemoryReader.IsError())
+	{
+		return false;
+	}
+
+	OutAssetPaths = MoveTemp(Reader.Assets);
+	return true;
+}
+
+uint16 FIFP_ContainerSerializer::GetVersion(const TArray<uint8>& Data)
+{
+	if(Data.Num() < static_cast<int32>(sizeof(uint32) + sizeof(uint16) * 2))
+	{
+		return 0;
+	}
+
+	FMemoryReader MemoryReader(Data);
+	uint32 FormatMagic = 0;
+	uint16 Version = 0;
+	MemoryReader << FormatMagic;
+	MemoryReader << Version;
+	return FormatMagic == Magic ? Version : 0;
+}
@@ -0,0 +1,172 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Data/IFP_MemoryTracking.h"
+
+#include "Containers/Ticker.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+LLM_DEFINE_TAG(InventoryFramework);
+
+DEFINE_STAT(STAT_IFP_Components);
+DEFINE_STAT(STAT_IFP_ItemCount);
+DEFINE_STAT(STAT_IFP_ContainersMemory);
+DEFINE_STAT(STAT_IFP_ItemsMemory);
+DEFINE_STAT(STAT_IFP_TileMapsMemory);
+DEFINE_STAT(STAT_IFP_IDMapsMemory);
+DEFINE_STAT(STAT_IFP_WidgetsMemory);
+DEFINE_STAT(STAT_IFP_ItemInstancesMemory);
+DEFINE_STAT(STAT_IFP_ItemComponentsMemory);
+DEFINE_STAT(STAT_IFP_IconsMemory);
+DEFINE_STAT(STAT_IFP_WidgetPoolHits);
+DEFINE_STAT(STAT_IFP_WidgetPoolMisses);
+DEFINE_STAT(STAT_IFP_PooledWidgets);
+DEFINE_STAT(STAT_IFP_WidgetPoolHitRate);
+DEFINE_STAT(STAT_IFP_CachedIcons);
+DEFINE_STAT(STAT_IFP_IconAtlasMemory);
+
+namespace IFP_MemoryTracking
+{
+	struct FComponentEntry
+	{
+		TWeakObjectPtr<UAC_Inventory> Component;
+		FS_InventoryMemoryReport Report;
+		int32 ContainerCount = 0;
+		int32 ItemCount = 0;
+	};
+
+	static bool IsLiveComponent(const UAC_Inventory* Component, const UWorld* World)
+	{
+		return IsValid(Component)
+			&& !Component->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)
+			&& (!World || Component->GetWorld() == World);
+	}
+
+	static void GatherComponents(const UWorld* World, TArray<FComponentEntry>& OutEntries)
+	{
+		for(TObjectIterator<UAC_Inventory> It; It; ++It)
+		{
+			UAC_Inventory* Component = *It;
+			if(!IsLiveComponent(Component, World))
+			{
+				continue;
+			}
+
+			FComponentEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.Component = Component;
+			Entry.Report = Component->GetMemoryReport();
+			Entry.ContainerCount = Component->ContainerSettings.Num();
+			for(auto& CurrentContainer : Component->ContainerSettings)
+			{
+				Entry.ItemCount += CurrentContainer.Items.Num();
+			}
+		}
+	}
+
+	static FString FormatBytes(int64 Bytes)
+	{
+		return FString::Printf(TEXT("%.1fKB"), Bytes / 1024.0);
+	}
+
+	static void DumpInventoryMemory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		int32 Count = 10;
+		if(Args.IsValidIndex(0))
+		{
+			Count = FMath::Max(1, FCString::Atoi(*Args[0]));
+		}
+
+		TArray<FComponentEntry> Entries;
+		GatherComponents(World, Entries);
+		Entries.Sort([](const FComponentEntry& A, const FComponentEntry& B)
+		{
+			return A.Report.GetTotal() > B.Report.GetTotal();
+		});
+
+		FS_InventoryMemoryReport Totals;
+		for(auto& CurrentEntry : Entries)
+		{
+			Totals += CurrentEntry.Report;
+		}
+
+		Ar.Logf(TEXT("Inventory memory: %d components, %s total"), Entries.Num(), *FormatBytes(Totals.GetTotal()));
+		Ar.Logf(TEXT("%-40s %10s %10s %10s %10s %10s %10s %10s %10s %10s %6s %6s"),
+			TEXT("Owner"), TEXT("Total"), TEXT("Containers"), TEXT("Items"), TEXT("TileMaps"), TEXT("IDMap"),
+			TEXT("Widgets"), TEXT("Instances"), TEXT("ItemComps"), TEXT("Icons"), TEXT("#Cont"), TEXT("#Item"));
+
+		for(int32 EntryIndex = 0; EntryIndex < Entries.Num() && EntryIndex < Count; EntryIndex++)
+		{
+			const FComponentEntry& Entry = Entries[EntryIndex];
+			const UAC_Inventory* Component = Entry.Component.Get();
+			const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+			const FS_InventoryMemoryReport& Report = Entry.Report;
+			Ar.Logf(TEXT("%-40s %10s %10s %10s %10s %10s %10s %10s %10s %10s %6d %6d"),
+				Owner ? *Owner->GetName() : *GetNameSafe(Component),
+				*FormatBytes(Report.GetTotal()), *FormatBytes(Report.Containers), *FormatBytes(Report.Items),
+				*FormatBytes(Report.TileMaps), *FormatBytes(Report.IDMap), *FormatBytes(Report.Widgets),
+				*FormatBytes(Report.ItemInstances), *FormatBytes(Report.ItemComponents), *FormatBytes(Report.Icons),
+				Entry.ContainerCount, Entry.ItemCount);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpInventoryMemoryCommand(
+		TEXT("IFP.DumpInventoryMemory"),
+		TEXT("Print the memory used by the inventory components using the most memory. Usage: IFP.DumpInventoryMemory [Count=10]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpInventoryMemory));
+
+#if STATS
+	static FTSTicker::FDelegateHandle StatsTickerHandle;
+
+	/**Walking every component is not free, so this only runs
+	 * once a second and only while stats are being collected.*/
+	static bool UpdateStats(float DeltaTime)
+	{
+		if(!FThreadStats::IsCollectingData())
+		{
+			return true;
+		}
+
+		TArray<FComponentEntry> Entries;
+		GatherComponents(nullptr, Entries);
+
+		FS_InventoryMemoryReport Totals;
+		int32 ItemCount = 0;
+		for(auto& CurrentEntry : Entries)
+		{
+			Totals += CurrentEntry.Report;
+			ItemCount += CurrentEntry.ItemCount;
+		}
+
+		SET_DWORD_STAT(STAT_IFP_Components, Entries.Num());
+		SET_DWORD_STAT(STAT_IFP_ItemCount, ItemCount);
+		SET_MEMORY_STAT(STAT_IFP_ContainersMemory, Totals.Containers);
+		SET_MEMORY_STAT(STAT_IFP_ItemsMemory, Totals.Items);
+		SET_MEMORY_STAT(STAT_IFP_TileMapsMemory, Totals.TileMaps);
+		SET_MEMORY_STAT(STAT_IFP_IDMapsMemory, Totals.IDMap);
+		SET_MEMORY_STAT(STAT_IFP_WidgetsMemory, Totals.Widgets);
+		SET_MEMORY_STAT(STAT_IFP_ItemInstancesMemory, Totals.ItemInstances);
+		SET_MEMORY_STAT(STAT_IFP_ItemComponentsMemory, Totals.ItemComponents);
+		SET_MEMORY_STAT(STAT_IFP_IconsMemory, Totals.Icons);
+		return true;
+	}
+#endif
+
+	void Startup()
+	{
+#if STATS
+		StatsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&UpdateStats), 1.0f);
+#endif
+	}
+
+	void Shutdown()
+	{
+#if STATS
+		FTSTicker::GetCoreTicker().RemoveTicker(StatsTickerHandle);
+		StatsTickerHandle.Reset();
+#endif
+	}
+}
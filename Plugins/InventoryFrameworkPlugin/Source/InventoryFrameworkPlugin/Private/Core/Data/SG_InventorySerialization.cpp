@@ -5,9 +5,40 @@
 
 #include "Core/Components/AC_Inventory.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Data/IFP_ContainerSerializer.h"
 #include "Core/Interfaces/I_Inventory.h"
 #include "Core/Objects/Parents/ItemInstance.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace IFP_InventorySerialization
+{
+	/**Deserializes item instance records through a single archive.
+	 * Each record is copied into a buffer that is reused, so
+	 * the archive only has to be set up once per load.*/
+	class FItemInstanceRecordReader
+	{
+	public:
+
+		FItemInstanceRecordReader() : Reader(Buffer, true), Archive(Reader) {}
+
+		void Read(UItemInstance* ItemInstance, const FItemInstanceRecord& Record)
+		{
+			Buffer = Record.PropertyData;
+			Reader.Seek(0);
+			Reader.ClearError();
+			Archive.ClearError();
+			ItemInstance->Serialize(Archive);
+		}
+
+	private:
+
+		TArray<uint8> Buffer;
+		FMemoryReader Reader;
+		FSaveGameArchive Archive;
+	};
+}
 
 void USG_InventorySerialization::SaveItemInstance(UItemInstance* ItemInstance)
 {
@@ -16,18 +47,21 @@ void USG_InventorySerialization::SaveItemInstance(UItemInstance* ItemInstance)
 		return;
 	}
 
-	//Prepare a record of the object
-	FItemInstanceRecord ObjectRecord;
-	FMemoryWriter MemoryWriter = FMemoryWriter(ObjectRecord.PropertyData, true);
-	FSaveGameArchive SaveGameArchive = FSaveGameArchive(MemoryWriter);
-
-	//Start serializing the record
-	FS_InventoryItem ItemData = ItemInstance->GetItemData();
-	ObjectRecord.ObjectClass = ItemInstance->GetClass();
-	ObjectRecord.ContainerIndex = ItemData.ContainerIndex;
-	ObjectRecord.ItemIndex = ItemData.ItemIndex;
-	ItemInstance->Serialize(SaveGameArchive);
-	ItemInstanceRecords.Add(ObjectRecord);
+	FItemInstanceRecord Record = CreateItemInstanceRecord(ItemInstance);
+	if(Record.ItemID > 0)
+	{
+		ItemInstanceRecordsByID.Add(Record.ItemID, MoveTemp(Record));
+	}
+	else
+	{
+		const FIntPoint Directions(Record.ContainerIndex, Record.ItemIndex);
+		const int32 RecordIndex = ItemInstanceRecords.Add(MoveTemp(Record));
+		//Keep the lookup in sync if it was already built, otherwise it's built on the next find.
+		if(!LegacyRecordLookup.IsEmpty() && !LegacyRecordLookup.Contains(Directions))
+		{
+			LegacyRecordLookup.Add(Directions, RecordIndex);
+		}
+	}
 }
 
 void USG_InventorySerialization::LoadItemInstance(FS_InventoryItem Item)
@@ -42,59 +76,319 @@ void USG_InventorySerialization::LoadItemInstance(FS_InventoryItem Item)
 		return;
 	}
 	
-	for(auto& CurrentRecord : ItemInstanceRecords)
+	if(!IsValid(Item.ItemInstance))
+	{
+		return;
+	}
+
+	if(const FItemInstanceRecord* Record = FindItemInstanceRecord(Item))
+	{
+		IFP_InventorySerialization::FItemInstanceRecordReader Reader;
+		Reader.Read(Item.ItemInstance, *Record);
+	}
+}
+
+int32 USG_InventorySerialization::LoadAllItemInstances(UAC_Inventory* Inventory)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(LoadAllItemInstances)
+	
+	if(!IsValid(Inventory))
+	{
+		return 0;
+	}
+
+	IFP_InventorySerialization::FItemInstanceRecordReader Reader;
+	int32 RestoredInstances = 0;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
 	{
-		if(CurrentRecord.ContainerIndex == Item.ContainerIndex && CurrentRecord.ItemIndex == Item.ItemIndex)
+		for(auto& CurrentItem : CurrentContainer.Items)
 		{
-			UItemInstance* ItemInstance = Item.ItemInstance;
-			FMemoryReader Reader = FMemoryReader(CurrentRecord.PropertyData, true);
-			FSaveGameArchive Archive = FSaveGameArchive(Reader);
-			ItemInstance->Serialize(Archive);
-			
-			break;
+			const FItemInstanceRecord* Record = FindItemInstanceRecord(CurrentItem);
+			if(!Record)
+			{
+				continue;
+			}
+
+			UItemInstance* ItemInstance = CurrentItem.ItemInstance;
+			if(!IsValid(ItemInstance) || !ItemInstance->ItemID.IsValid())
+			{
+				//Instances that are constructed on request still need to restore their saved data.
+				ItemInstance = Inventory->CreateItemInstanceForItem(CurrentItem);
+			}
+
+			if(IsValid(ItemInstance))
+			{
+				Reader.Read(ItemInstance, *Record);
+				RestoredInstances++;
+			}
+		}
+	}
+
+	return RestoredInstances;
+}
+
+const FItemInstanceRecord* USG_InventorySerialization::FindItemInstanceRecord(const FS_InventoryItem& Item)
+{
+	if(Item.UniqueID.IdentityNumber > 0)
+	{
+		if(const FItemInstanceRecord* Record = ItemInstanceRecordsByID.Find(Item.UniqueID.IdentityNumber))
+		{
+			return Record;
+		}
+	}
+
+	if(!ItemInstanceRecords.IsValidIndex(0))
+	{
+		return nullptr;
+	}
+
+	if(LegacyRecordLookup.IsEmpty())
+	{
+		LegacyRecordLookup.Reserve(ItemInstanceRecords.Num());
+		for(int32 RecordIndex = 0; RecordIndex < ItemInstanceRecords.Num(); RecordIndex++)
+		{
+			const FIntPoint Directions(ItemInstanceRecords[RecordIndex].ContainerIndex, ItemInstanceRecords[RecordIndex].ItemIndex);
+			//The old linear search used the first match, keep that behaviour.
+			if(!LegacyRecordLookup.Contains(Directions))
+			{
+				LegacyRecordLookup.Add(Directions, RecordIndex);
+			}
 		}
 	}
+
+	const int32* RecordIndex = LegacyRecordLookup.Find(FIntPoint(Item.ContainerIndex, Item.ItemIndex));
+	return RecordIndex ? &ItemInstanceRecords[*RecordIndex] : nullptr;
 }
 
 void USG_InventorySerialization::SaveContainersForActor(AActor* Actor)
 {
-	// if(!Actor)
-	// {
-	// 	return;
-	// }
-	//
-	// if(!Actor->Implements<II_Inventory>())
-	// {
-	// 	return;
-	// }
-	//
-	// UAC_Inventory* Inventory = nullptr;
-	// II_Inventory::Execute_GetInventoryComponent(Actor, Inventory);
-	// if(!Inventory)
-	// {
-	// 	UKismetSystemLibrary::PrintString(Actor, "Could not save actor, failed GetInventoryComponent");
-	// }
-	//
-	// int32 ActorIndex = SavedActors.Find(Actor);
-	// if(ActorIndex == INDEX_NONE)
-	// {
-	// 	SavedActors.Add(Actor);
-	// 	ActorIndex = SavedActors.Num();
-	// }
-
-	// FContainerRecord ContainerRecord;
-	// ContainerRecord.ActorName = Actor->GetName();
-	//
-	// FMemoryWriter MemoryWriter = FMemoryWriter(ContainerRecord.PropertyData, true);
-	// FSaveGameArchive ContainerArchive = FSaveGameArchive(MemoryWriter);
+	TRACE_CPUPROFILER_EVENT_SCOPE(SaveContainersForActor)
+	
+	UAC_Inventory* Inventory = GetInventoryFromActor(Actor);
+	if(!Inventory)
+	{
+		UKismetSystemLibrary::PrintString(Actor, "Could not save actor, failed GetInventoryComponent - USG_InventorySerialization::SaveContainersForActor");
+		return;
+	}
+
+	TArray<FItemInstanceRecord> InstanceRecords;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			if(IsValid(CurrentItem.ItemInstance))
+			{
+				InstanceRecords.Add(CreateItemInstanceRecord(CurrentItem.ItemInstance));
+			}
+		}
+	}
+
+	FContainerRecord& ContainerRecord = ContainerRecords.FindOrAdd(Actor->GetName());
+	FIFP_ContainerSerializer::WriteContainers(Inventory->GetContainersForSaveState(), InstanceRecords, ContainerRecord.Data);
 }
 
 void USG_InventorySerialization::LoadContainersForActor(AActor* Actor)
 {
-	// int32 ActorIndex = SavedActors.Find(Actor);
-	// if(ActorIndex == INDEX_NONE)
-	// {
-	// 	UKismetSystemLibrary::PrintString(Actor, "Could not load containers for actor, it had not been saved in the past");
-	// 	return;
-	// }
+	TRACE_CPUPROFILER_EVENT_SCOPE(LoadContainersForActor)
+	
+	const FContainerRecord* ContainerRecord = Actor ? ContainerRecords.Find(Actor->GetName()) : nullptr;
+	if(!ContainerRecord)
+	{
+		UKismetSystemLibrary::PrintString(Actor, "Could not load containers for actor, it had not been saved in the past - USG_InventorySerialization::LoadContainersForActor");
+		return;
+	}
+
+	UAC_Inventory* Inventory = GetInventoryFromActor(Actor);
+	if(!Inventory)
+	{
+		UKismetSystemLibrary::PrintString(Actor, "Could not load actor, failed GetInventoryComponent - USG_InventorySerialization::LoadContainersForActor");
+		return;
+	}
+
+	if(Inventory->Initialized)
+	{
+		UKismetSystemLibrary::PrintString(Actor, "Containers must be loaded before the component is started - USG_InventorySerialization::LoadContainersForActor");
+		return;
+	}
+
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FItemInstanceRecord> InstanceRecords;
+	if(!FIFP_ContainerSerializer::ReadContainers(ContainerRecord->Data, Containers, InstanceRecords))
+	{
+		UKismetSystemLibrary::PrintString(Actor, "Container record is corrupt or from a newer version - USG_InventorySerialization::LoadContainersForActor");
+		return;
+	}
+
+	RestoreContainers(Inventory, Containers, InstanceRecords);
+}
+
+void USG_InventorySerialization::RestoreContainers(UAC_Inventory* Inventory, const TArray<FS_ContainerSettings>& Containers,
+	const TArray<FItemInstanceRecord>& InstanceRecords)
+{
+	if(!IsValid(Inventory) || Inventory->Initialized)
+	{
+		return;
+	}
+	
+	Inventory->ContainerSettings = Containers;
+	Inventory->StartComponent();
+
+	/**StartComponent can sort items and remove the ones that failed to spawn,
+	 * so records are matched to their item by its UniqueID, not its position.*/
+	IFP_InventorySerialization::FItemInstanceRecordReader Reader;
+	for(auto& CurrentRecord : InstanceRecords)
+	{
+		int32 ItemID = CurrentRecord.ItemID;
+		if(ItemID <= 0
+			&& Containers.IsValidIndex(CurrentRecord.ContainerIndex)
+			&& Containers[CurrentRecord.ContainerIndex].Items.IsValidIndex(CurrentRecord.ItemIndex))
+		{
+			//Saved before records stored the ItemID, use the ID the item had when it was saved.
+			ItemID = Containers[CurrentRecord.ContainerIndex].Items[CurrentRecord.ItemIndex].UniqueID.IdentityNumber;
+		}
+
+		if(ItemID <= 0)
+		{
+			continue;
+		}
+
+		const FS_InventoryItem FoundItem = Inventory->GetItemByUniqueID(FS_UniqueID(ItemID, Inventory));
+		if(!FoundItem.IsValid()
+			|| !Inventory->ContainerSettings.IsValidIndex(FoundItem.ContainerIndex)
+			|| !Inventory->ContainerSettings[FoundItem.ContainerIndex].Items.IsValidIndex(FoundItem.ItemIndex))
+		{
+			//Item failed to spawn.
+			continue;
+		}
+
+		FS_InventoryItem& Item = Inventory->ContainerSettings[FoundItem.ContainerIndex].Items[FoundItem.ItemIndex];
+		UItemInstance* ItemInstance = Item.ItemInstance;
+		if(!IsValid(ItemInstance) || !ItemInstance->ItemID.IsValid())
+		{
+			//Instances that are constructed on request still need to restore their saved data.
+			ItemInstance = Inventory->CreateItemInstanceForItem(Item);
+		}
+
+		if(IsValid(ItemInstance))
+		{
+			Reader.Read(ItemInstance, CurrentRecord);
+		}
+	}
+}
+
+void USG_InventorySerialization::BenchmarkContainerSerialization(UAC_Inventory* Inventory, int32 Iterations)
+{
+	if(!IsValid(Inventory) || Iterations <= 0)
+	{
+		return;
+	}
+
+	const TArray<FS_ContainerSettings> Containers = Inventory->GetContainersForSaveState();
+	TArray<FItemInstanceRecord> InstanceRecords;
+	int32 ItemCount = 0;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		ItemCount += CurrentContainer.Items.Num();
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			if(IsValid(CurrentItem.ItemInstance))
+			{
+				InstanceRecords.Add(CreateItemInstanceRecord(CurrentItem.ItemInstance));
+			}
+		}
+	}
+
+	/**The generic path, identical to what happens when the result of
+	 * GetContainersForSaveState is a property on a USaveGame that
+	 * gets saved through UGameplayStatics::SaveGameToMemory.*/
+	TArray<uint8> PropertyData;
+	double PropertySaveTime = 0;
+	double PropertyLoadTime = 0;
+	for(int32 CurrentIteration = 0; CurrentIteration < Iterations; CurrentIteration++)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		PropertyData.Reset();
+		FMemoryWriter MemoryWriter(PropertyData, true);
+		FObjectAndNameAsStringProxyArchive WriteArchive(MemoryWriter, false);
+		for(auto& CurrentContainer : Containers)
+		{
+			FS_ContainerSettings::StaticStruct()->SerializeItem(WriteArchive, const_cast<FS_ContainerSettings*>(&CurrentContainer), nullptr);
+		}
+		for(auto& CurrentRecord : InstanceRecords)
+		{
+			FItemInstanceRecord::StaticStruct()->SerializeItem(WriteArchive, &CurrentRecord, nullptr);
+		}
+		PropertySaveTime += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<FS_ContainerSettings> LoadedContainers;
+		LoadedContainers.SetNum(Containers.Num());
+		TArray<FItemInstanceRecord> LoadedRecords;
+		LoadedRecords.SetNum(InstanceRecords.Num());
+		FMemoryReader MemoryReader(PropertyData, true);
+		FObjectAndNameAsStringProxyArchive ReadArchive(MemoryReader, true);
+		for(auto& CurrentContainer : LoadedContainers)
+		{
+			FS_ContainerSettings::StaticStruct()->SerializeItem(ReadArchive, &CurrentContainer, nullptr);
+		}
+		for(auto& CurrentRecord : LoadedRecords)
+		{
+			FItemInstanceRecord::StaticStruct()->SerializeItem(ReadArchive, &CurrentRecord, nullptr);
+		}
+		PropertyLoadTime += FPlatformTime::Seconds() - StartTime;
+	}
+
+	TArray<uint8> BinaryData;
+	double BinarySaveTime = 0;
+	double BinaryLoadTime = 0;
+	for(int32 CurrentIteration = 0; CurrentIteration < Iterations; CurrentIteration++)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		FIFP_ContainerSerializer::WriteContainers(Containers, InstanceRecords, BinaryData);
+		BinarySaveTime += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<FS_ContainerSettings> LoadedContainers;
+		TArray<FItemInstanceRecord> LoadedRecords;
+		FIFP_ContainerSerializer::ReadContainers(BinaryData, LoadedContainers, LoadedRecords);
+		BinaryLoadTime += FPlatformTime::Seconds() - StartTime;
+	}
+
+	const double ToAverageMs = 1000.0 / Iterations;
+	UKismetSystemLibrary::PrintString(Inventory, FString::Printf(
+		TEXT("IFP serialization benchmark: %d containers, %d items, %d item instances, %d iterations\n")
+		TEXT("SaveGame properties: %d bytes, save %.3fms, load %.3fms\n")
+		TEXT("Binary format: %d bytes, save %.3fms, load %.3fms"),
+		Containers.Num(), ItemCount, InstanceRecords.Num(), Iterations,
+		PropertyData.Num(), PropertySaveTime * ToAverageMs, PropertyLoadTime * ToAverageMs,
+		BinaryData.Num(), BinarySaveTime * ToAverageMs, BinaryLoadTime * ToAverageMs), true, true, FLinearColor::Green, 15);
+}
+
+FItemInstanceRecord USG_InventorySerialization::CreateItemInstanceRecord(UItemInstance* ItemInstance)
+{
+	//Prepare a record of the object
+	FItemInstanceRecord ObjectRecord;
+	FMemoryWriter MemoryWriter = FMemoryWriter(ObjectRecord.PropertyData, true);
+	FSaveGameArchive SaveGameArchive = FSaveGameArchive(MemoryWriter);
+
+	//Start serializing the record
+	FS_InventoryItem ItemData = ItemInstance->GetItemData();
+	ObjectRecord.ObjectClass = ItemInstance->GetClass();
+	ObjectRecord.ContainerIndex = ItemData.ContainerIndex;
+	ObjectRecord.ItemIndex = ItemData.ItemIndex;
+	ObjectRecord.ItemID = ItemData.UniqueID.IdentityNumber;
+	ItemInstance->Serialize(SaveGameArchive);
+	return ObjectRecord;
+}
+
+UAC_Inventory* USG_InventorySerialization::GetInventoryFromActor(AActor* Actor)
+{
+	if(!IsValid(Actor) || !Actor->Implements<UI_Inventory>())
+	{
+		return nullptr;
+	}
+
+	UAC_Inventory* Inventory = nullptr;
+	II_Inventory::Execute_GetInventoryComponent(Actor, Inventory);
+	return Inventory;
 }
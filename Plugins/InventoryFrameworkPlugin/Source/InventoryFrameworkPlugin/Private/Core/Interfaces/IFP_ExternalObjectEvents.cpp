@@ -0,0 +1,261 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Interfaces/IFP_ExternalObjectEvents.h"
+
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Interfaces/I_ExternalObjects.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/ObjectKey.h"
+
+namespace IFP_ExternalObjectEvents
+{
+	static TAutoConsoleVariable<bool> CVarDeferEvents(
+		TEXT("IFP.ExternalObjects.DeferEvents"),
+		true,
+		TEXT("Queue item events sent to external objects and deliver them once at the end of the frame, one per item and event type."));
+
+	struct FItemKey
+	{
+		TObjectKey<UAC_Inventory> Component;
+		int32 IdentityNumber = 0;
+
+		bool operator==(const FItemKey& Other) const
+		{
+			return Component == Other.Component && IdentityNumber == Other.IdentityNumber;
+		}
+
+		friend uint32 GetTypeHash(const FItemKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Component), GetTypeHash(Key.IdentityNumber));
+		}
+	};
+
+	struct FEventKey
+	{
+		FItemKey Item;
+		EIFP_ExternalObjectEvent Type = EIFP_ExternalObjectEvent::Location;
+
+		bool operator==(const FEventKey& Other) const
+		{
+			return Item == Other.Item && Type == Other.Type;
+		}
+
+		friend uint32 GetTypeHash(const FEventKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Item), static_cast<uint32>(Key.Type));
+		}
+	};
+
+	struct FQueuedEvent
+	{
+		TWeakObjectPtr<UAC_Inventory> Component;
+		int32 IdentityNumber = 0;
+		FIFP_ExternalObjectEvent Event;
+	};
+
+	struct FGatheredItem
+	{
+		FS_InventoryItem Item;
+		TArray<UObject*> Objects;
+	};
+
+	//In the order the first event for each key was queued.
+	static TArray<FQueuedEvent> QueuedEvents;
+
+	static TMap<FEventKey, int32> QueuedEventIndexes;
+
+	static TMap<TObjectKey<UClass>, bool> ImplementsCache;
+
+	static FDelegateHandle EndFrameHandle;
+
+	/**Fresh item data and every object listening to it that implements I_ExternalObjects.*/
+	static void GatherItem(UAC_Inventory* Component, int32 IdentityNumber, FGatheredItem& OutGathered)
+	{
+		FS_UniqueID ItemID;
+		ItemID.IdentityNumber = IdentityNumber;
+		ItemID.ParentComponent = Component;
+		OutGathered.Item = Component->GetItemByUniqueID(ItemID);
+
+		OutGathered.Objects = UFL_InventoryFramework::GetObjectsForItemBroadcast(OutGathered.Item);
+		OutGathered.Objects.RemoveAllSwap([](const UObject* Object)
+		{
+			return !ImplementsExternalObjects(Object);
+		}, EAllowShrinking::No);
+	}
+
+	static void Dispatch(UObject* Object, const FS_InventoryItem& Item, const FIFP_ExternalObjectEvent& Event)
+	{
+		switch(Event.Type)
+		{
+		case EIFP_ExternalObjectEvent::ItemCount:
+			II_ExternalObjects::Execute_ItemCountUpdated(Object, Item, Event.OldValue, Event.NewValue);
+			break;
+		case EIFP_ExternalObjectEvent::Location:
+			II_ExternalObjects::Execute_LocationUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Size:
+			II_ExternalObjects::Execute_SizeUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Rotation:
+			II_ExternalObjects::Execute_RotationUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Rarity:
+			II_ExternalObjects::Execute_RarityUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Image:
+			II_ExternalObjects::Execute_ImageUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Name:
+			II_ExternalObjects::Execute_NameUpdated(Object, Item);
+			break;
+		case EIFP_ExternalObjectEvent::Icon:
+			II_ExternalObjects::Execute_IconUpdated(Object, Event.Texture.Get(), Item);
+			break;
+		case EIFP_ExternalObjectEvent::Affordability:
+			II_ExternalObjects::Execute_AffordabilityUpdated(Object, Event.Flag, Item);
+			break;
+		case EIFP_ExternalObjectEvent::OverrideSettings:
+			II_ExternalObjects::Execute_OverrideSettingsUpdated(Object, Item, Event.OldOverride, Event.NewOverride);
+			break;
+		case EIFP_ExternalObjectEvent::BackgroundColor:
+			II_ExternalObjects::Execute_BackgroundColorUpdated(Object, Item, Event.Color, Event.Flag);
+			break;
+		case EIFP_ExternalObjectEvent::WidgetSelection:
+			II_ExternalObjects::Execute_WidgetSelectionUpdated(Object, Item, Event.Flag);
+			break;
+		default: break;
+		}
+	}
+
+	static void DispatchToGathered(const FGatheredItem& Gathered, const FIFP_ExternalObjectEvent& Event)
+	{
+		for(UObject* CurrentObject : Gathered.Objects)
+		{
+			//An earlier event might have destroyed this object.
+			if(IsValid(CurrentObject))
+			{
+				Dispatch(CurrentObject, Gathered.Item, Event);
+			}
+		}
+	}
+
+	/**Fold a new event into one that is already queued for the same item.*/
+	static void MergeEvent(FIFP_ExternalObjectEvent& Queued, const FIFP_ExternalObjectEvent& Event)
+	{
+		switch(Event.Type)
+		{
+		case EIFP_ExternalObjectEvent::ItemCount:
+			Queued.NewValue = Event.NewValue;
+			break;
+		case EIFP_ExternalObjectEvent::OverrideSettings:
+			Queued.NewOverride = Event.NewOverride;
+			break;
+		default:
+			Queued = Event;
+			break;
+		}
+	}
+
+	void QueueItemEvent(const FS_InventoryItem& Item, const FIFP_ExternalObjectEvent& Event)
+	{
+		UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+		if(!ParentComponent)
+		{
+			return;
+		}
+
+		if(!CVarDeferEvents.GetValueOnGameThread())
+		{
+			FGatheredItem Gathered;
+			GatherItem(ParentComponent, Item.UniqueID.IdentityNumber, Gathered);
+			DispatchToGathered(Gathered, Event);
+			return;
+		}
+
+		const FEventKey Key = {{ParentComponent, Item.UniqueID.IdentityNumber}, Event.Type};
+		if(const int32* QueuedIndex = QueuedEventIndexes.Find(Key))
+		{
+			MergeEvent(QueuedEvents[*QueuedIndex].Event, Event);
+			return;
+		}
+
+		QueuedEventIndexes.Add(Key, QueuedEvents.Num());
+		FQueuedEvent& QueuedEvent = QueuedEvents.AddDefaulted_GetRef();
+		QueuedEvent.Component = ParentComponent;
+		QueuedEvent.IdentityNumber = Item.UniqueID.IdentityNumber;
+		QueuedEvent.Event = Event;
+	}
+
+	void Flush()
+	{
+		if(!QueuedEvents.IsValidIndex(0))
+		{
+			return;
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(IFP_ExternalObjectEvents::Flush)
+
+		//Events broadcast by listeners while flushing are delivered next frame.
+		TArray<FQueuedEvent> Events = MoveTemp(QueuedEvents);
+		QueuedEvents.Reset();
+		QueuedEventIndexes.Reset();
+
+		TMap<FItemKey, FGatheredItem> GatheredItems;
+		for(const FQueuedEvent& CurrentEvent : Events)
+		{
+			UAC_Inventory* Component = CurrentEvent.Component.Get();
+			if(!IsValid(Component))
+			{
+				continue;
+			}
+
+			const FItemKey ItemKey = {Component, CurrentEvent.IdentityNumber};
+			FGatheredItem* Gathered = GatheredItems.Find(ItemKey);
+			if(!Gathered)
+			{
+				Gathered = &GatheredItems.Add(ItemKey);
+				GatherItem(Component, CurrentEvent.IdentityNumber, *Gathered);
+			}
+
+			DispatchToGathered(*Gathered, CurrentEvent.Event);
+		}
+	}
+
+	int32 GetQueuedEventCount()
+	{
+		return QueuedEvents.Num();
+	}
+
+	bool ImplementsExternalObjects(const UObject* Object)
+	{
+		if(!IsValid(Object))
+		{
+			return false;
+		}
+
+		UClass* Class = Object->GetClass();
+		if(const bool* Implements = ImplementsCache.Find(Class))
+		{
+			return *Implements;
+		}
+
+		return ImplementsCache.Add(Class, Class->ImplementsInterface(UI_ExternalObjects::StaticClass()));
+	}
+
+	void Startup()
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&Flush);
+	}
+
+	void Shutdown()
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+		QueuedEvents.Empty();
+		QueuedEventIndexes.Empty();
+		ImplementsCache.Empty();
+	}
+}
@@ -4,6 +4,12 @@
 
 #include "Core/Components/AC_Inventory.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Interfaces/IFP_ExternalObjectEvents.h"
+
+void UFL_ExternalObjects::FlushQueuedEvents()
+{
+	IFP_ExternalObjectEvents::Flush();
+}
 
 void UFL_ExternalObjects::BroadcastItemCountUpdated(FS_InventoryItem Item, int32 OldValue, int32 NewValue)
 {
@@ -21,220 +27,55 @@ void UFL_ExternalObjects::BroadcastItemCountUpdated(FS_InventoryItem Item, int32
 		ParentComponent->ItemCountUpdated.Broadcast(Item, OldValue, NewValue);
 	}
 
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_ItemCountUpdated(CurrentObject, Item, OldValue, NewValue);
-		}
-	}
+	//The delegate is sent right away, external objects only need the final count.
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::ItemCount);
+	Event.OldValue = OldValue;
+	Event.NewValue = NewValue;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastLocationUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	//We only send the interface events here, not broadcast the delegate because it requires
-	//much more information.
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_LocationUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Location));
 }
 
 void UFL_ExternalObjects::BroadcastSizeUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-	
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_SizeUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Size));
 }
 
 void UFL_ExternalObjects::BroadcastRotationUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_RotationUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Rotation));
 }
 
 void UFL_ExternalObjects::BroadcastRarityUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_RarityUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Rarity));
 }
 
 void UFL_ExternalObjects::BroadcastImageUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_ImageUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Image));
 }
 
 void UFL_ExternalObjects::BroadcastNameUpdated(FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_NameUpdated(CurrentObject, Item);
-		}
-	}
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent::Name));
 }
 
 void UFL_ExternalObjects::BroadcastIconUpdated(UTexture* NewTexture, FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_IconUpdated(CurrentObject, NewTexture, Item);
-		}
-	}
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::Icon);
+	Event.Texture = NewTexture;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastAffordabilityUpdated(bool CanAfford, FS_InventoryItem Item)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-	
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_AffordabilityUpdated(CurrentObject, CanAfford, Item);
-		}
-	}
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::Affordability);
+	Event.Flag = CanAfford;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastTagsUpdated(FGameplayTag Tag, bool Added, FS_InventoryItem Item,
@@ -267,7 +108,7 @@ void UFL_ExternalObjects::BroadcastTagsUpdated(FGameplayTag Tag, bool Added, FS_
 				continue;
 			}
 		
-			if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+			if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 			{
 				II_ExternalObjects::Execute_TagsUpdated(CurrentObject, Tag, Added, Item, FS_ContainerSettings());
 			}
@@ -294,7 +135,7 @@ void UFL_ExternalObjects::BroadcastTagsUpdated(FGameplayTag Tag, bool Added, FS_
 				continue;
 			}
 		
-			if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+			if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 			{
 				II_ExternalObjects::Execute_TagsUpdated(CurrentObject, Tag, Added, FS_InventoryItem(), Container);
 			}
@@ -323,7 +164,7 @@ void UFL_ExternalObjects::BroadcastTagValueUpdated(FS_TagValue TagValue, bool Ad
 				continue;
 			}
 		
-			if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+			if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 			{
 				II_ExternalObjects::Execute_TagValueUpdated(CurrentObject, TagValue, Added, Delta, Item, FS_ContainerSettings());
 			}
@@ -341,7 +182,7 @@ void UFL_ExternalObjects::BroadcastTagValueUpdated(FS_TagValue TagValue, bool Ad
 				continue;
 			}
 		
-			if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+			if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 			{
 				II_ExternalObjects::Execute_TagValueUpdated(CurrentObject, TagValue, Added, Delta, FS_InventoryItem(), Container);
 			}
@@ -352,77 +193,25 @@ void UFL_ExternalObjects::BroadcastTagValueUpdated(FS_TagValue TagValue, bool Ad
 void UFL_ExternalObjects::BroadcastOverrideSettingsUpdated(FS_InventoryItem Item,
 	FS_ItemOverwriteSettings OldOverride, FS_ItemOverwriteSettings NewOverride)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-	
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_OverrideSettingsUpdated(CurrentObject, Item, OldOverride, NewOverride);
-		}
-	}
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::OverrideSettings);
+	Event.OldOverride = OldOverride;
+	Event.NewOverride = NewOverride;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastBackgroundColorUpdated(FS_InventoryItem Item, FLinearColor NewColor, bool IsTemporary)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-	
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_BackgroundColorUpdated(CurrentObject, Item, NewColor, IsTemporary);
-		}
-	}
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::BackgroundColor);
+	Event.Color = NewColor;
+	Event.Flag = IsTemporary;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastWidgetSelectionUpdated(FS_InventoryItem Item, bool IsSelected)
 {
-	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
-	if(!ParentComponent)
-	{
-		return;
-	}
-	
-	//Some data may be stale, fetch a fresh copy
-	Item = ParentComponent->GetItemByUniqueID(Item.UniqueID);
-	
-	for(auto& CurrentObject : UFL_InventoryFramework::GetObjectsForItemBroadcast(Item))
-	{
-		if(!CurrentObject)
-		{
-			continue;
-		}
-		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
-		{
-			II_ExternalObjects::Execute_WidgetSelectionUpdated(CurrentObject, Item, IsSelected);
-		}
-	}
+	FIFP_ExternalObjectEvent Event(EIFP_ExternalObjectEvent::WidgetSelection);
+	Event.Flag = IsSelected;
+	IFP_ExternalObjectEvents::QueueItemEvent(Item, Event);
 }
 
 void UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(FS_InventoryItem Item, bool Equipped, TArray<FName> CustomTriggerFilters, FS_InventoryItem OldItemData)
@@ -474,7 +263,7 @@ void UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(FS_InventoryItem Item,
 			continue;
 		}
 		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+		if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 		{
 			II_ExternalObjects::Execute_ItemEquipStatusUpdate(CurrentObject, Item, Equipped, OldItemData);
 		}
@@ -488,7 +277,7 @@ void UFL_ExternalObjects::BroadcastItemEquipStatusUpdate(FS_InventoryItem Item,
 			continue;
 		}
 		
-		if(CurrentObject->GetClass()->ImplementsInterface(UI_ExternalObjects::StaticClass()))
+		if(IFP_ExternalObjectEvents::ImplementsExternalObjects(CurrentObject))
 		{
 			II_ExternalObjects::Execute_ItemEquipStatusUpdate(CurrentObject, Item, Equipped, OldItemData);
 		}
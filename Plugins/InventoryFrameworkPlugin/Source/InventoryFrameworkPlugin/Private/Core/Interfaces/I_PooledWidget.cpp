@@ -0,0 +1,6 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Interfaces/I_PooledWidget.h"
+
+// Add default functionality here for any II_PooledWidget functions that are not pure virtual.
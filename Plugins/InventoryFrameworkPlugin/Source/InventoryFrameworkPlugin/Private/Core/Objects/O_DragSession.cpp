@@ -0,0 +1,291 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Objects/O_DragSession.h"
+
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Items/DA_CoreItem.h"
+
+
+UO_DragSession* UO_DragSession::CreateDragSession(UObject* Outer, FS_InventoryItem Item, TArray<FS_InventoryItem> ItemsToIgnore)
+{
+	UO_DragSession* NewSession = NewObject<UO_DragSession>(Outer ? Outer : GetTransientPackage());
+	NewSession->Item = Item;
+	for(auto& CurrentItem : ItemsToIgnore)
+	{
+		NewSession->IgnoredItems.AddUnique(CurrentItem.UniqueID);
+	}
+
+	if(UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent)
+	{
+		if(ParentComponent->ContainerSettings.IsValidIndex(Item.ContainerIndex))
+		{
+			NewSession->GetPlacement(ParentComponent->ContainerSettings[Item.ContainerIndex]);
+		}
+	}
+
+	return NewSession;
+}
+
+void UO_DragSession::CheckForSpace(const FS_ContainerSettings& Container, int32 TopLeftIndex, TEnumAsByte<ERotation> Rotation, bool& SpotAvailable)
+{
+	const FContainerPlacement& Placement = GetPlacement(Container);
+	if(Placement.AcceptsAnyTile)
+	{
+		SpotAvailable = true;
+		return;
+	}
+
+	SpotAvailable = Placement.RotationMasks.IsValidIndex(TopLeftIndex) && (Placement.RotationMasks[TopLeftIndex] & (1 << Rotation.GetValue())) != 0;
+}
+
+void UO_DragSession::CheckAllRotationsForSpace(const FS_ContainerSettings& Container, int32 TopLeftIndex, TEnumAsByte<ERotation> StartingRotation,
+	bool& SpotAvailable, TEnumAsByte<ERotation>& NeededRotation)
+{
+	NeededRotation = StartingRotation;
+	SpotAvailable = false;
+
+	const FContainerPlacement& Placement = GetPlacement(Container);
+	if(Placement.AcceptsAnyTile)
+	{
+		SpotAvailable = true;
+		return;
+	}
+
+	if(!Placement.RotationMasks.IsValidIndex(TopLeftIndex))
+	{
+		return;
+	}
+
+	const uint8 Mask = Placement.RotationMasks[TopLeftIndex];
+	if(!Placement.CanRotate)
+	{
+		SpotAvailable = (Mask & (1 << StartingRotation.GetValue())) != 0;
+		return;
+	}
+
+	//Same order as UAC_Inventory::CheckAllRotationsForSpace.
+	constexpr int32 RotationCount = static_cast<int32>(ERotation::TwoSeventy) + 1;
+	for(int32 Step = 0; Step < RotationCount; Step++)
+	{
+		const int32 CurrentRotation = (StartingRotation.GetValue() + Step) % RotationCount;
+		if(Mask & (1 << CurrentRotation))
+		{
+			SpotAvailable = true;
+			NeededRotation = static_cast<ERotation>(CurrentRotation);
+			return;
+		}
+	}
+}
+
+void UO_DragSession::InvalidateContainer(FS_UniqueID ContainerID)
+{
+	if(FContainerPlacement* Placement = Containers.Find({ContainerID.ParentComponent, ContainerID.IdentityNumber}))
+	{
+		Placement->Dirty = true;
+	}
+}
+
+void UO_DragSession::InvalidateAllContainers()
+{
+	for(auto& CurrentContainer : Containers)
+	{
+		CurrentContainer.Value.Dirty = true;
+	}
+}
+
+void UO_DragSession::EndSession()
+{
+	for(auto& CurrentComponent : BoundComponents)
+	{
+		if(UAC_Inventory* Component = CurrentComponent.Get())
+		{
+			Component->ItemAdded.RemoveDynamic(this, &UO_DragSession::HandleItemAdded);
+			Component->ItemRemoved.RemoveDynamic(this, &UO_DragSession::HandleItemRemoved);
+			Component->ItemMoved.RemoveDynamic(this, &UO_DragSession::HandleItemMoved);
+			Component->ContainerSizeAdjusted.RemoveDynamic(this, &UO_DragSession::HandleContainerSizeAdjusted);
+			Component->ServerInventoryDataReceived.RemoveDynamic(this, &UO_DragSession::HandleServerInventoryDataReceived);
+		}
+	}
+
+	BoundComponents.Empty();
+	Containers.Empty();
+}
+
+void UO_DragSession::BeginDestroy()
+{
+	EndSession();
+
+	Super::BeginDestroy();
+}
+
+const UO_DragSession::FContainerPlacement& UO_DragSession::GetPlacement(const FS_ContainerSettings& Container)
+{
+	FContainerPlacement& Placement = Containers.FindOrAdd({Container.UniqueID.ParentComponent, Container.UniqueID.IdentityNumber});
+	if(Placement.Dirty)
+	{
+		BuildPlacement(Container, Placement);
+		Placement.Dirty = false;
+	}
+
+	return Placement;
+}
+
+void UO_DragSession::BuildPlacement(const FS_ContainerSettings& Container, FContainerPlacement& OutPlacement)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UO_DragSession::BuildPlacement)
+
+	OutPlacement.RotationMasks.Reset();
+	OutPlacement.CanRotate = false;
+	OutPlacement.AcceptsAnyTile = false;
+
+	UAC_Inventory* Component = Container.UniqueID.ParentComponent;
+	if(!IsValid(Component) || !IsValid(Item.ItemAsset))
+	{
+		return;
+	}
+
+	BindToComponent(Component);
+
+	/**The container that was passed in might be an old copy,
+	 * always read the current TileMap from the component.*/
+	const FS_ContainerSettings& LiveContainer = Component->ContainerSettings.IsValidIndex(Container.ContainerIndex)
+		&& Component->ContainerSettings[Container.ContainerIndex].UniqueID == Container.UniqueID ? Component->ContainerSettings[Container.ContainerIndex] : Container;
+
+	if(LiveContainer.Style == DataOnly)
+	{
+		OutPlacement.AcceptsAnyTile = true;
+		return;
+	}
+
+	int32 Columns = 0;
+	int32 Rows = 0;
+	UFL_InventoryFramework::GetContainerDimensions(LiveContainer, Columns, Rows);
+	const int32 TileCount = LiveContainer.TileMap.Num();
+	if(Columns <= 0 || TileCount == 0)
+	{
+		return;
+	}
+
+	OutPlacement.CanRotate = Component->CanItemBeRotated(Item) && LiveContainer.IsSpacialContainer();
+	OutPlacement.RotationMasks.SetNumZeroed(TileCount);
+
+	//Resolve the TileMap once, instead of once per tile, per shape tile and per rotation.
+	TBitArray<> FreeTiles(false, TileCount);
+	for(int32 TileIndex = 0; TileIndex < TileCount; TileIndex++)
+	{
+		const int32 Occupant = LiveContainer.TileMap[TileIndex];
+		FS_UniqueID OccupantID;
+		OccupantID.IdentityNumber = Occupant;
+		OccupantID.ParentComponent = Component;
+		FreeTiles[TileIndex] = Occupant == -1 || Occupant == Item.UniqueID.IdentityNumber || IgnoredItems.Contains(OccupantID);
+	}
+
+	//Same rules as UAC_Inventory::CheckForSpace and UFL_InventoryFramework::GetItemsShape.
+	const bool CheckDimensions = LiveContainer.Style != Traditional && LiveContainer.ContainerType != Equipment;
+	const bool SingleTile = LiveContainer.ContainerType != Inventory || !LiveContainer.IsSpacialStyle();
+	FS_InventoryItem RotatedItem = Item;
+	for(ERotation CurrentRotation : TEnumRange<ERotation>())
+	{
+		if(CheckDimensions)
+		{
+			RotatedItem.Rotation = CurrentRotation;
+			int32 ItemX = 0;
+			int32 ItemY = 0;
+			UFL_InventoryFramework::GetItemDimensionsWithContext(RotatedItem, LiveContainer, ItemX, ItemY);
+			if(ItemX > LiveContainer.Dimensions.X || ItemY > LiveContainer.Dimensions.Y)
+			{
+				continue;
+			}
+		}
+
+		TArray<FIntPoint> Shape;
+		if(SingleTile)
+		{
+			Shape.Add(FIntPoint(0, 0));
+		}
+		else
+		{
+			Shape = Item.ItemAsset->GetItemsPureShape(CurrentRotation);
+		}
+
+		if(!Shape.IsValidIndex(0))
+		{
+			continue;
+		}
+
+		const uint8 RotationBit = 1 << static_cast<int32>(CurrentRotation);
+		for(int32 TopLeftIndex = 0; TopLeftIndex < TileCount; TopLeftIndex++)
+		{
+			const int32 TopLeftX = TopLeftIndex % Columns;
+			const int32 TopLeftY = TopLeftIndex / Columns;
+
+			bool Fits = true;
+			for(const FIntPoint& CurrentTile : Shape)
+			{
+				const int32 X = TopLeftX + CurrentTile.X;
+				const int32 Y = TopLeftY + CurrentTile.Y;
+				if(X < 0 || Y < 0 || X >= LiveContainer.Dimensions.X || Y >= LiveContainer.Dimensions.Y)
+				{
+					Fits = false;
+					break;
+				}
+
+				const int32 CurrentIndex = Y * Columns + X;
+				if(FreeTiles.IsValidIndex(CurrentIndex) && !FreeTiles[CurrentIndex])
+				{
+					Fits = false;
+					break;
+				}
+			}
+
+			if(Fits)
+			{
+				OutPlacement.RotationMasks[TopLeftIndex] |= RotationBit;
+			}
+		}
+	}
+}
+
+void UO_DragSession::BindToComponent(UAC_Inventory* Component)
+{
+	if(BoundComponents.Contains(Component))
+	{
+		return;
+	}
+
+	BoundComponents.Add(Component);
+	Component->ItemAdded.AddUniqueDynamic(this, &UO_DragSession::HandleItemAdded);
+	Component->ItemRemoved.AddUniqueDynamic(this, &UO_DragSession::HandleItemRemoved);
+	Component->ItemMoved.AddUniqueDynamic(this, &UO_DragSession::HandleItemMoved);
+	Component->ContainerSizeAdjusted.AddUniqueDynamic(this, &UO_DragSession::HandleContainerSizeAdjusted);
+	Component->ServerInventoryDataReceived.AddUniqueDynamic(this, &UO_DragSession::HandleServerInventoryDataReceived);
+}
+
+void UO_DragSession::HandleItemAdded(FS_InventoryItem ItemData, int32 ToIndex, FS_ContainerSettings ToContainer)
+{
+	InvalidateContainer(ToContainer.UniqueID);
+}
+
+void UO_DragSession::HandleItemRemoved(FS_InventoryItem ItemData, FS_ContainerSettings FromContainer)
+{
+	InvalidateContainer(FromContainer.UniqueID);
+}
+
+void UO_DragSession::HandleItemMoved(FS_InventoryItem OriginalItemData, FS_InventoryItem NewItemData, FS_ContainerSettings FromContainer,
+	FS_ContainerSettings ToContainer, UAC_Inventory* FromComponent, UAC_Inventory* ToComponent)
+{
+	InvalidateContainer(FromContainer.UniqueID);
+	InvalidateContainer(ToContainer.UniqueID);
+}
+
+void UO_DragSession::HandleContainerSizeAdjusted(FS_ContainerSettings Container, FMargin Expansion)
+{
+	InvalidateContainer(Container.UniqueID);
+}
+
+void UO_DragSession::HandleServerInventoryDataReceived(AActor* InstigatingActor)
+{
+	InvalidateAllContainers();
+}
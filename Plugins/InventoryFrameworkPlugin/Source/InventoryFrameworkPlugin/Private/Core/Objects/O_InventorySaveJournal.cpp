@@ -0,0 +1,526 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Objects/O_InventorySaveJournal.h"
+
+#include "Async/Async.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/IFP_ContainerSerializer.h"
+#include "Core/Data/SG_InventorySerialization.h"
+#include "HAL/FileManager.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace IFP_SaveJournal
+{
+	static constexpr uint32 BaseMagic = 0x42504649; //"IFPB"
+	static constexpr uint32 JournalMagic = 0x4A504649; //"IFPJ"
+	static constexpr uint16 Version = 1;
+
+	enum EEntryType : uint8
+	{
+		ContainerUpdated = 0,
+		ContainerRemoved = 1
+	};
+
+	/**A single container in the binary container format.
+	 * These are never deserialized during compaction, which is
+	 * what makes compaction safe to run off the game thread.*/
+	struct FContainerBlob
+	{
+		int32 SortKey = 0;
+		TArray<uint8> Data;
+	};
+
+	void WriteEntry(FArchive& Ar, uint8 Type, int32 ContainerID, int32 SortKey, TArray<uint8>& Data)
+	{
+		int32 DataSize = Data.Num();
+		Ar << Type;
+		Ar << ContainerID;
+		Ar << SortKey;
+		Ar << DataSize;
+		Ar.Serialize(Data.GetData(), DataSize);
+	}
+
+	/**Returns false if the base file exists but is unreadable.*/
+	bool ReadBase(const FString& Path, TMap<int32, FContainerBlob>& OutBlobs)
+	{
+		TArray<uint8> FileData;
+		if(!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+		{
+			return true;
+		}
+
+		FMemoryReader Reader(FileData);
+		uint32 Magic = 0;
+		uint16 FileVersion = 0;
+		Reader << Magic;
+		Reader << FileVersion;
+		if(Magic != BaseMagic || FileVersion > Version)
+		{
+			return false;
+		}
+
+		uint32 Count = 0;
+		Reader.SerializeIntPacked(Count);
+		for(uint32 CurrentIndex = 0; CurrentIndex < Count && !Reader.IsError(); CurrentIndex++)
+		{
+			int32 ContainerID = 0;
+			int32 DataSize = 0;
+			FContainerBlob Blob;
+			Reader << ContainerID;
+			Reader << Blob.SortKey;
+			Reader << DataSize;
+			if(DataSize < 0 || DataSize > Reader.TotalSize() - Reader.Tell())
+			{
+				return false;
+			}
+			Blob.Data.SetNumUninitialized(DataSize);
+			Reader.Serialize(Blob.Data.GetData(), DataSize);
+			OutBlobs.Add(ContainerID, MoveTemp(Blob));
+		}
+
+		return !Reader.IsError();
+	}
+
+	/**Replay a journal on top of @InOutBlobs. A journal that was cut
+	 * off mid-write (crash, power loss) is replayed up to the last
+	 * complete entry.*/
+	void ApplyJournal(const FString& Path, TMap<int32, FContainerBlob>& InOutBlobs)
+	{
+		TArray<uint8> FileData;
+		if(!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+		{
+			return;
+		}
+
+		FMemoryReader Reader(FileData);
+		uint32 Magic = 0;
+		uint16 FileVersion = 0;
+		Reader << Magic;
+		Reader << FileVersion;
+		if(Magic != JournalMagic || FileVersion > Version)
+		{
+			return;
+		}
+
+		constexpr int64 EntryHeaderSize = sizeof(uint8) + sizeof(int32) * 3;
+		while(Reader.TotalSize() - Reader.Tell() >= EntryHeaderSize)
+		{
+			uint8 Type = 0;
+			int32 ContainerID = 0;
+			int32 SortKey = 0;
+			int32 DataSize = 0;
+			Reader << Type;
+			Reader << ContainerID;
+			Reader << SortKey;
+			Reader << DataSize;
+			if(DataSize < 0 || DataSize > Reader.TotalSize() - Reader.Tell())
+			{
+				//Incomplete entry.
+				return;
+			}
+
+			if(Type == ContainerRemoved)
+			{
+				InOutBlobs.Remove(ContainerID);
+				continue;
+			}
+
+			FContainerBlob& Blob = InOutBlobs.FindOrAdd(ContainerID);
+			Blob.SortKey = SortKey;
+			Blob.Data.SetNumUninitialized(DataSize);
+			Reader.Serialize(Blob.Data.GetData(), DataSize);
+		}
+	}
+
+	/**Write to a temporary file first, so a crash can't leave a half written base.*/
+	bool WriteBase(const FString& Path, TMap<int32, FContainerBlob>& Blobs)
+	{
+		TArray<uint8> FileData;
+		FMemoryWriter Writer(FileData);
+		uint32 Magic = BaseMagic;
+		uint16 FileVersion = Version;
+		uint32 Count = Blobs.Num();
+		Writer << Magic;
+		Writer << FileVersion;
+		Writer.SerializeIntPacked(Count);
+		for(auto& CurrentBlob : Blobs)
+		{
+			int32 ContainerID = CurrentBlob.Key;
+			int32 DataSize = CurrentBlob.Value.Data.Num();
+			Writer << ContainerID;
+			Writer << CurrentBlob.Value.SortKey;
+			Writer << DataSize;
+			Writer.Serialize(CurrentBlob.Value.Data.GetData(), DataSize);
+		}
+
+		const FString TempPath = Path + TEXT(".tmp");
+		if(!FFileHelper::SaveArrayToFile(FileData, *TempPath))
+		{
+			return false;
+		}
+
+		return IFileManager::Get().Move(*Path, *TempPath, true);
+	}
+
+	bool AppendToJournal(const FString& Path, TArray<uint8>& Entries)
+	{
+		const bool IsNewFile = IFileManager::Get().FileSize(*Path) < 0;
+		FArchive* Writer = IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append);
+		if(!Writer)
+		{
+			return false;
+		}
+
+		if(IsNewFile)
+		{
+			uint32 Magic = JournalMagic;
+			uint16 FileVersion = Version;
+			*Writer << Magic;
+			*Writer << FileVersion;
+		}
+
+		Writer->Serialize(Entries.GetData(), Entries.Num());
+		const bool Success = Writer->Close();
+		delete Writer;
+		return Success;
+	}
+}
+
+UO_InventorySaveJournal* UO_InventorySaveJournal::CreateSaveJournal(UObject* Outer, FString SaveName)
+{
+	UO_InventorySaveJournal* Journal = NewObject<UO_InventorySaveJournal>(Outer ? Outer : GetTransientPackage());
+	Journal->BaseFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SaveName + TEXT(".ifp"));
+	return Journal;
+}
+
+int32 UO_InventorySaveJournal::WriteIncremental(UAC_Inventory* Inventory)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UO_InventorySaveJournal::WriteIncremental)
+
+	if(!IsValid(Inventory) || !Inventory->Initialized)
+	{
+		return 0;
+	}
+
+	if(!Compacting && IFileManager::Get().FileSize(*BaseFilePath) < 0)
+	{
+		return WriteFull(Inventory) ? Inventory->ContainerSettings.Num() : 0;
+	}
+
+	const TSet<int32> DirtyContainers = Inventory->ConsumeDirtyContainers();
+
+	TArray<uint8> Entries;
+	FMemoryWriter Writer(Entries);
+	int32 ContainersWritten = 0;
+
+	TSet<int32> CurrentContainers;
+	TMap<int32, uint32> InstanceHashes;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		const int32 ContainerID = CurrentContainer.UniqueID.IdentityNumber;
+		CurrentContainers.Add(ContainerID);
+
+		const uint32 InstanceHash = GetInstanceHash(CurrentContainer);
+		if(InstanceHash != 0)
+		{
+			InstanceHashes.Add(ContainerID, InstanceHash);
+		}
+
+		/**A container that moved to a new index is rewritten as well, the
+		 * index is what keeps the containers in the right order on load.
+		 * So is one whose item instances were modified without marking it dirty.*/
+		const int32* WrittenIndex = WrittenContainers.Find(ContainerID);
+		if(!DirtyContainers.Contains(ContainerID) && WrittenIndex && *WrittenIndex == CurrentContainer.ContainerIndex
+			&& WrittenInstanceHashes.FindRef(ContainerID) == InstanceHash)
+		{
+			continue;
+		}
+
+		TArray<uint8> ContainerData = SerializeContainer(Inventory, CurrentContainer);
+		IFP_SaveJournal::WriteEntry(Writer, IFP_SaveJournal::ContainerUpdated, ContainerID, CurrentContainer.ContainerIndex, ContainerData);
+		ContainersWritten++;
+	}
+
+	for(auto& CurrentWrittenContainer : WrittenContainers)
+	{
+		if(!CurrentContainers.Contains(CurrentWrittenContainer.Key))
+		{
+			TArray<uint8> EmptyData;
+			IFP_SaveJournal::WriteEntry(Writer, IFP_SaveJournal::ContainerRemoved, CurrentWrittenContainer.Key, -1, EmptyData);
+			ContainersWritten++;
+		}
+	}
+
+	if(ContainersWritten == 0)
+	{
+		return 0;
+	}
+
+	if(!IFP_SaveJournal::AppendToJournal(GetJournalFilePath(), Entries))
+	{
+		UKismetSystemLibrary::PrintString(Inventory, "Failed to write to the save journal - UO_InventorySaveJournal::WriteIncremental");
+		//Nothing was written, so everything we consumed is still dirty.
+		for(const int32 CurrentContainer : DirtyContainers)
+		{
+			Inventory->DirtyContainers.Add(CurrentContainer);
+		}
+		return 0;
+	}
+
+	UpdateWrittenContainers(Inventory, MoveTemp(InstanceHashes));
+
+	if(!Compacting && IFileManager::Get().FileSize(*GetJournalFilePath()) > CompactionThreshold)
+	{
+		CompactAsync();
+	}
+
+	return ContainersWritten;
+}
+
+bool UO_InventorySaveJournal::WriteFull(UAC_Inventory* Inventory)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UO_InventorySaveJournal::WriteFull)
+
+	if(!IsValid(Inventory) || !Inventory->Initialized)
+	{
+		return false;
+	}
+
+	if(Compacting)
+	{
+		/**The worker owns the base file right now. Write everything
+		 * into the journal instead, it gets folded in the next compaction.*/
+		Inventory->MarkAllContainersDirty();
+		WrittenContainers.Reset();
+		return WriteIncremental(Inventory) > 0;
+	}
+
+	TMap<int32, IFP_SaveJournal::FContainerBlob> Blobs;
+	TMap<int32, uint32> InstanceHashes;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		IFP_SaveJournal::FContainerBlob& Blob = Blobs.Add(CurrentContainer.UniqueID.IdentityNumber);
+		Blob.SortKey = CurrentContainer.ContainerIndex;
+		Blob.Data = SerializeContainer(Inventory, CurrentContainer);
+
+		if(const uint32 InstanceHash = GetInstanceHash(CurrentContainer))
+		{
+			InstanceHashes.Add(CurrentContainer.UniqueID.IdentityNumber, InstanceHash);
+		}
+	}
+
+	if(!IFP_SaveJournal::WriteBase(BaseFilePath, Blobs))
+	{
+		UKismetSystemLibrary::PrintString(Inventory, "Failed to write the base save file - UO_InventorySaveJournal::WriteFull");
+		return false;
+	}
+
+	IFileManager::Get().Delete(*GetJournalFilePath(), false, false, true);
+	IFileManager::Get().Delete(*GetCompactingFilePath(), false, false, true);
+	Inventory->ConsumeDirtyContainers();
+	UpdateWrittenContainers(Inventory, MoveTemp(InstanceHashes));
+	return true;
+}
+
+bool UO_InventorySaveJournal::LoadIntoInventory(UAC_Inventory* Inventory)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UO_InventorySaveJournal::LoadIntoInventory)
+
+	if(!IsValid(Inventory) || Inventory->Initialized)
+	{
+		return false;
+	}
+
+	TMap<int32, IFP_SaveJournal::FContainerBlob> Blobs;
+	if(!IFP_SaveJournal::ReadBase(BaseFilePath, Blobs))
+	{
+		UKismetSystemLibrary::PrintString(Inventory, "Base save file is corrupt or from a newer version - UO_InventorySaveJournal::LoadIntoInventory");
+		return false;
+	}
+
+	//A journal that was being compacted when the game closed is replayed first.
+	IFP_SaveJournal::ApplyJournal(GetCompactingFilePath(), Blobs);
+	IFP_SaveJournal::ApplyJournal(GetJournalFilePath(), Blobs);
+
+	if(Blobs.IsEmpty())
+	{
+		return false;
+	}
+
+	Blobs.ValueStableSort([](const IFP_SaveJournal::FContainerBlob& A, const IFP_SaveJournal::FContainerBlob& B)
+	{
+		return A.SortKey < B.SortKey;
+	});
+
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FItemInstanceRecord> InstanceRecords;
+	for(auto& CurrentBlob : Blobs)
+	{
+		TArray<FS_ContainerSettings> BlobContainers;
+		TArray<FItemInstanceRecord> BlobRecords;
+		if(!FIFP_ContainerSerializer::ReadContainers(CurrentBlob.Value.Data, BlobContainers, BlobRecords))
+		{
+			UKismetSystemLibrary::PrintString(Inventory, FString::Printf(TEXT("Skipping unreadable container %d - UO_InventorySaveJournal::LoadIntoInventory"), CurrentBlob.Key));
+			continue;
+		}
+
+		//Records are relative to their blob, offset them to the combined array.
+		for(auto& CurrentRecord : BlobRecords)
+		{
+			CurrentRecord.ContainerIndex += Containers.Num();
+		}
+		for(auto& CurrentContainer : BlobContainers)
+		{
+			CurrentContainer.ContainerIndex = Containers.Num();
+			Containers.Add(CurrentContainer);
+		}
+		InstanceRecords.Append(BlobRecords);
+	}
+
+	USG_InventorySerialization::RestoreContainers(Inventory, Containers, InstanceRecords);
+	Inventory->ConsumeDirtyContainers();
+
+	TMap<int32, uint32> InstanceHashes;
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		if(const uint32 InstanceHash = GetInstanceHash(CurrentContainer))
+		{
+			InstanceHashes.Add(CurrentContainer.UniqueID.IdentityNumber, InstanceHash);
+		}
+	}
+	UpdateWrittenContainers(Inventory, MoveTemp(InstanceHashes));
+	return true;
+}
+
+void UO_InventorySaveJournal::CompactAsync()
+{
+	if(Compacting)
+	{
+		return;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString CompactingPath = GetCompactingFilePath();
+
+	/**If a previous compaction never finished, fold that one first
+	 * and leave the current journal for the next compaction.*/
+	if(FileManager.FileSize(*CompactingPath) < 0)
+	{
+		if(FileManager.FileSize(*GetJournalFilePath()) < 0)
+		{
+			JournalCompacted.Broadcast(true);
+			return;
+		}
+
+		if(!FileManager.Move(*CompactingPath, *GetJournalFilePath(), true))
+		{
+			JournalCompacted.Broadcast(false);
+			return;
+		}
+	}
+
+	Compacting = true;
+	TWeakObjectPtr<UO_InventorySaveJournal> WeakThis = this;
+	const FString BasePath = BaseFilePath;
+	Async(EAsyncExecution::ThreadPool, [WeakThis, BasePath, CompactingPath]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UO_InventorySaveJournal::Compact)
+
+		TMap<int32, IFP_SaveJournal::FContainerBlob> Blobs;
+		bool Success = IFP_SaveJournal::ReadBase(BasePath, Blobs);
+		if(Success)
+		{
+			IFP_SaveJournal::ApplyJournal(CompactingPath, Blobs);
+			Success = IFP_SaveJournal::WriteBase(BasePath, Blobs);
+		}
+
+		if(Success)
+		{
+			IFileManager::Get().Delete(*CompactingPath, false, false, true);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Success]()
+		{
+			if(UO_InventorySaveJournal* Journal = WeakThis.Get())
+			{
+				Journal->Compacting = false;
+				Journal->JournalCompacted.Broadcast(Success);
+			}
+		});
+	});
+}
+
+bool UO_InventorySaveJournal::IsCompacting() const
+{
+	return Compacting;
+}
+
+FString UO_InventorySaveJournal::GetBaseFilePath() const
+{
+	return BaseFilePath;
+}
+
+FString UO_InventorySaveJournal::GetJournalFilePath() const
+{
+	return BaseFilePath + TEXT(".journal");
+}
+
+FString UO_InventorySaveJournal::GetCompactingFilePath() const
+{
+	return BaseFilePath + TEXT(".journal.compacting");
+}
+
+TArray<uint8> UO_InventorySaveJournal::SerializeContainer(UAC_Inventory* Inventory, const FS_ContainerSettings& Container)
+{
+	TArray<FItemInstanceRecord> InstanceRecords;
+	for(auto& CurrentItem : Container.Items)
+	{
+		if(IsValid(CurrentItem.ItemInstance))
+		{
+			FItemInstanceRecord& Record = InstanceRecords.Add_GetRef(USG_InventorySerialization::CreateItemInstanceRecord(CurrentItem.ItemInstance));
+			//The blob only holds this container.
+			Record.ContainerIndex = 0;
+		}
+	}
+
+	TArray<uint8> Data;
+	FIFP_ContainerSerializer::WriteContainers({Inventory->GetContainerForSaveState(Container)}, InstanceRecords, Data);
+	return Data;
+}
+
+uint32 UO_InventorySaveJournal::GetInstanceHash(const FS_ContainerSettings& Container)
+{
+	uint32 Hash = 0;
+	bool InstanceFound = false;
+	for(auto& CurrentItem : Container.Items)
+	{
+		if(!IsValid(CurrentItem.ItemInstance))
+		{
+			continue;
+		}
+
+		InstanceFound = true;
+		const FItemInstanceRecord Record = USG_InventorySerialization::CreateItemInstanceRecord(CurrentItem.ItemInstance);
+		Hash = HashCombine(Hash, GetTypeHash(Record.ItemID));
+		Hash = HashCombine(Hash, GetTypeHash(Record.ObjectClass));
+		Hash = FCrc::MemCrc32(Record.PropertyData.GetData(), Record.PropertyData.Num(), Hash);
+	}
+
+	//0 is reserved for containers without instances.
+	return InstanceFound && Hash == 0 ? 1 : Hash;
+}
+
+void UO_InventorySaveJournal::UpdateWrittenContainers(UAC_Inventory* Inventory, TMap<int32, uint32>&& InstanceHashes)
+{
+	WrittenInstanceHashes = MoveTemp(InstanceHashes);
+	WrittenContainers.Reset();
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		WrittenContainers.Add(CurrentContainer.UniqueID.IdentityNumber, CurrentContainer.ContainerIndex);
+	}
+}
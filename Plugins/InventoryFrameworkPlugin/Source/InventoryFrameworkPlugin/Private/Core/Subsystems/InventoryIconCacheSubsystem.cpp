@@ -0,0 +1,380 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventoryIconCacheSubsystem.h"
+
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Async/Async.h"
+#include "Core/Data/IFP_MemoryTracking.h"
+#include "Core/Items/DA_CoreItem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "TextureResource.h"
+
+void UInventoryIconCacheSubsystem::Deinitialize()
+{
+	Pages.Empty();
+	Cells.Empty();
+	FreeCells.Empty();
+	CellIndexes.Empty();
+	PendingEvictions.Empty();
+	UpdateStats();
+
+	Super::Deinitialize();
+}
+
+UInventoryIconCacheSubsystem* UInventoryIconCacheSubsystem::Get(const UObject* WorldContext)
+{
+	UGameInstance* GameInstance = WorldContext ? UGameplayStatics::GetGameInstance(WorldContext) : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UInventoryIconCacheSubsystem>() : nullptr;
+}
+
+bool UInventoryIconCacheSubsystem::FindIcon(UDA_CoreItem* ItemAsset, FSlateBrush& Icon)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryIconCacheSubsystem::FindIcon)
+
+	if(!CanCacheIcon(ItemAsset))
+	{
+		return false;
+	}
+
+	const FName CacheKey = GetCacheKey(ItemAsset);
+	if(const int32* CellIndex = CellIndexes.Find(CacheKey))
+	{
+		Cells[*CellIndex].LastUsedFrame = GFrameCounter;
+		Icon = MakeBrush(Cells[*CellIndex]);
+		return true;
+	}
+
+	//An icon that is still being written was evicted before the write finished, generate it again.
+	if(!UseDiskCache || PendingWrites.Contains(CacheKey))
+	{
+		return false;
+	}
+
+	TArray<FColor> Pixels;
+	FIntPoint Size;
+	if(!LoadFromDisk(CacheKey, Pixels, Size))
+	{
+		return false;
+	}
+
+	const int32 CellIndex = AllocateCell();
+	FIconCell& Cell = Cells[CellIndex];
+	Cell.CacheKey = CacheKey;
+	Cell.ItemAsset = ItemAsset;
+	Cell.LastUsedFrame = GFrameCounter;
+	CellIndexes.Add(CacheKey, CellIndex);
+	UploadIcon(CellIndex, Pixels, Size);
+
+	Icon = MakeBrush(Cell);
+	UpdateStats();
+	BroadcastEvictions();
+	return true;
+}
+
+bool UInventoryIconCacheSubsystem::StoreIcon(UDA_CoreItem* ItemAsset, UTextureRenderTarget2D* RenderTarget, FSlateBrush& Icon)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryIconCacheSubsystem::StoreIcon)
+
+	if(!CanCacheIcon(ItemAsset) || !IsValid(RenderTarget))
+	{
+		return false;
+	}
+
+	FTextureRenderTargetResource* RenderTargetResource = RenderTarget->GameThread_GetRenderTargetResource();
+	if(!RenderTargetResource)
+	{
+		return false;
+	}
+
+	/**This waits for the capture to finish rendering,
+	 * but only happens once per item asset, instead of
+	 * keeping a render target alive for every icon.*/
+	TArray<FColor> Pixels;
+	FReadSurfaceDataFlags ReadFlags(RCM_UNorm);
+	ReadFlags.SetLinearToGamma(true);
+	if(!RenderTargetResource->ReadPixels(Pixels, ReadFlags))
+	{
+		return false;
+	}
+
+	const FIntPoint Size(RenderTarget->SizeX, RenderTarget->SizeY);
+	const FName CacheKey = GetCacheKey(ItemAsset);
+	int32 CellIndex = INDEX_NONE;
+	if(const int32* ExistingCell = CellIndexes.Find(CacheKey))
+	{
+		CellIndex = *ExistingCell;
+	}
+	else
+	{
+		CellIndex = AllocateCell();
+		CellIndexes.Add(CacheKey, CellIndex);
+	}
+
+	FIconCell& Cell = Cells[CellIndex];
+	Cell.CacheKey = CacheKey;
+	Cell.ItemAsset = ItemAsset;
+	Cell.LastUsedFrame = GFrameCounter;
+	UploadIcon(CellIndex, Pixels, Size);
+
+	if(UseDiskCache && !PendingWrites.Contains(CacheKey) && !FPaths::FileExists(GetCacheFilePath(CacheKey)))
+	{
+		WriteToDisk(CacheKey, MoveTemp(Pixels), Size);
+	}
+
+	Icon = MakeBrush(Cell);
+	UpdateStats();
+	BroadcastEvictions();
+	return true;
+}
+
+bool UInventoryIconCacheSubsystem::CanCacheIcon(const UDA_CoreItem* ItemAsset)
+{
+	return IsValid(ItemAsset) && ItemAsset->UseGeneratedItemIcon && ItemAsset->UseStaticCapture && ItemAsset->OptimizeIconCreation;
+}
+
+void UInventoryIconCacheSubsystem::ClearCache(bool DeleteDiskCache)
+{
+	for(auto& CurrentCell : Cells)
+	{
+		if(!CurrentCell.CacheKey.IsNone())
+		{
+			PendingEvictions.Add(CurrentCell.ItemAsset);
+		}
+	}
+
+	Pages.Empty();
+	Cells.Empty();
+	FreeCells.Empty();
+	CellIndexes.Empty();
+
+	if(DeleteDiskCache)
+	{
+		IFileManager::Get().DeleteDirectory(*GetDiskCacheDirectory(), false, true);
+	}
+
+	UpdateStats();
+	BroadcastEvictions();
+}
+
+void UInventoryIconCacheSubsystem::GetCacheStats(int32& CachedIcons, int32& PageCount, int64& MemoryUsage) const
+{
+	CachedIcons = CellIndexes.Num();
+	PageCount = Pages.Num();
+	MemoryUsage = GetPageMemory() * Pages.Num();
+}
+
+FString UInventoryIconCacheSubsystem::GetDiskCacheDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("InventoryFramework") / TEXT("IconCache");
+}
+
+FName UInventoryIconCacheSubsystem::GetCacheKey(const UDA_CoreItem* ItemAsset)
+{
+	uint32 Hash = GetTypeHash(ItemAsset->GetPathName());
+	Hash = FCrc::MemCrc32(&ItemAsset->IconActorRotation, sizeof(ItemAsset->IconActorRotation), Hash);
+	Hash = FCrc::MemCrc32(&ItemAsset->IconActorLocation, sizeof(ItemAsset->IconActorLocation), Hash);
+	Hash = FCrc::MemCrc32(&ItemAsset->GeneratedIconCameraDistance, sizeof(ItemAsset->GeneratedIconCameraDistance), Hash);
+
+	//Meshes and materials can change between builds without the settings changing.
+	Hash = HashCombine(Hash, GetTypeHash(FString(FApp::GetBuildVersion())));
+
+	return FName(FString::Printf(TEXT("%s_%08X"), *ItemAsset->GetName(), Hash));
+}
+
+FString UInventoryIconCacheSubsystem::GetCacheFilePath(FName CacheKey) const
+{
+	return GetDiskCacheDirectory() / FPaths::MakeValidFileName(CacheKey.ToString()) + TEXT(".png");
+}
+
+int32 UInventoryIconCacheSubsystem::GetPageSize() const
+{
+	return FMath::Max(PageResolution, IconResolution);
+}
+
+int64 UInventoryIconCacheSubsystem::GetPageMemory() const
+{
+	return static_cast<int64>(GetPageSize()) * GetPageSize() * sizeof(FColor);
+}
+
+int32 UInventoryIconCacheSubsystem::AllocateCell()
+{
+	if(FreeCells.IsValidIndex(0))
+	{
+		return FreeCells.Pop(EAllowShrinking::No);
+	}
+
+	if(!Pages.IsValidIndex(0) || GetPageMemory() * (Pages.Num() + 1) <= static_cast<int64>(MemoryBudgetMB) * 1024 * 1024)
+	{
+		AddPage();
+		return FreeCells.Pop(EAllowShrinking::No);
+	}
+
+	//Evict the least recently used icon. Icons requested this frame are most likely on screen, so those are kept.
+	int32 OldestCell = INDEX_NONE;
+	for(int32 CellIndex = 0; CellIndex < Cells.Num(); CellIndex++)
+	{
+		const FIconCell& CurrentCell = Cells[CellIndex];
+		if(CurrentCell.LastUsedFrame < GFrameCounter && (OldestCell == INDEX_NONE || CurrentCell.LastUsedFrame < Cells[OldestCell].LastUsedFrame))
+		{
+			OldestCell = CellIndex;
+		}
+	}
+
+	if(OldestCell == INDEX_NONE)
+	{
+		//Everything is on screen, go over budget until some of it isn't.
+		AddPage();
+		return FreeCells.Pop(EAllowShrinking::No);
+	}
+
+	FIconCell& EvictedCell = Cells[OldestCell];
+	CellIndexes.Remove(EvictedCell.CacheKey);
+	PendingEvictions.Add(EvictedCell.ItemAsset);
+	EvictedCell.CacheKey = NAME_None;
+	EvictedCell.ItemAsset.Reset();
+	return OldestCell;
+}
+
+void UInventoryIconCacheSubsystem::AddPage()
+{
+	const int32 PageSize = GetPageSize();
+	UTexture2D* Page = UTexture2D::CreateTransient(PageSize, PageSize, PF_B8G8R8A8, MakeUniqueObjectName(GetTransientPackage(), UTexture2D::StaticClass(), TEXT("IFP_IconAtlas")));
+	Page->SRGB = true;
+	Page->LODGroup = TEXTUREGROUP_UI;
+	Page->NeverStream = true;
+	Page->UpdateResource();
+
+	const int32 PageIndex = Pages.Add(Page);
+	const int32 CellsPerRow = PageSize / IconResolution;
+
+	//Added in reverse, so cells are handed out from the top left.
+	for(int32 Y = CellsPerRow - 1; Y >= 0; Y--)
+	{
+		for(int32 X = CellsPerRow - 1; X >= 0; X--)
+		{
+			FIconCell& NewCell = Cells.AddDefaulted_GetRef();
+			NewCell.Page = PageIndex;
+			NewCell.Position = FIntPoint(X * IconResolution, Y * IconResolution);
+			FreeCells.Add(Cells.Num() - 1);
+		}
+	}
+}
+
+void UInventoryIconCacheSubsystem::UploadIcon(int32 CellIndex, const TArray<FColor>& Pixels, FIntPoint Size)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryIconCacheSubsystem::UploadIcon)
+
+	const FIconCell& Cell = Cells[CellIndex];
+	UTexture2D* Page = Pages[Cell.Page];
+
+	TArray<FColor> ResizedPixels;
+	const TArray<FColor>* SourcePixels = &Pixels;
+	if(Size.X != IconResolution || Size.Y != IconResolution)
+	{
+		FImageUtils::ImageResize(Size.X, Size.Y, Pixels, IconResolution, IconResolution, ResizedPixels, false, false);
+		SourcePixels = &ResizedPixels;
+	}
+
+	//Both are owned by the render thread until the upload has finished.
+	const int32 DataSize = SourcePixels->Num() * sizeof(FColor);
+	uint8* Data = static_cast<uint8*>(FMemory::Malloc(DataSize));
+	FMemory::Memcpy(Data, SourcePixels->GetData(), DataSize);
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Cell.Position.X, Cell.Position.Y, 0, 0, IconResolution, IconResolution);
+
+	Page->UpdateTextureRegions(0, 1, Region, IconResolution * sizeof(FColor), sizeof(FColor), Data, [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		FMemory::Free(SrcData);
+		delete Regions;
+	});
+}
+
+bool UInventoryIconCacheSubsystem::LoadFromDisk(FName CacheKey, TArray<FColor>& OutPixels, FIntPoint& OutSize) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryIconCacheSubsystem::LoadFromDisk)
+
+	const FString FilePath = GetCacheFilePath(CacheKey);
+	if(!FPaths::FileExists(FilePath))
+	{
+		return false;
+	}
+
+	FImage Image;
+	if(!FImageUtils::LoadImage(*FilePath, Image))
+	{
+		return false;
+	}
+
+	Image.ChangeFormat(ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	const TArrayView64<FColor> ImagePixels = Image.AsBGRA8();
+	OutPixels = TArray<FColor>(ImagePixels.GetData(), ImagePixels.Num());
+	OutSize = FIntPoint(Image.SizeX, Image.SizeY);
+	return true;
+}
+
+void UInventoryIconCacheSubsystem::WriteToDisk(FName CacheKey, TArray<FColor>&& Pixels, FIntPoint Size)
+{
+	PendingWrites.Add(CacheKey);
+
+	TWeakObjectPtr<UInventoryIconCacheSubsystem> WeakThis = this;
+	const FString FilePath = GetCacheFilePath(CacheKey);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, CacheKey, FilePath, Pixels = MoveTemp(Pixels), Size]()
+	{
+		TArray64<uint8> CompressedData;
+		FImageUtils::PNGCompressImageArray(Size.X, Size.Y, Pixels, CompressedData);
+		FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, CacheKey]()
+		{
+			if(UInventoryIconCacheSubsystem* IconCache = WeakThis.Get())
+			{
+				IconCache->PendingWrites.Remove(CacheKey);
+			}
+		});
+	});
+}
+
+FSlateBrush UInventoryIconCacheSubsystem::MakeBrush(const FIconCell& Cell) const
+{
+	const float PageSize = GetPageSize();
+	const FVector2f Min = FVector2f(Cell.Position.X, Cell.Position.Y) / PageSize;
+	const FVector2f Max = FVector2f(Cell.Position.X + IconResolution, Cell.Position.Y + IconResolution) / PageSize;
+
+	FSlateBrush Brush;
+	Brush.SetResourceObject(Pages[Cell.Page]);
+	Brush.SetImageSize(FVector2D(IconResolution, IconResolution));
+	Brush.SetUVRegion(FBox2f(Min, Max));
+	return Brush;
+}
+
+void UInventoryIconCacheSubsystem::BroadcastEvictions()
+{
+	if(!PendingEvictions.IsValidIndex(0))
+	{
+		return;
+	}
+
+	//Listeners may request icons again, which can evict more.
+	TArray<TWeakObjectPtr<UDA_CoreItem>> Evictions = MoveTemp(PendingEvictions);
+	PendingEvictions.Reset();
+	for(auto& CurrentAsset : Evictions)
+	{
+		if(UDA_CoreItem* ItemAsset = CurrentAsset.Get())
+		{
+			IconEvicted.Broadcast(ItemAsset);
+		}
+	}
+}
+
+void UInventoryIconCacheSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_IFP_CachedIcons, CellIndexes.Num());
+	SET_MEMORY_STAT(STAT_IFP_IconAtlasMemory, GetPageMemory() * Pages.Num());
+}
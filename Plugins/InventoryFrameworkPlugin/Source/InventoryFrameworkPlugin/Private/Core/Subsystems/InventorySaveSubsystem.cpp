@@ -0,0 +1,348 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventorySaveSubsystem.h"
+
+#include "Async/Async.h"
+#include "Core/Components/AC_Inventory.h"
+#include "Core/Data/IFP_ContainerSerializer.h"
+#include "Engine/AssetManager.h"
+#include "HAL/FileManager.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace IFP_InventorySave
+{
+	static constexpr uint32 Magic = 0x53504649; //"IFPS"
+	static constexpr uint16 Version = 1;
+}
+
+void UInventorySaveSubsystem::Deinitialize()
+{
+	//Don't let the game instance go away while files are half written.
+	for(auto& CurrentJob : RunningJobs)
+	{
+		CurrentJob->Result.Wait();
+	}
+	RunningJobs.Empty();
+	QueuedJobs.Empty();
+
+	Super::Deinitialize();
+}
+
+void UInventorySaveSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	/**Workers read the item assets and instance classes of the
+	 * snapshots they are writing, make sure those stay alive.*/
+	UInventorySaveSubsystem* This = CastChecked<UInventorySaveSubsystem>(InThis);
+	auto AddJobReferences = [&Collector, This](TArray<TSharedPtr<FSaveJob>>& Jobs)
+	{
+		for(auto& CurrentJob : Jobs)
+		{
+			for(auto& CurrentContainer : CurrentJob->Containers)
+			{
+				Collector.AddPropertyReferencesWithStructARO(FS_ContainerSettings::StaticStruct(), &CurrentContainer, This);
+			}
+			for(auto& CurrentRecord : CurrentJob->InstanceRecords)
+			{
+				Collector.AddReferencedObject(CurrentRecord.ObjectClass, This);
+			}
+		}
+	};
+	AddJobReferences(This->QueuedJobs);
+	AddJobReferences(This->RunningJobs);
+}
+
+bool UInventorySaveSubsystem::SaveInventoryAsync(UAC_Inventory* Inventory, FString SlotName, const FInventorySaveComplete& OnComplete)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventorySaveSubsystem::SaveInventoryAsync)
+
+	if(!IsValid(Inventory) || !Inventory->Initialized || SlotName.IsEmpty())
+	{
+		UKismetSystemLibrary::PrintString(this, "Inventory is invalid, not started or no slot name was given - UInventorySaveSubsystem::SaveInventoryAsync");
+		return false;
+	}
+
+	/**If this slot is still waiting for a worker, the new snapshot
+	 * simply replaces the old one. Both callers get notified.*/
+	TSharedPtr<FSaveJob> Job;
+	for(auto& CurrentJob : QueuedJobs)
+	{
+		if(CurrentJob->SlotName == SlotName)
+		{
+			Job = CurrentJob;
+			break;
+		}
+	}
+
+	if(!Job.IsValid())
+	{
+		Job = MakeShared<FSaveJob>();
+		Job->SlotName = SlotName;
+		QueuedJobs.Add(Job);
+	}
+
+	//Snapshot. Item instances are UObjects, so they have to be serialized here.
+	Job->Containers = Inventory->GetContainersForSaveState();
+	Job->InstanceRecords.Reset();
+	for(auto& CurrentContainer : Inventory->ContainerSettings)
+	{
+		for(auto& CurrentItem : CurrentContainer.Items)
+		{
+			if(IsValid(CurrentItem.ItemInstance))
+			{
+				Job->InstanceRecords.Add(USG_InventorySerialization::CreateItemInstanceRecord(CurrentItem.ItemInstance));
+			}
+		}
+	}
+	Job->AssetPaths.Reset();
+	FIFP_ContainerSerializer::GatherAssetPaths(Job->Containers, Job->InstanceRecords, Job->AssetPaths);
+
+	if(OnComplete.IsBound())
+	{
+		Job->Callbacks.Add(OnComplete);
+	}
+
+	StartQueuedJobs();
+	return true;
+}
+
+bool UInventorySaveSubsystem::LoadInventory(UAC_Inventory* Inventory, FString SlotName)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventorySaveSubsystem::LoadInventory)
+
+	if(!IsValid(Inventory) || Inventory->Initialized)
+	{
+		UKismetSystemLibrary::PrintString(this, "Inventory is invalid or has already been started - UInventorySaveSubsystem::LoadInventory");
+		return false;
+	}
+
+	TArray<uint8> ContainerData;
+	return ReadSlot(SlotName, ContainerData) && RestoreSlot(Inventory, ContainerData);
+}
+
+bool UInventorySaveSubsystem::LoadInventoryAsync(UAC_Inventory* Inventory, FString SlotName, const FInventoryLoadComplete& OnComplete)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventorySaveSubsystem::LoadInventoryAsync)
+
+	if(!IsValid(Inventory) || Inventory->Initialized)
+	{
+		UKismetSystemLibrary::PrintString(this, "Inventory is invalid or has already been started - UInventorySaveSubsystem::LoadInventoryAsync");
+		return false;
+	}
+
+	TSharedRef<TArray<uint8>> ContainerData = MakeShared<TArray<uint8>>();
+	TArray<FSoftObjectPath> AssetPaths;
+	if(!ReadSlot(SlotName, *ContainerData) || !FIFP_ContainerSerializer::GetAssetPaths(*ContainerData, AssetPaths))
+	{
+		return false;
+	}
+
+	AssetPaths.RemoveAll([](const FSoftObjectPath& Path)
+	{
+		return Path.IsNull() || Path.ResolveObject();
+	});
+
+	TWeakObjectPtr<UInventorySaveSubsystem> WeakThis = this;
+	TWeakObjectPtr<UAC_Inventory> WeakInventory = Inventory;
+	auto Restore = [WeakThis, WeakInventory, ContainerData, SlotName, OnComplete]()
+	{
+		UInventorySaveSubsystem* Subsystem = WeakThis.Get();
+		UAC_Inventory* LoadingInventory = WeakInventory.Get();
+		const bool Success = Subsystem && LoadingInventory && !LoadingInventory->Initialized
+			&& Subsystem->RestoreSlot(LoadingInventory, *ContainerData);
+		OnComplete.ExecuteIfBound(SlotName, Success);
+	};
+
+	if(!AssetPaths.IsValidIndex(0))
+	{
+		Restore();
+		return true;
+	}
+
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths, FStreamableDelegate::CreateLambda(Restore));
+	return true;
+}
+
+bool UInventorySaveSubsystem::ReadSlot(const FString& SlotName, TArray<uint8>& OutContainerData)
+{
+	TArray<uint8> FileData;
+	if(!FFileHelper::LoadFileToArray(FileData, *GetSlotFilePath(SlotName), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	int32 UncompressedSize = 0;
+	Reader << Magic;
+	Reader << Version;
+	Reader << UncompressedSize;
+	if(Reader.IsError() || Magic != IFP_InventorySave::Magic || Version > IFP_InventorySave::Version || UncompressedSize < 0)
+	{
+		UKismetSystemLibrary::PrintString(this, "Save file is corrupt or from a newer version - UInventorySaveSubsystem::LoadInventory");
+		return false;
+	}
+
+	OutContainerData.SetNumUninitialized(UncompressedSize);
+	const int32 CompressedSize = FileData.Num() - Reader.Tell();
+	if(!FCompression::UncompressMemory(NAME_Zlib, OutContainerData.GetData(), UncompressedSize, FileData.GetData() + Reader.Tell(), CompressedSize))
+	{
+		UKismetSystemLibrary::PrintString(this, "Failed to decompress save file - UInventorySaveSubsystem::LoadInventory");
+		return false;
+	}
+
+	return true;
+}
+
+bool UInventorySaveSubsystem::RestoreSlot(UAC_Inventory* Inventory, const TArray<uint8>& ContainerData)
+{
+	TArray<FS_ContainerSettings> Containers;
+	TArray<FItemInstanceRecord> InstanceRecords;
+	if(!FIFP_ContainerSerializer::ReadContainers(ContainerData, Containers, InstanceRecords))
+	{
+		UKismetSystemLibrary::PrintString(this, "Container data is corrupt or from a newer version - UInventorySaveSubsystem::LoadInventory");
+		return false;
+	}
+
+	USG_InventorySerialization::RestoreContainers(Inventory, Containers, InstanceRecords);
+	return true;
+}
+
+int32 UInventorySaveSubsystem::GetPendingSaveCount() const
+{
+	return QueuedJobs.Num() + RunningJobs.Num();
+}
+
+bool UInventorySaveSubsystem::IsSlotSaving(const FString& SlotName) const
+{
+	for(auto& CurrentJob : QueuedJobs)
+	{
+		if(CurrentJob->SlotName == SlotName)
+		{
+			return true;
+		}
+	}
+
+	for(auto& CurrentJob : RunningJobs)
+	{
+		if(CurrentJob->SlotName == SlotName)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FString UInventorySaveSubsystem::GetSlotFilePath(const FString& SlotName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".ifps"));
+}
+
+void UInventorySaveSubsystem::StartQueuedJobs()
+{
+	for(int32 JobIndex = 0; JobIndex < QueuedJobs.Num() && RunningJobs.Num() < FMath::Max(MaxConcurrentSaves, 1);)
+	{
+		TSharedPtr<FSaveJob> Job = QueuedJobs[JobIndex];
+
+		//Two workers writing the same file would race, wait for the first one.
+		bool SlotIsRunning = false;
+		for(auto& CurrentJob : RunningJobs)
+		{
+			if(CurrentJob->SlotName == Job->SlotName)
+			{
+				SlotIsRunning = true;
+				break;
+			}
+		}
+
+		if(SlotIsRunning)
+		{
+			JobIndex++;
+			continue;
+		}
+
+		QueuedJobs.RemoveAt(JobIndex);
+		RunningJobs.Add(Job);
+
+		TWeakObjectPtr<UInventorySaveSubsystem> WeakThis = this;
+		Job->Result = Async(EAsyncExecution::ThreadPool, [WeakThis, Job]()
+		{
+			const bool Success = WriteJob(*Job);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Job, Success]()
+			{
+				if(UInventorySaveSubsystem* Subsystem = WeakThis.Get())
+				{
+					Subsystem->FinishJob(Job, Success);
+				}
+			});
+			return Success;
+		});
+	}
+}
+
+void UInventorySaveSubsystem::FinishJob(TSharedPtr<FSaveJob> Job, bool Success)
+{
+	if(RunningJobs.Remove(Job) == 0)
+	{
+		//Subsystem was deinitialized while this was in flight.
+		return;
+	}
+
+	if(!Success)
+	{
+		UKismetSystemLibrary::PrintString(this, FString::Printf(TEXT("Failed to write save slot %s - UInventorySaveSubsystem::FinishJob"), *Job->SlotName));
+	}
+
+	for(auto& CurrentCallback : Job->Callbacks)
+	{
+		CurrentCallback.ExecuteIfBound(Job->SlotName, Success);
+	}
+	SaveFinished.Broadcast(Job->SlotName, Success);
+
+	StartQueuedJobs();
+}
+
+bool UInventorySaveSubsystem::WriteJob(const FSaveJob& Job)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventorySaveSubsystem::WriteJob)
+
+	TArray<uint8> ContainerData;
+	FIFP_ContainerSerializer::WriteContainers(Job.Containers, Job.InstanceRecords, ContainerData, &Job.AssetPaths);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, ContainerData.Num());
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	uint32 Magic = IFP_InventorySave::Magic;
+	uint16 Version = IFP_InventorySave::Version;
+	int32 UncompressedSize = ContainerData.Num();
+	Writer << Magic;
+	Writer << Version;
+	Writer << UncompressedSize;
+
+	const int32 HeaderSize = FileData.Num();
+	FileData.SetNumUninitialized(HeaderSize + CompressedSize);
+	if(!FCompression::CompressMemory(NAME_Zlib, FileData.GetData() + HeaderSize, CompressedSize, ContainerData.GetData(), UncompressedSize))
+	{
+		return false;
+	}
+	FileData.SetNum(HeaderSize + CompressedSize);
+
+	//Write next to the slot first, so a crash never leaves a half written save.
+	const FString FilePath = GetSlotFilePath(Job.SlotName);
+	const FString TempPath = FilePath + TEXT(".tmp");
+	if(!FFileHelper::SaveArrayToFile(FileData, *TempPath))
+	{
+		return false;
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempPath, true);
+}
@@ -0,0 +1,80 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventoryUIAnimationSubsystem.h"
+
+#include "Core/Widgets/W_Container.h"
+#include "Core/Widgets/W_InventoryItem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+
+UInventoryUIAnimationSubsystem* UInventoryUIAnimationSubsystem::Get(const UObject* WorldContext)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UInventoryUIAnimationSubsystem>() : nullptr;
+}
+
+void UInventoryUIAnimationSubsystem::AnimateItemWidget(UW_InventoryItem* Widget)
+{
+	if(IsValid(Widget))
+	{
+		ActiveItemWidgets.AddUnique(Widget);
+	}
+}
+
+void UInventoryUIAnimationSubsystem::SyncNavigationCursor(UW_Container* Container)
+{
+	if(IsValid(Container))
+	{
+		ActiveContainers.AddUnique(Container);
+	}
+}
+
+int32 UInventoryUIAnimationSubsystem::GetActiveAnimationCount() const
+{
+	return ActiveItemWidgets.Num() + ActiveContainers.Num();
+}
+
+void UInventoryUIAnimationSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryUIAnimationSubsystem::Tick)
+
+	Super::Tick(DeltaTime);
+
+	//Widgets animated with the undilated delta time before, keep doing so.
+	const float RealDeltaTime = FApp::GetDeltaTime();
+
+	for(int32 WidgetIndex = ActiveItemWidgets.Num() - 1; WidgetIndex >= 0; WidgetIndex--)
+	{
+		UW_InventoryItem* Widget = ActiveItemWidgets[WidgetIndex].Get();
+		if(!IsValid(Widget) || Widget->TickTransition(RealDeltaTime))
+		{
+			ActiveItemWidgets.RemoveAtSwap(WidgetIndex, 1, EAllowShrinking::No);
+		}
+	}
+
+	for(int32 ContainerIndex = ActiveContainers.Num() - 1; ContainerIndex >= 0; ContainerIndex--)
+	{
+		UW_Container* Container = ActiveContainers[ContainerIndex].Get();
+		if(!IsValid(Container) || Container->TickNavigationCursor())
+		{
+			ActiveContainers.RemoveAtSwap(ContainerIndex, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+bool UInventoryUIAnimationSubsystem::IsTickable() const
+{
+	return ActiveItemWidgets.IsValidIndex(0) || ActiveContainers.IsValidIndex(0);
+}
+
+bool UInventoryUIAnimationSubsystem::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+TStatId UInventoryUIAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventoryUIAnimationSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,192 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Subsystems/InventoryWidgetPoolSubsystem.h"
+
+#include "Core/Data/IFP_MemoryTracking.h"
+#include "Core/Interfaces/I_PooledWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+void UInventoryWidgetPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UInventoryWidgetPoolSubsystem::OnWorldCleanup);
+}
+
+void UInventoryWidgetPoolSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	EmptyPool();
+
+	Super::Deinitialize();
+}
+
+UInventoryWidgetPoolSubsystem* UInventoryWidgetPoolSubsystem::Get(const UObject* WorldContext)
+{
+	ULocalPlayer* LocalPlayer = nullptr;
+	if(const UUserWidget* Widget = Cast<UUserWidget>(WorldContext))
+	{
+		LocalPlayer = Widget->GetOwningLocalPlayer();
+	}
+
+	if(!LocalPlayer)
+	{
+		if(APlayerController* Controller = UGameplayStatics::GetPlayerController(WorldContext, 0))
+		{
+			LocalPlayer = Controller->GetLocalPlayer();
+		}
+	}
+
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UInventoryWidgetPoolSubsystem>() : nullptr;
+}
+
+UUserWidget* UInventoryWidgetPoolSubsystem::AcquireWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryWidgetPoolSubsystem::AcquireWidget)
+
+	if(!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	UUserWidget* Widget = nullptr;
+	if(FIFP_WidgetPoolBucket* Bucket = Pool.Find(WidgetClass.Get()))
+	{
+		while(!Widget && Bucket->Widgets.IsValidIndex(0))
+		{
+			Widget = Bucket->Widgets.Pop(EAllowShrinking::No);
+			PooledCount--;
+			if(!IsValid(Widget))
+			{
+				Widget = nullptr;
+			}
+		}
+	}
+
+	if(Widget)
+	{
+		Hits++;
+		if(Widget->Implements<UI_PooledWidget>())
+		{
+			II_PooledWidget::Execute_AcquiredFromPool(Widget);
+		}
+	}
+	else
+	{
+		Misses++;
+		Widget = CreatePoolWidget(WidgetClass);
+	}
+
+	UpdateStats();
+	return Widget;
+}
+
+void UInventoryWidgetPoolSubsystem::ReleaseWidget(UUserWidget* Widget)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryWidgetPoolSubsystem::ReleaseWidget)
+
+	if(!IsValid(Widget))
+	{
+		return;
+	}
+
+	Widget->RemoveFromParent();
+
+	FIFP_WidgetPoolBucket& Bucket = Pool.FindOrAdd(Widget->GetClass());
+	if(Bucket.Widgets.Num() >= MaxPooledWidgetsPerClass || Bucket.Widgets.Contains(Widget))
+	{
+		return;
+	}
+
+	if(Widget->Implements<UI_PooledWidget>())
+	{
+		II_PooledWidget::Execute_ReleasedToPool(Widget);
+	}
+
+	Bucket.Widgets.Add(Widget);
+	PooledCount++;
+	UpdateStats();
+}
+
+void UInventoryWidgetPoolSubsystem::PrewarmWidgets(TSubclassOf<UUserWidget> WidgetClass, int32 Count)
+{
+	if(!WidgetClass)
+	{
+		return;
+	}
+
+	FIFP_WidgetPoolBucket& Bucket = Pool.FindOrAdd(WidgetClass.Get());
+	const int32 ToCreate = FMath::Min(Count, MaxPooledWidgetsPerClass) - Bucket.Widgets.Num();
+	for(int32 WidgetIndex = 0; WidgetIndex < ToCreate; WidgetIndex++)
+	{
+		if(UUserWidget* Widget = CreatePoolWidget(WidgetClass))
+		{
+			Bucket.Widgets.Add(Widget);
+			PooledCount++;
+		}
+	}
+
+	UpdateStats();
+}
+
+void UInventoryWidgetPoolSubsystem::EmptyPool()
+{
+	Pool.Empty();
+	PooledCount = 0;
+	UpdateStats();
+}
+
+float UInventoryWidgetPoolSubsystem::GetHitRate() const
+{
+	const int32 Total = Hits + Misses;
+	return Total > 0 ? static_cast<float>(Hits) / Total : 0;
+}
+
+void UInventoryWidgetPoolSubsystem::GetPoolStats(int32& PoolHits, int32& PoolMisses, int32& PooledWidgets) const
+{
+	PoolHits = Hits;
+	PoolMisses = Misses;
+	PooledWidgets = PooledCount;
+}
+
+UUserWidget* UInventoryWidgetPoolSubsystem::CreatePoolWidget(TSubclassOf<UUserWidget> WidgetClass) const
+{
+	ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	UWorld* World = LocalPlayer ? LocalPlayer->GetWorld() : nullptr;
+	if(!World)
+	{
+		return nullptr;
+	}
+
+	if(APlayerController* Controller = LocalPlayer->GetPlayerController(World))
+	{
+		return CreateWidget<UUserWidget>(Controller, WidgetClass);
+	}
+
+	return CreateWidget<UUserWidget>(World, WidgetClass);
+}
+
+void UInventoryWidgetPoolSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	for(auto& CurrentBucket : Pool)
+	{
+		PooledCount -= CurrentBucket.Value.Widgets.RemoveAll([World](const TObjectPtr<UUserWidget>& Widget)
+		{
+			return !IsValid(Widget) || Widget->GetWorld() == World;
+		});
+	}
+
+	UpdateStats();
+}
+
+void UInventoryWidgetPoolSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_IFP_WidgetPoolHits, Hits);
+	SET_DWORD_STAT(STAT_IFP_WidgetPoolMisses, Misses);
+	SET_DWORD_STAT(STAT_IFP_PooledWidgets, PooledCount);
+	SET_FLOAT_STAT(STAT_IFP_WidgetPoolHitRate, GetHitRate() * 100);
+}
@@ -0,0 +1,282 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Widgets/SIFP_VirtualizedGrid.h"
+
+#include "Rendering/DrawElements.h"
+
+
+void SIFP_VirtualizedGrid::Construct(const FArguments& InArgs)
+{
+	TileSize = InArgs._TileSize;
+	TilePadding = InArgs._TilePadding;
+	ItemPadding = InArgs._ItemPadding;
+	OnTileHovered = InArgs._OnTileHovered;
+}
+
+void SIFP_VirtualizedGrid::SetGridSize(FIntPoint NewGridSize)
+{
+	NewGridSize.X = FMath::Max(NewGridSize.X, 0);
+	NewGridSize.Y = FMath::Max(NewGridSize.Y, 0);
+	if(GridSize == NewGridSize)
+	{
+		return;
+	}
+
+	GridSize = NewGridSize;
+	TileOccupancy.Init(-1, GridSize.X * GridSize.Y);
+	HoveredTile = -1;
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SIFP_VirtualizedGrid::SetTileSize(FVector2D NewTileSize)
+{
+	if(TileSize != NewTileSize)
+	{
+		TileSize = NewTileSize;
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void SIFP_VirtualizedGrid::SetPadding(const FMargin& NewTilePadding, const FMargin& NewItemPadding)
+{
+	TilePadding = NewTilePadding;
+	ItemPadding = NewItemPadding;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SIFP_VirtualizedGrid::SetTileBrush(const FSlateBrush& NewTileBrush)
+{
+	TileBrush = NewTileBrush;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SIFP_VirtualizedGrid::SetHighlightBrush(const FSlateBrush& NewHighlightBrush)
+{
+	HighlightBrush = NewHighlightBrush;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SIFP_VirtualizedGrid::SetItems(TArray<FIFP_GridItemDrawData>&& NewItems)
+{
+	Items = MoveTemp(NewItems);
+
+	TileOccupancy.Init(-1, GridSize.X * GridSize.Y);
+	for(int32 ItemIndex = 0; ItemIndex < Items.Num(); ItemIndex++)
+	{
+		const FIFP_GridItemDrawData& Item = Items[ItemIndex];
+		const int32 MaxX = FMath::Min(Item.Tile.X + Item.Dimensions.X, GridSize.X);
+		const int32 MaxY = FMath::Min(Item.Tile.Y + Item.Dimensions.Y, GridSize.Y);
+		for(int32 Y = FMath::Max(Item.Tile.Y, 0); Y < MaxY; Y++)
+		{
+			for(int32 X = FMath::Max(Item.Tile.X, 0); X < MaxX; X++)
+			{
+				TileOccupancy[Y * GridSize.X + X] = ItemIndex;
+			}
+		}
+	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SIFP_VirtualizedGrid::SetItemHidden(int32 ItemIndex, bool Hidden)
+{
+	if(Items.IsValidIndex(ItemIndex) && Items[ItemIndex].Hidden != Hidden)
+	{
+		Items[ItemIndex].Hidden = Hidden;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+void SIFP_VirtualizedGrid::SetHighlightedTile(int32 TileIndex)
+{
+	if(HighlightedTile != TileIndex)
+	{
+		HighlightedTile = TileIndex;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+int32 SIFP_VirtualizedGrid::GetTileAtLocalPosition(const FVector2D& LocalPosition) const
+{
+	if(TileSize.X <= 0 || TileSize.Y <= 0 || LocalPosition.X < 0 || LocalPosition.Y < 0)
+	{
+		return -1;
+	}
+
+	const int32 X = FMath::FloorToInt32(LocalPosition.X / TileSize.X);
+	const int32 Y = FMath::FloorToInt32(LocalPosition.Y / TileSize.Y);
+	if(X >= GridSize.X || Y >= GridSize.Y)
+	{
+		return -1;
+	}
+
+	return Y * GridSize.X + X;
+}
+
+int32 SIFP_VirtualizedGrid::GetItemAtTile(int32 TileIndex) const
+{
+	return TileOccupancy.IsValidIndex(TileIndex) ? TileOccupancy[TileIndex] : -1;
+}
+
+FVector2D SIFP_VirtualizedGrid::GetTileLocalPosition(int32 TileIndex) const
+{
+	if(GridSize.X <= 0 || TileIndex < 0)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	return FVector2D(TileIndex % GridSize.X * TileSize.X, TileIndex / GridSize.X * TileSize.Y);
+}
+
+bool SIFP_VirtualizedGrid::GetVisibleTileRange(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	if(GridSize.X <= 0 || GridSize.Y <= 0 || TileSize.X <= 0 || TileSize.Y <= 0)
+	{
+		return false;
+	}
+
+	/**Containers are never rotated in practice, so converting the corners
+	 * is enough to find the part of the grid that is on screen.*/
+	const FVector2D LocalTopLeft = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft());
+	const FVector2D LocalBottomRight = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight());
+
+	OutMin.X = FMath::Max(FMath::FloorToInt32(FMath::Min(LocalTopLeft.X, LocalBottomRight.X) / TileSize.X), 0);
+	OutMin.Y = FMath::Max(FMath::FloorToInt32(FMath::Min(LocalTopLeft.Y, LocalBottomRight.Y) / TileSize.Y), 0);
+	OutMax.X = FMath::Min(FMath::CeilToInt32(FMath::Max(LocalTopLeft.X, LocalBottomRight.X) / TileSize.X), GridSize.X);
+	OutMax.Y = FMath::Min(FMath::CeilToInt32(FMath::Max(LocalTopLeft.Y, LocalBottomRight.Y) / TileSize.Y), GridSize.Y);
+
+	return OutMin.X < OutMax.X && OutMin.Y < OutMax.Y;
+}
+
+int32 SIFP_VirtualizedGrid::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SIFP_VirtualizedGrid::OnPaint)
+
+	FIntPoint VisibleMin;
+	FIntPoint VisibleMax;
+	if(!GetVisibleTileRange(AllottedGeometry, MyCullingRect, VisibleMin, VisibleMax))
+	{
+		return LayerId;
+	}
+
+	const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const FLinearColor WidgetTint = InWidgetStyle.GetColorAndOpacityTint();
+
+	//Tiles. Every box uses the same brush and layer, so Slate batches them into a single draw.
+	if(TileBrush.DrawAs != ESlateBrushDrawType::NoDrawType)
+	{
+		const FVector2D TileDrawSize = FVector2D(
+			FMath::Max(TileSize.X - TilePadding.GetTotalSpaceAlong<Orient_Horizontal>(), 0.f),
+			FMath::Max(TileSize.Y - TilePadding.GetTotalSpaceAlong<Orient_Vertical>(), 0.f));
+		const FLinearColor TileTint = WidgetTint * TileBrush.GetTint(InWidgetStyle);
+		for(int32 Y = VisibleMin.Y; Y < VisibleMax.Y; Y++)
+		{
+			for(int32 X = VisibleMin.X; X < VisibleMax.X; X++)
+			{
+				const FVector2D TilePosition = FVector2D(X * TileSize.X + TilePadding.Left, Y * TileSize.Y + TilePadding.Top);
+				FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+					AllottedGeometry.ToPaintGeometry(TileDrawSize, FSlateLayoutTransform(TilePosition)),
+					&TileBrush, DrawEffects, TileTint);
+			}
+		}
+	}
+
+	//Item icons
+	const int32 ItemLayer = LayerId + 1;
+	for(const FIFP_GridItemDrawData& Item : Items)
+	{
+		if(Item.Hidden || Item.Icon.DrawAs == ESlateBrushDrawType::NoDrawType)
+		{
+			continue;
+		}
+
+		if(Item.Tile.X >= VisibleMax.X || Item.Tile.Y >= VisibleMax.Y
+			|| Item.Tile.X + Item.Dimensions.X <= VisibleMin.X || Item.Tile.Y + Item.Dimensions.Y <= VisibleMin.Y)
+		{
+			continue;
+		}
+
+		const FVector2D ItemPosition = FVector2D(Item.Tile.X * TileSize.X + ItemPadding.Left, Item.Tile.Y * TileSize.Y + ItemPadding.Top);
+		FVector2D ItemSize = FVector2D(
+			FMath::Max(Item.Dimensions.X * TileSize.X - ItemPadding.GetTotalSpaceAlong<Orient_Horizontal>(), 0.f),
+			FMath::Max(Item.Dimensions.Y * TileSize.Y - ItemPadding.GetTotalSpaceAlong<Orient_Vertical>(), 0.f));
+		const FLinearColor IconTint = WidgetTint * Item.Icon.GetTint(InWidgetStyle);
+
+		if(Item.Angle == 0)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, ItemLayer,
+				AllottedGeometry.ToPaintGeometry(ItemSize, FSlateLayoutTransform(ItemPosition)),
+				&Item.Icon, DrawEffects, IconTint);
+			continue;
+		}
+
+		/**Icons are authored for the unrotated item, so draw them at their
+		 * unrotated size around the center of the rotated footprint.*/
+		const FVector2D Center = ItemPosition + ItemSize / 2;
+		if(FMath::IsNearlyEqual(FMath::Abs(FMath::Fmod(Item.Angle, 180.f)), 90.f))
+		{
+			Swap(ItemSize.X, ItemSize.Y);
+		}
+		FSlateDrawElement::MakeRotatedBox(OutDrawElements, ItemLayer,
+			AllottedGeometry.ToPaintGeometry(ItemSize, FSlateLayoutTransform(Center - ItemSize / 2)),
+			&Item.Icon, DrawEffects, FMath::DegreesToRadians(Item.Angle), TOptional<FVector2f>(),
+			FSlateDrawElement::RelativeToElement, IconTint);
+	}
+
+	//Navigation highlight
+	if(HighlightedTile >= 0 && HighlightBrush.DrawAs != ESlateBrushDrawType::NoDrawType)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, ItemLayer + 1,
+			AllottedGeometry.ToPaintGeometry(TileSize, FSlateLayoutTransform(GetTileLocalPosition(HighlightedTile))),
+			&HighlightBrush, DrawEffects, WidgetTint * HighlightBrush.GetTint(InWidgetStyle));
+	}
+
+	return ItemLayer + 1;
+}
+
+FReply SIFP_VirtualizedGrid::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	UpdateHoveredTile(GetTileAtLocalPosition(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition())));
+	return FReply::Unhandled();
+}
+
+void SIFP_VirtualizedGrid::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+	UpdateHoveredTile(-1);
+}
+
+void SIFP_VirtualizedGrid::OnDragEnter(const FGeometry& MyGeometry, const FDragDropEvent& DragDropEvent)
+{
+	UpdateHoveredTile(GetTileAtLocalPosition(MyGeometry.AbsoluteToLocal(DragDropEvent.GetScreenSpacePosition())));
+}
+
+FReply SIFP_VirtualizedGrid::OnDragOver(const FGeometry& MyGeometry, const FDragDropEvent& DragDropEvent)
+{
+	//Unhandled so the container widget still receives the drag.
+	UpdateHoveredTile(GetTileAtLocalPosition(MyGeometry.AbsoluteToLocal(DragDropEvent.GetScreenSpacePosition())));
+	return FReply::Unhandled();
+}
+
+void SIFP_VirtualizedGrid::OnDragLeave(const FDragDropEvent& DragDropEvent)
+{
+	UpdateHoveredTile(-1);
+}
+
+FVector2D SIFP_VirtualizedGrid::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D(GridSize.X * TileSize.X, GridSize.Y * TileSize.Y);
+}
+
+void SIFP_VirtualizedGrid::UpdateHoveredTile(int32 NewTile)
+{
+	if(HoveredTile == NewTile)
+	{
+		return;
+	}
+
+	HoveredTile = NewTile;
+	OnTileHovered.ExecuteIfBound(HoveredTile);
+}
@@ -26,3 +26,8 @@ void UW_AttachmentParent::GetInventory(UAC_Inventory*& Component)
 {
 	Component = ParentItemID.ParentComponent;
 }
+
+void UW_AttachmentParent::ReleasedToPool_Implementation()
+{
+	ParentItemID = FS_UniqueID();
+}
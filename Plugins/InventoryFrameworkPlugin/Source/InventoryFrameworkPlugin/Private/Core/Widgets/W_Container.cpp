@@ -5,10 +5,15 @@
 
 #include "Blueprint/SlateBlueprintLibrary.h"
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Items/DA_CoreItem.h"
+#include "Core/Subsystems/InventoryUIAnimationSubsystem.h"
+#include "Core/Subsystems/InventoryWidgetPoolSubsystem.h"
 #include "Core/Widgets/W_Drag.h"
+#include "Core/Widgets/W_VirtualizedGrid.h"
 #include "Engine/GameInstance.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetSystemLibrary.h"
 
 
 void UW_Container::ConstructContainers_Implementation(FS_ContainerSettings ContainerSetting, UAC_Inventory* InventoryComponent, bool Reinitialize)
@@ -25,6 +30,279 @@ UAC_Inventory* UW_Container::GetInventory()
 	return nullptr;
 }
 
+void UW_Container::ReleaseWidgetsToPool()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UW_Container::ReleaseWidgetsToPool)
+
+	UInventoryWidgetPoolSubsystem* WidgetPool = UInventoryWidgetPoolSubsystem::Get(this);
+	for(auto& CurrentTile : Tiles)
+	{
+		if(!IsValid(CurrentTile))
+		{
+			continue;
+		}
+
+		if(WidgetPool)
+		{
+			WidgetPool->ReleaseWidget(CurrentTile);
+		}
+		else
+		{
+			CurrentTile->RemoveFromParent();
+		}
+	}
+	Tiles.Empty();
+
+	UAC_Inventory* ParentComponent = GetInventory();
+	const int32 ContainerIndex = GetContainerSettings().ContainerIndex;
+	if(IsValid(ParentComponent) && ParentComponent->ContainerSettings.IsValidIndex(ContainerIndex))
+	{
+		for(auto& CurrentItem : ParentComponent->ContainerSettings[ContainerIndex].Items)
+		{
+			if(IsValid(CurrentItem.Widget))
+			{
+				CurrentItem.Widget->DestroyWidget();
+				CurrentItem.Widget = nullptr;
+			}
+		}
+	}
+
+	VirtualizedItemWidget = nullptr;
+	VirtualizedItem = FS_InventoryItem();
+}
+
+UW_Tile* UW_Container::AcquireTileWidget(int32 TileIndex)
+{
+	UW_Tile* Tile = UInventoryWidgetPoolSubsystem::AcquireWidget<UW_Tile>(this, TileClass);
+	if(!Tile || TileIndex < 0)
+	{
+		return Tile;
+	}
+
+	Tile->TileIndex = TileIndex;
+	Tile->ParentContainer = this;
+	Tile->SetWidgetSize(TileSize);
+	Tile->SetWidgetPadding(TilePadding);
+	if(UseCustomTileBrush)
+	{
+		Tile->ReceiveCustomBrushSettings(CustomTileBrush);
+	}
+
+	if(Tiles.Num() <= TileIndex)
+	{
+		Tiles.SetNum(TileIndex + 1);
+	}
+	Tiles[TileIndex] = Tile;
+
+	if(UUniformGridPanel* GridPanel = GetGridPanel())
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		UFL_InventoryFramework::IndexToTile(TileIndex, TemporaryContainerSettings, X, Y);
+		GridPanel->AddChildToUniformGrid(Tile, Y, X);
+	}
+
+	return Tile;
+}
+
+UW_InventoryItem* UW_Container::AcquireItemWidget(FS_InventoryItem& Item)
+{
+	TSubclassOf<UW_InventoryItem> WidgetClass = ItemClass;
+	if(IsValid(Item.ItemAsset))
+	{
+		const TSubclassOf<UW_InventoryItem>* WidgetOverride = Item.ItemAsset->ItemWidgetOverrides.Find(GetClass());
+		if(WidgetOverride && *WidgetOverride)
+		{
+			WidgetClass = *WidgetOverride;
+		}
+	}
+
+	UW_InventoryItem* Widget = UInventoryWidgetPoolSubsystem::AcquireWidget<UW_InventoryItem>(this, WidgetClass);
+	if(!Widget)
+	{
+		return nullptr;
+	}
+
+	Widget->RebindItem(Item, this);
+	Item.Widget = Widget;
+
+	//Update the ref in the component as well, the @Item might be a copy.
+	UAC_Inventory* ParentComponent = Item.UniqueID.ParentComponent;
+	if(IsValid(ParentComponent) && ParentComponent->ContainerSettings.IsValidIndex(Item.ContainerIndex))
+	{
+		TArray<FS_InventoryItem>& ContainerItems = ParentComponent->ContainerSettings[Item.ContainerIndex].Items;
+		if(ContainerItems.IsValidIndex(Item.ItemIndex) && ContainerItems[Item.ItemIndex].UniqueID == Item.UniqueID)
+		{
+			ContainerItems[Item.ItemIndex].Widget = Widget;
+		}
+	}
+
+	return Widget;
+}
+
+bool UW_Container::ConstructVirtualizedGrid()
+{
+	UW_VirtualizedGrid* Grid = GetVirtualizedGrid();
+	if(!Grid)
+	{
+		UKismetSystemLibrary::PrintString(this, "GetVirtualizedGrid returned nothing - UW_Container::ConstructVirtualizedGrid");
+		return false;
+	}
+
+	if(!GetContainerSettings().IsSpacialContainer())
+	{
+		UKismetSystemLibrary::PrintString(this, "Virtualized grids only support spacial containers - UW_Container::ConstructVirtualizedGrid");
+		return false;
+	}
+
+	Grid->TileHovered.AddUniqueDynamic(this, &UW_Container::VirtualizedTileHovered);
+	RefreshVirtualizedGrid();
+	return true;
+}
+
+void UW_Container::RefreshVirtualizedGrid()
+{
+	VirtualizedGridDirty = false;
+	
+	UW_VirtualizedGrid* Grid = GetVirtualizedGrid();
+	if(!Grid)
+	{
+		return;
+	}
+
+	Grid->RefreshGrid(this);
+	if(IsValid(VirtualizedItemWidget))
+	{
+		Grid->SetItemHidden(VirtualizedItem, true);
+	}
+}
+
+void UW_Container::MarkVirtualizedGridDirty()
+{
+	if(VirtualizedGridDirty)
+	{
+		return;
+	}
+
+	VirtualizedGridDirty = true;
+	//Uses the core ticker so the grid is still refreshed while paused.
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+	{
+		if(VirtualizedGridDirty)
+		{
+			RefreshVirtualizedGrid();
+		}
+		return false;
+	}));
+}
+
+UW_InventoryItem* UW_Container::RequestWidgetForItem(FS_InventoryItem& Item)
+{
+	if(!UseVirtualizedGrid)
+	{
+		UW_InventoryItem* Widget = nullptr;
+		CreateWidgetForItem(Item, Widget);
+		return Widget;
+	}
+
+	MarkVirtualizedGridDirty();
+
+	bool IsItemInUse = Item.UniqueID == CurrentNavigatedItem.UniqueID;
+	UW_VirtualizedGrid* Grid = GetVirtualizedGrid();
+	if(!IsItemInUse && Grid && Grid->GetHoveredTile() >= 0 && IsValid(Item.UniqueID.ParentComponent))
+	{
+		TArray<int32> ItemTiles;
+		bool InvalidTileFound;
+		Item.UniqueID.ParentComponent->GetItemsTileIndexes(Item, ItemTiles, InvalidTileFound);
+		IsItemInUse = ItemTiles.Contains(Grid->GetHoveredTile());
+	}
+
+	return IsItemInUse ? RealizeVirtualizedItem(Item) : nullptr;
+}
+
+UW_InventoryItem* UW_Container::RealizeVirtualizedItem(FS_InventoryItem Item)
+{
+	if(IsValid(VirtualizedItemWidget))
+	{
+		if(VirtualizedItem == Item)
+		{
+			return VirtualizedItemWidget;
+		}
+
+		ReleaseVirtualizedItem();
+		if(IsValid(VirtualizedItemWidget))
+		{
+			//Previous item is being dragged, leave it alone until the drag is over.
+			return nullptr;
+		}
+	}
+
+	if(!Item.IsValid())
+	{
+		return nullptr;
+	}
+
+	UW_InventoryItem* Widget = nullptr;
+	CreateWidgetForItem(Item, Widget);
+	if(!Widget)
+	{
+		return nullptr;
+	}
+
+	VirtualizedItemWidget = Widget;
+	VirtualizedItem = Item;
+	if(UW_VirtualizedGrid* Grid = GetVirtualizedGrid())
+	{
+		Grid->SetItemHidden(Item, true);
+	}
+
+	return Widget;
+}
+
+void UW_Container::ReleaseVirtualizedItem()
+{
+	if(!IsValid(VirtualizedItemWidget))
+	{
+		return;
+	}
+
+	//The drag widget still needs the item widget it was started from.
+	UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this);
+	if(LocalInventory && LocalInventory->DragWidget && LocalInventory->DragWidget->ItemData == VirtualizedItem)
+	{
+		return;
+	}
+
+	VirtualizedItemWidget->DestroyWidget();
+	if(UW_VirtualizedGrid* Grid = GetVirtualizedGrid())
+	{
+		Grid->SetItemHidden(VirtualizedItem, false);
+	}
+
+	VirtualizedItemWidget = nullptr;
+	VirtualizedItem = FS_InventoryItem();
+}
+
+void UW_Container::VirtualizedTileHovered(int32 TileIndex, FS_InventoryItem Item)
+{
+	/**The cursor either left the container or moved onto the realized
+	 * item widget, which sits above the grid. Leaving is handled
+	 * by NativeOnMouseLeave.*/
+	if(TileIndex < 0)
+	{
+		return;
+	}
+
+	if(Item.IsValid())
+	{
+		RealizeVirtualizedItem(Item);
+	}
+	else if(!(VirtualizedItem == CurrentNavigatedItem))
+	{
+		ReleaseVirtualizedItem();
+	}
+}
+
 FS_ContainerSettings UW_Container::GetContainerSettings()
 {
 	if(UAC_Inventory* ParentComponent = GetInventory(); IsValid(ParentComponent))
@@ -83,6 +361,38 @@ int32 UW_Container::GetCurrentNavigatedTile()
 
 bool UW_Container::SetCurrentNavigatedTile(int32 NewTile)
 {
+	if(UseVirtualizedGrid)
+	{
+		UW_VirtualizedGrid* Grid = GetVirtualizedGrid();
+		int32 X = 0;
+		int32 Y = 0;
+		UFL_InventoryFramework::GetContainerDimensions(GetContainerSettings(), X, Y);
+		if(!Grid || NewTile < 0 || NewTile >= X * Y)
+		{
+			return false;
+		}
+
+		CurrentNavigatedTile = NewTile;
+		Grid->SetHighlightedTile(NewTile);
+		if(UScrollBox* ScrollBox = GetScrollBox())
+		{
+			//There's no tile widget to scroll into view, so scroll to the tile's row instead.
+			const float TileTop = Grid->GetTileLocalPosition(NewTile).Y;
+			const float ViewHeight = ScrollBox->GetCachedGeometry().GetLocalSize().Y;
+			const float ScrollOffset = ScrollBox->GetScrollOffset();
+			if(TileTop < ScrollOffset)
+			{
+				ScrollBox->SetScrollOffset(TileTop);
+			}
+			else if(TileTop + TileSize.Y > ScrollOffset + ViewHeight)
+			{
+				ScrollBox->SetScrollOffset(TileTop + TileSize.Y - ViewHeight);
+			}
+		}
+		StartNavigationCursorSync();
+		return true;
+	}
+
 	if(Tiles.IsValidIndex(CurrentNavigatedTile))
 	{
 		Tiles[CurrentNavigatedTile]->IsTileHighlighted = false;
@@ -96,6 +406,7 @@ bool UW_Container::SetCurrentNavigatedTile(int32 NewTile)
 		{
 			ScrollBox->ScrollWidgetIntoView(Tiles[NewTile]);
 		}
+		StartNavigationCursorSync();
 		return true;
 	}
 
@@ -128,6 +439,11 @@ bool UW_Container::SetCurrentNavigatedItem_Implementation(FS_InventoryItem NewIt
 	CurrentNavigatedItem = NewItem;
 	if(CurrentNavigatedItem.IsValid())
 	{
+		if(UseVirtualizedGrid)
+		{
+			RealizeVirtualizedItem(NewItem);
+		}
+
 		if(UW_InventoryItem* ItemWidget = UFL_InventoryFramework::GetWidgetForItem(NewItem))
 		{
 			ItemWidget->ItemHighlightUpdated(true);
@@ -144,35 +460,63 @@ void UW_Container::StopNavigation()
 {
 }
 
-void UW_Container::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UW_Container::StartNavigationCursorSync()
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	if(!Tiles.IsValidIndex(CurrentNavigatedTile))
+	LastNavigationCursorPosition = FIntPoint(INDEX_NONE);
+	if(UInventoryUIAnimationSubsystem* AnimationSubsystem = UInventoryUIAnimationSubsystem::Get(this))
 	{
-		return;
+		AnimationSubsystem->SyncNavigationCursor(this);
 	}
+}
 
-	//V: Opacity is handled in here rather than NativePaint because it's CONST :))))
-	//V: We handle the tiles Tick logic in here so we can continue having tick disabled
-	//on the tile widget to improve performance.
-	// Tiles[CurrentNavigatedTile]->HighlightOpacity = FMath::FInterpTo(Tiles[CurrentNavigatedTile]->HighlightOpacity,
-	// 	Tiles[CurrentNavigatedTile]->IsTileHighlighted ? 1 : 0, FApp::GetDeltaTime(), 15);
-	if(Tiles[CurrentNavigatedTile]->IsTileHighlighted && Tiles[CurrentNavigatedTile]->IsVisible())
+bool UW_Container::TickNavigationCursor()
+{
+	FGeometry TileGeometry;
+	FVector2D TileOffset = FVector2D(0);
+	if(UseVirtualizedGrid)
 	{
-		//The player is using gamepad navigation, try to set the mouse location to the tiles screen position
-		//to simulate as if the player is still using the mouse
-		if(APlayerController* Controller = UGameplayStatics::GetPlayerController(this, 0))
+		UW_VirtualizedGrid* Grid = GetVirtualizedGrid();
+		if(!Grid || Grid->GetHighlightedTile() < 0 || !Grid->IsVisible())
 		{
-			FVector2D PixelPosition;
-			FVector2D ViewportPosition;
-			USlateBlueprintLibrary::LocalToViewport(this, Tiles[CurrentNavigatedTile]->GetTickSpaceGeometry(), FVector2D(0), PixelPosition, ViewportPosition);
-				
-			//Remember to ceil the float, otherwise there might be cases where the cursor slightly
-			//touches an item widget in an adjacent tile and the tooltip will appear
-			Controller->SetMouseLocation(FMath::FloorToInt(PixelPosition.X) + TileSize.X, FMath::CeilToInt(PixelPosition.Y) + (TileSize.Y / 2));
+			return true;
 		}
+
+		TileGeometry = Grid->GetTickSpaceGeometry();
+		TileOffset = Grid->GetTileLocalPosition(Grid->GetHighlightedTile());
 	}
+	else
+	{
+		if(!Tiles.IsValidIndex(CurrentNavigatedTile) || !Tiles[CurrentNavigatedTile]->IsTileHighlighted || !Tiles[CurrentNavigatedTile]->IsVisible())
+		{
+			return true;
+		}
+
+		TileGeometry = Tiles[CurrentNavigatedTile]->GetTickSpaceGeometry();
+	}
+
+	APlayerController* Controller = UGameplayStatics::GetPlayerController(this, 0);
+	if(!Controller)
+	{
+		return true;
+	}
+
+	FVector2D PixelPosition;
+	FVector2D ViewportPosition;
+	USlateBlueprintLibrary::LocalToViewport(this, TileGeometry, TileOffset, PixelPosition, ViewportPosition);
+
+	//Remember to ceil the float, otherwise there might be cases where the cursor slightly
+	//touches an item widget in an adjacent tile and the tooltip will appear
+	const FIntPoint CursorPosition = FIntPoint(
+		FMath::TruncToInt32(FMath::FloorToInt(PixelPosition.X) + TileSize.X),
+		FMath::TruncToInt32(FMath::CeilToInt(PixelPosition.Y) + (TileSize.Y / 2)));
+	if(CursorPosition == LastNavigationCursorPosition)
+	{
+		return true;
+	}
+
+	LastNavigationCursorPosition = CursorPosition;
+	Controller->SetMouseLocation(CursorPosition.X, CursorPosition.Y);
+	return false;
 }
 
 UW_Container* UW_Container::GetNextContainerToNavigateTo_Implementation(
@@ -264,7 +608,20 @@ UW_Container* UW_Container::GetNextContainerToNavigateTo_Implementation(
 
 void UW_Container::CreateWidgetForItem_Implementation(FS_InventoryItem& Item, UW_InventoryItem*& Widget)
 {
-	//Handled in blueprint.
+	//Usually overriden in blueprint, which should use AcquireItemWidget as well.
+	Widget = AcquireItemWidget(Item);
+	if(!Widget)
+	{
+		return;
+	}
+
+	if(UUniformGridPanel* GridPanel = GetGridPanel())
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		UFL_InventoryFramework::IndexToTile(Item.TileIndex, TemporaryContainerSettings, X, Y);
+		GridPanel->AddChildToUniformGrid(Widget, Y, X);
+	}
 }
 
 
@@ -292,6 +649,11 @@ void UW_Container::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
 {
 	Super::NativeOnMouseLeave(InMouseEvent);
 
+	if(UseVirtualizedGrid && !(VirtualizedItem == CurrentNavigatedItem))
+	{
+		ReleaseVirtualizedItem();
+	}
+
 	/**If we are using IFP's custom drag drop system, then call regular OnDragLeave
 	* if we are dragging an item.*/
 	UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this);
@@ -3,3 +3,58 @@
 
 #include "Core/Widgets/W_Drag.h"
 
+#include "Core/Objects/O_DragSession.h"
+
+UO_DragSession* UW_Drag::GetDragSession()
+{
+	//Pooled drag widgets are reused for other items.
+	if(DragSession && DragSession->GetItem().UniqueID != ItemData.UniqueID)
+	{
+		EndDragSession();
+	}
+
+	if(!DragSession)
+	{
+		DragSession = UO_DragSession::CreateDragSession(this, ItemData, {ItemData});
+	}
+
+	return DragSession;
+}
+
+void UW_Drag::ReleasedToPool_Implementation()
+{
+	DropOperation = Cancel;
+	DragDropOperation = nullptr;
+	CurrentHoverTile = nullptr;
+	OldHoverTile = nullptr;
+	ItemData = FS_InventoryItem();
+	AnchorPoint.Empty();
+	SplitAmount = 0;
+	SkipCollisionCheck = false;
+	ItemToStackWith = FS_InventoryItem();
+	CombineDirections = FIntPoint(-1, -1);
+	CombineRotation = Zero;
+	TargetComponent = nullptr;
+	PerformDropOnDestruction = true;
+	EndDragSession();
+
+	//Whoever acquires the widget next binds their own events.
+	HoverTileUpdated.Clear();
+	Destroyed.Clear();
+}
+
+void UW_Drag::NativeDestruct()
+{
+	EndDragSession();
+
+	Super::NativeDestruct();
+}
+
+void UW_Drag::EndDragSession()
+{
+	if(DragSession)
+	{
+		DragSession->EndSession();
+		DragSession = nullptr;
+	}
+}
@@ -4,6 +4,8 @@
 #include "Core/Widgets/W_InventoryItem.h"
 
 #include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Subsystems/InventoryUIAnimationSubsystem.h"
+#include "Core/Subsystems/InventoryWidgetPoolSubsystem.h"
 #include "Core/Items/DA_CoreItem.h"
 #include "Core/Widgets/W_Container.h"
 #include "Core/Widgets/W_Drag.h"
@@ -179,6 +181,58 @@ void UW_InventoryItem::ConstructItemWidget_Implementation()
 
 void UW_InventoryItem::DestroyWidget_Implementation()
 {
+	if(UInventoryWidgetPoolSubsystem* WidgetPool = UInventoryWidgetPoolSubsystem::Get(this))
+	{
+		//ReleasedToPool clears the item's ref to this widget.
+		WidgetPool->ReleaseWidget(this);
+		return;
+	}
+
+	ClearItemWidgetReference();
+	RemoveFromParent();
+}
+
+void UW_InventoryItem::ClearItemWidgetReference()
+{
+	UAC_Inventory* ParentComponent = ItemID.ParentComponent;
+	if(!IsValid(ParentComponent))
+	{
+		return;
+	}
+
+	const FS_InventoryItem ItemData = ParentComponent->GetItemByUniqueID(ItemID);
+	if(!ItemData.IsValid() || !ParentComponent->ContainerSettings.IsValidIndex(ItemData.ContainerIndex))
+	{
+		return;
+	}
+
+	TArray<FS_InventoryItem>& ContainerItems = ParentComponent->ContainerSettings[ItemData.ContainerIndex].Items;
+	if(ContainerItems.IsValidIndex(ItemData.ItemIndex) && ContainerItems[ItemData.ItemIndex].Widget == this)
+	{
+		ContainerItems[ItemData.ItemIndex].Widget = nullptr;
+	}
+}
+
+void UW_InventoryItem::RebindItem_Implementation(FS_InventoryItem NewItem, UW_Container* NewParentContainer)
+{
+	ItemID = NewItem.UniqueID;
+	ItemsArrayIndex = NewItem.ItemIndex;
+	ParentContainer = NewParentContainer;
+	ContainerID = FS_UniqueID();
+	RawItemData = FS_InventoryItem();
+
+	UAC_Inventory* ParentComponent = NewItem.UniqueID.ParentComponent;
+	if(IsValid(ParentComponent) && ParentComponent->ContainerSettings.IsValidIndex(NewItem.ContainerIndex))
+	{
+		ContainerID = ParentComponent->ContainerSettings[NewItem.ContainerIndex].UniqueID;
+	}
+	else
+	{
+		//Item isn't inside a component, so GetItemData has nothing to look it up from.
+		RawItemData = NewItem;
+	}
+
+	ConstructItemWidget();
 }
 
 FVector2D UW_InventoryItem::GetItemWidgetSize(FVector2D TileSizeOverride, bool IgnoreRotation)
@@ -242,7 +296,51 @@ FVector2D UW_InventoryItem::GetItemWidgetSize(FVector2D TileSizeOverride, bool I
 void UW_InventoryItem::ItemHighlightUpdated_Implementation(bool NewIsHighlighted)
 {
 	IsHighlighted = NewIsHighlighted;
-	ScaleTarget = IsHighlighted ? 1.1 : 1;
+	SetScaleTarget(IsHighlighted ? 1.1 : 1);
+}
+
+/**Drag widgets are created for every drag, so hand them back
+ * to the widget pool instead of throwing them away.*/
+static void ReleaseDragWidget(UW_Drag* DragWidget)
+{
+	if(!DragWidget)
+	{
+		return;
+	}
+
+	if(UInventoryWidgetPoolSubsystem* WidgetPool = UInventoryWidgetPoolSubsystem::Get(DragWidget))
+	{
+		WidgetPool->ReleaseWidget(DragWidget);
+		return;
+	}
+
+	DragWidget->RemoveFromParent();
+}
+
+UW_Drag* UW_InventoryItem::AcquireDragWidget(TSubclassOf<UW_Drag> DragClass)
+{
+	UW_Drag* DragWidget = UInventoryWidgetPoolSubsystem::AcquireWidget<UW_Drag>(this, DragClass);
+	if(!DragWidget)
+	{
+		return nullptr;
+	}
+
+	DragWidget->ItemData = GetItemData();
+	DragWidget->AnchorPoint = GetAnchorPoint();
+
+	UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this);
+	DragWidget->TargetComponent = LocalInventory;
+	if(LocalInventory)
+	{
+		if(LocalInventory->DragWidget != DragWidget)
+		{
+			//A previous drag never got to clean up after itself.
+			ReleaseDragWidget(LocalInventory->DragWidget);
+		}
+		LocalInventory->DragWidget = DragWidget;
+	}
+
+	return DragWidget;
 }
 
 UDragDropOperation* UW_InventoryItem::StartDragItem_Implementation()
@@ -250,6 +348,14 @@ UDragDropOperation* UW_InventoryItem::StartDragItem_Implementation()
 	IsDragging = true;
 	UDragDropOperation* DropOperation = nullptr;
 	OnDragDetected(FGeometry(), FPointerEvent(), DropOperation);
+
+	//Work out where the item fits in its own container now, instead of on the first highlight update.
+	UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this);
+	if(LocalInventory && LocalInventory->DragWidget)
+	{
+		LocalInventory->DragWidget->GetDragSession();
+	}
+
 	return DropOperation;
 }
 
@@ -259,7 +365,7 @@ void UW_InventoryItem::StopDragItem_Implementation()
 	ItemDragEnded.Broadcast(this);
 	if(UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this))
 	{
-		LocalInventory->DragWidget->RemoveFromParent();
+		ReleaseDragWidget(LocalInventory->DragWidget);
 		LocalInventory->DragWidget = nullptr;
 	}
 }
@@ -271,7 +377,7 @@ void UW_InventoryItem::CancelDragItem_Implementation()
 	if(UAC_Inventory* LocalInventory = UFL_InventoryFramework::GetLocalInventoryComponent(this))
 	{
 		LocalInventory->DragWidget->PerformDropOnDestruction = false;
-		LocalInventory->DragWidget->RemoveFromParent();
+		ReleaseDragWidget(LocalInventory->DragWidget);
 		LocalInventory->DragWidget = nullptr;
 	}
 }
@@ -292,13 +398,114 @@ FLinearColor UW_InventoryItem::GetBackgroundColor_Implementation()
 	return CurrentBackgroundColor;
 }
 
-void UW_InventoryItem::NativeTick(const FGeometry& MovieSceneBlends, float InDeltaTime)
+void UW_InventoryItem::ReleasedToPool_Implementation()
 {
-	Super::NativeTick(MovieSceneBlends, InDeltaTime);
+	if(ItemID.ParentComponent)
+	{
+		//Attachment widget is no longer reachable from this widget, let it idle out.
+		FS_InventoryItem Item;
+		Item.UniqueID = ItemID;
+		ItemID.ParentComponent->CollapseAttachmentWidget(Item);
+	}
 
-	SetRenderOpacity(FMath::FInterpTo(GetRenderOpacity(), OpacityTarget, InDeltaTime, 15.0));
+	ClearItemWidgetReference();
+
+	ItemID = FS_UniqueID();
+	ContainerID = FS_UniqueID();
+	ItemsArrayIndex = -1;
+	ParentContainer = nullptr;
+	RawItemData = FS_InventoryItem();
+	IsDragging = false;
+	IsHighlighted = false;
+	OpacityTarget = 1;
+	ScaleTarget = 1;
+	CurrentHoveredTile = FIntPoint();
+	SetRenderOpacity(1);
+	SetRenderScale(FVector2D(1));
+
+	//Whoever acquires the widget next binds their own events.
+	ItemCountChanged.Clear();
+	OpenContextMenu.Clear();
+	ItemDragged.Clear();
+	ItemDragEnded.Clear();
+	ItemPressed.Clear();
+}
+
+void UW_InventoryItem::SetOpacityTarget(float NewOpacityTarget)
+{
+	OpacityTarget = NewOpacityTarget;
+	StartTransition();
+}
+
+void UW_InventoryItem::SetScaleTarget(float NewScaleTarget)
+{
+	ScaleTarget = NewScaleTarget;
+	StartTransition();
+}
+
+bool UW_InventoryItem::TickTransition(float DeltaTime)
+{
+	const float NewOpacity = FMath::FInterpTo(GetRenderOpacity(), OpacityTarget, DeltaTime, 15.0);
 
 	//Technically scaling the widget like this is bad,
 	//because large items will scale a lot more than small items
-	SetRenderScale(FVector2D(FMath::Vector2DInterpTo(GetRenderTransform().Scale, FVector2D(ScaleTarget), InDeltaTime, 15.0)));
+	const FVector2D NewScale = FMath::Vector2DInterpTo(GetRenderTransform().Scale, FVector2D(ScaleTarget), DeltaTime, 15.0);
+
+	const bool Finished = FMath::IsNearlyEqual(NewOpacity, OpacityTarget, 0.005f) && NewScale.Equals(FVector2D(ScaleTarget), 0.005f);
+	SetRenderOpacity(Finished ? OpacityTarget : NewOpacity);
+	SetRenderScale(Finished ? FVector2D(ScaleTarget) : NewScale);
+	return Finished;
+}
+
+void UW_InventoryItem::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	//The designer might have given the widget a different starting opacity or scale.
+	if(GetRenderOpacity() != OpacityTarget || GetRenderTransform().Scale != FVector2D(ScaleTarget))
+	{
+		StartTransition();
+	}
+}
+
+void UW_InventoryItem::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseEnter(InGeometry, InMouseEvent);
+
+	UAC_Inventory* ParentComponent = ItemID.ParentComponent;
+	if(!IsValid(ParentComponent) || IsDragging)
+	{
+		return;
+	}
+
+	const FS_InventoryItem ItemData = GetItemData();
+	if(ItemData.IsValid() && ParentComponent->GetItemsChildrenContainerIndexes(ItemData).IsValidIndex(0))
+	{
+		ParentComponent->ExpandAttachmentWidget(ItemData);
+	}
+}
+
+void UW_InventoryItem::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseLeave(InMouseEvent);
+
+	if(IsValid(ItemID.ParentComponent))
+	{
+		//Only starts the idle timer if the attachment widget isn't being shown.
+		FS_InventoryItem Item;
+		Item.UniqueID = ItemID;
+		ItemID.ParentComponent->CollapseAttachmentWidget(Item);
+	}
+}
+
+void UW_InventoryItem::StartTransition()
+{
+	if(UInventoryUIAnimationSubsystem* AnimationSubsystem = UInventoryUIAnimationSubsystem::Get(this))
+	{
+		AnimationSubsystem->AnimateItemWidget(this);
+		return;
+	}
+
+	SetRenderOpacity(OpacityTarget);
+	SetRenderScale(FVector2D(ScaleTarget));
 }
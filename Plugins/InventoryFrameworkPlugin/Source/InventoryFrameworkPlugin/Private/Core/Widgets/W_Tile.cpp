@@ -60,6 +60,18 @@ FGameplayTagContainer UW_Tile::GetTileTags()
 	return FGameplayTagContainer();
 }
 
+void UW_Tile::ReleasedToPool_Implementation()
+{
+	TileIndex = -1;
+	ParentContainer = nullptr;
+	IsTileHighlighted = false;
+	HighlightOpacity = 0;
+
+	//Whoever acquires the tile next binds their own events.
+	DragEnter.Clear();
+	DragEnd.Clear();
+}
+
 int32 UW_Tile::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
                            FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
                            bool bParentEnabled) const
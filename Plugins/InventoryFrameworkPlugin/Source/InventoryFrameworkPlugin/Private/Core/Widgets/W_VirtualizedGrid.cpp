@@ -0,0 +1,212 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#include "Core/Widgets/W_VirtualizedGrid.h"
+
+#include "Core/Data/FL_InventoryFramework.h"
+#include "Core/Items/DA_CoreItem.h"
+#include "Core/Widgets/SIFP_VirtualizedGrid.h"
+#include "Core/Widgets/W_Container.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Texture2D.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+#define LOCTEXT_NAMESPACE "InventoryFrameworkPlugin"
+
+
+void UW_VirtualizedGrid::RefreshGrid(UW_Container* Container)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UW_VirtualizedGrid::RefreshGrid)
+
+	if(!IsValid(Container))
+	{
+		return;
+	}
+
+	const FS_ContainerSettings ContainerSettings = Container->GetContainerSettings();
+	if(!ContainerSettings.IsSpacialContainer())
+	{
+		UKismetSystemLibrary::PrintString(this, "Virtualized grids only support spacial containers - UW_VirtualizedGrid::RefreshGrid");
+		return;
+	}
+
+	LastContainer = Container;
+	GridItems.Reset(ContainerSettings.Items.Num());
+	Icons.Reset();
+
+	int32 Columns = 0;
+	int32 Rows = 0;
+	UFL_InventoryFramework::GetContainerDimensions(ContainerSettings, Columns, Rows);
+
+	TArray<FSoftObjectPath> IconsToLoad;
+	TArray<FIFP_GridItemDrawData> DrawData;
+	DrawData.Reserve(ContainerSettings.Items.Num());
+	for(auto& CurrentItem : ContainerSettings.Items)
+	{
+		if(!IsValid(CurrentItem.ItemAsset) || CurrentItem.TileIndex < 0)
+		{
+			continue;
+		}
+
+		FIFP_GridItemDrawData& ItemDrawData = DrawData.AddDefaulted_GetRef();
+		GridItems.Add(CurrentItem);
+
+		UFL_InventoryFramework::IndexToTile(CurrentItem.TileIndex, ContainerSettings, ItemDrawData.Tile.X, ItemDrawData.Tile.Y);
+		UFL_InventoryFramework::GetItemDimensionsWithContext(CurrentItem, ContainerSettings, ItemDrawData.Dimensions.X, ItemDrawData.Dimensions.Y);
+		ItemDrawData.Angle = CurrentItem.Rotation * 90.f;
+		ItemDrawData.Hidden = IsValid(CurrentItem.Widget);
+
+		/**Same fallback as UDA_CoreItem::GetThumbnailTexture, but icons
+		 * that aren't loaded yet are streamed in instead of hitching.*/
+		const TSoftObjectPtr<UTexture2D>& IconPath = CurrentItem.ItemAsset->InventoryImage.IsNull() ? CurrentItem.ItemAsset->DeveloperImage : CurrentItem.ItemAsset->InventoryImage;
+		if(UTexture2D* Icon = IconPath.Get())
+		{
+			ItemDrawData.Icon.SetResourceObject(Icon);
+			Icons.AddUnique(Icon);
+		}
+		else
+		{
+			ItemDrawData.Icon.DrawAs = ESlateBrushDrawType::NoDrawType;
+			if(!IconPath.IsNull())
+			{
+				IconsToLoad.AddUnique(IconPath.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if(IconsToLoad.IsValidIndex(0))
+	{
+		//Refresh again once the missing icons have arrived.
+		TWeakObjectPtr<UW_VirtualizedGrid> WeakThis = this;
+		IconLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(IconsToLoad, [WeakThis]()
+		{
+			if(UW_VirtualizedGrid* Grid = WeakThis.Get())
+			{
+				Grid->RefreshGrid(Grid->LastContainer.Get());
+			}
+		});
+	}
+	else
+	{
+		IconLoadHandle.Reset();
+	}
+
+	if(MyGrid.IsValid())
+	{
+		MyGrid->SetGridSize(FIntPoint(Columns, Rows));
+		MyGrid->SetTileSize(Container->TileSize);
+		MyGrid->SetPadding(Container->TilePadding, Container->ItemPadding);
+		MyGrid->SetTileBrush(Container->UseCustomTileBrush ? Container->CustomTileBrush : TileBrush);
+		MyGrid->SetItems(MoveTemp(DrawData));
+	}
+}
+
+void UW_VirtualizedGrid::SetItemHidden(FS_InventoryItem Item, bool Hidden)
+{
+	const int32 ItemIndex = GridItems.IndexOfByKey(Item);
+	if(MyGrid.IsValid() && ItemIndex != INDEX_NONE)
+	{
+		MyGrid->SetItemHidden(ItemIndex, Hidden);
+	}
+}
+
+void UW_VirtualizedGrid::SetHighlightedTile(int32 TileIndex)
+{
+	if(MyGrid.IsValid())
+	{
+		MyGrid->SetHighlightedTile(TileIndex);
+	}
+}
+
+int32 UW_VirtualizedGrid::GetTileAtAbsolutePosition(FVector2D AbsolutePosition) const
+{
+	if(!MyGrid.IsValid())
+	{
+		return -1;
+	}
+
+	return MyGrid->GetTileAtLocalPosition(MyGrid->GetTickSpaceGeometry().AbsoluteToLocal(AbsolutePosition));
+}
+
+int32 UW_VirtualizedGrid::GetHoveredTile() const
+{
+	return MyGrid.IsValid() ? MyGrid->GetHoveredTile() : -1;
+}
+
+int32 UW_VirtualizedGrid::GetHighlightedTile() const
+{
+	return MyGrid.IsValid() ? MyGrid->GetHighlightedTile() : -1;
+}
+
+FVector2D UW_VirtualizedGrid::GetTileLocalPosition(int32 TileIndex) const
+{
+	return MyGrid.IsValid() ? MyGrid->GetTileLocalPosition(TileIndex) : FVector2D::ZeroVector;
+}
+
+FS_InventoryItem UW_VirtualizedGrid::GetItemAtTile(int32 TileIndex) const
+{
+	if(MyGrid.IsValid())
+	{
+		const int32 ItemIndex = MyGrid->GetItemAtTile(TileIndex);
+		if(GridItems.IsValidIndex(ItemIndex))
+		{
+			return GridItems[ItemIndex];
+		}
+	}
+
+	return FS_InventoryItem();
+}
+
+void UW_VirtualizedGrid::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if(MyGrid.IsValid())
+	{
+		MyGrid->SetHighlightBrush(HighlightBrush);
+		if(!LastContainer.IsValid() || !LastContainer->UseCustomTileBrush)
+		{
+			MyGrid->SetTileBrush(TileBrush);
+		}
+	}
+}
+
+void UW_VirtualizedGrid::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MyGrid.Reset();
+	if(IconLoadHandle.IsValid())
+	{
+		IconLoadHandle->CancelHandle();
+		IconLoadHandle.Reset();
+	}
+}
+
+#if WITH_EDITOR
+const FText UW_VirtualizedGrid::GetPaletteCategory()
+{
+	return LOCTEXT("InventoryFramework", "Inventory Framework");
+}
+#endif
+
+TSharedRef<SWidget> UW_VirtualizedGrid::RebuildWidget()
+{
+	MyGrid = SNew(SIFP_VirtualizedGrid)
+		.OnTileHovered(FOnVirtualizedGridTileHovered::CreateUObject(this, &UW_VirtualizedGrid::HandleTileHovered));
+
+	//The Slate widget was recreated, so push the last state back into it.
+	if(LastContainer.IsValid())
+	{
+		RefreshGrid(LastContainer.Get());
+	}
+
+	return MyGrid.ToSharedRef();
+}
+
+void UW_VirtualizedGrid::HandleTileHovered(int32 TileIndex)
+{
+	TileHovered.Broadcast(TileIndex, GetItemAtTile(TileIndex));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,17 +2,24 @@
 
 #include "InventoryFrameworkPlugin.h"
 
+#include "Core/Data/IFP_MemoryTracking.h"
+#include "Core/Interfaces/IFP_ExternalObjectEvents.h"
+
 #define LOCTEXT_NAMESPACE "FInventoryFrameworkPluginModule"
 
 void FInventoryFrameworkPluginModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	IFP_MemoryTracking::Startup();
+	IFP_ExternalObjectEvents::Startup();
 }
 
 void FInventoryFrameworkPluginModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	IFP_MemoryTracking::Shutdown();
+	IFP_ExternalObjectEvents::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -4,6 +4,7 @@
 #include "LootTableSystem/Objects/O_LootPool.h"
 
 #include "Core/Components/AC_Inventory.h"
+#include "Engine/AssetManager.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "LootTableSystem/Components/AC_LootTable.h"
 #include "LootTableSystem/Data/FL_LootTableHelpers.h"
@@ -87,9 +88,37 @@ void UO_LootPool::AddItemPreInitializeOnly(FS_InventoryItem Item, FS_ContainerSe
 	Item.ContainerIndex = Container.ContainerIndex;
 	Item.ItemIndex = Inventory->ContainerSettings[Container.ContainerIndex].Items.Num();
 	Inventory->ContainerSettings[Container.ContainerIndex].Items.Add(Item);
+	Inventory->MarkContainerDirty(Container.UniqueID);
 	Inventory->QueuedLootTableItems.Add(Item);
 }
 
 void UO_LootPool::PreLoadAssets_Implementation()
 {
+	if(PreLoadHandle.IsValid() && PreLoadHandle->IsLoadingInProgress())
+	{
+		return;
+	}
+	
+	TArray<FSoftObjectPath> AssetsToLoad = GetAssetsToPreLoad();
+	AssetsToLoad.RemoveAll([](const FSoftObjectPath& Path)
+	{
+		return Path.IsNull() || Path.ResolveObject();
+	});
+
+	if(!AssetsToLoad.IsValidIndex(0))
+	{
+		AssetsPreLoaded();
+		return;
+	}
+
+	PreLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+		FStreamableDelegate::CreateWeakLambda(this, [this]()
+		{
+			AssetsPreLoaded();
+		}), PreLoadPriority);
+}
+
+TArray<FSoftObjectPath> UO_LootPool::GetAssetsToPreLoad_Implementation()
+{
+	return TArray<FSoftObjectPath>();
 }
@@ -16,6 +16,8 @@
 #include "Core/Data/IFP_CoreData.h"
 #include "Core/Objects/Parents/O_TagValueCalculation.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
 #include "TimerManager.h"
 #include "Blueprint/UserWidget.h" //Why is this suddenly required in 5.4.3 to package IFP?
 #include "Engine/EngineTypes.h"
@@ -127,6 +129,13 @@ public:
 	UPROPERTY(Category = "Settings", BlueprintReadOnly)
 	TMap<int32, FS_IDMapEntry> ID_Map;
 
+	/**UniqueID's of the containers that have been modified since the last
+	 * call to ConsumeDirtyContainers. Every Internal_ function that modifies
+	 * a container or one of its items adds the container to this list.
+	 * This is what allows incremental saves to only write what has changed.*/
+	UPROPERTY(Category = "Settings", BlueprintReadOnly)
+	TSet<int32> DirtyContainers;
+
 	/**The widget used to present the containers to the player.*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite,Category = "Settings")
 	TSubclassOf<UUserWidget> WidgetClass;
@@ -185,7 +194,11 @@ public:
 	 * To skip generating the same icon over and over,
 	 * this will let two items that share the same data asset
 	 * to share the same render target, if the setting has
-	 * been enabled in the data asset.*/
+	 * been enabled in the data asset.
+	 * Items that UInventoryIconCacheSubsystem can cache are never
+	 * stored here, as the cache packs them into a shared atlas with
+	 * a memory budget. Use FindItemIcon and StoreItemIcon
+	 * instead of reading and writing this map directly.*/
 	UPROPERTY(BlueprintReadWrite, Category = "UI|Icon Generation")
 	TMap<FName, UTextureRenderTarget2D*> GeneratedItemIcons;
 
@@ -203,11 +216,35 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Settings|UI")
 	bool UseDefaultDragDropBehavior = true;
 
+	/**How many seconds a collapsed attachment widget, such as a closed
+	 * backpack, is kept before it and its container widgets are released.
+	 * Expanding the item again before then reuses the widget.
+	 * 0 releases it immediately, negative values never release it.*/
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Settings|UI")
+	float AttachmentWidgetIdleTime = 30;
+
 	/**List of all items from the loot table system that have been added
 	 * and are now waiting to be initialized.
 	 * This is reset after each loot table.*/
 	UPROPERTY(Category = "Loot Table System", BlueprintReadOnly)
 	TArray<FS_InventoryItem> QueuedLootTableItems;
+
+	//--------------------
+	//Streaming settings
+
+	/**Async load priority for item instance classes during @PreLoadItemAssets.
+	 * These are needed first, since StartComponent creates the instances.*/
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Settings|Streaming")
+	int32 ItemInstancePreLoadPriority = FStreamableManager::AsyncLoadHighPriority;
+
+	/**Async load priority for item component classes during @PreLoadItemAssets.*/
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Settings|Streaming")
+	int32 ItemComponentPreLoadPriority = FStreamableManager::DefaultAsyncLoadPriority + 50;
+
+	/**Async load priority for inventory images during @PreLoadItemAssets.
+	 * Items using a generated item icon are skipped.*/
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Settings|Streaming")
+	int32 ItemIconPreLoadPriority = FStreamableManager::DefaultAsyncLoadPriority;
 	
 	//--------------------
 	//Input settings
@@ -274,10 +311,64 @@ private:
 	//Used for functions using the FS_ItemSubLevel struct.
 	int32 CurrentSubLevel = -1;
 
+	/**Handles for the assets requested by PreLoadItemAssets.
+	 * Holding onto these keeps the assets resident for as long
+	 * as this component is alive.*/
+	TArray<TSharedPtr<FStreamableHandle>> PreLoadHandles;
+
+	/**Items whose item instance class was still streaming in
+	 * during StartComponent. Their instances get created once
+	 * the item instance classes have finished loading.*/
+	TArray<FS_UniqueID> DeferredItemInstances;
+
+	/**StartComponent deferred item instances, ComponentStarted
+	 * is broadcast once OnItemInstancesPreLoaded creates them.*/
+	bool WaitingForItemInstances = false;
+
+	/**Broadcast StartMultithreadWork, the equip status of equipped
+	 * items and ComponentStarted, and notify the loot tables.*/
+	void FinishStartComponent();
+
+	struct FItemPlacementTable
+	{
+		TArray<FIFP_ItemPlacement> Placements;
+		//Bumped every time the container is marked dirty.
+		uint32 Version = 1;
+		//The Version the placements were built from.
+		uint32 BuiltVersion = 0;
+		//The container the placements were built from, in case containers got shuffled.
+		int32 ContainerIdentity = 0;
+	};
+
+	//Indexed by ContainerIndex, see GetItemPlacements
+	TArray<FItemPlacementTable> ItemPlacementTables;
+
+	/**Resolve the index of the container with the @ContainerID in this component,
+	 * through the ID map if it is up to date. Returns INDEX_NONE if not found.*/
+	int32 FindContainerIndex(FS_UniqueID ContainerID) const;
+
+	/**Collapsed attachment widgets waiting for AttachmentWidgetIdleTime,
+	 * keyed by the identity number of the item owning them.
+	 * Uses the core ticker so widgets are released while paused.*/
+	TMap<int32, FTSTicker::FDelegateHandle> AttachmentReleaseHandles;
+
+	void CancelAttachmentRelease(int32 ItemIdentityNumber);
+
+	/**Item instance classes have finished loading, create
+	 * the instances that StartComponent had to skip.*/
+	void OnItemInstancesPreLoaded();
+
+	/**The traits component class is not loaded yet. Request it
+	 * and call GetItemComponent again once it is ready.*/
+	void RequestItemComponentClass(FS_InventoryItem Item, UIT_ItemComponentTrait* Trait, AActor* Instigator, FGameplayTag Event, FItemComponentPayload Payload);
+
 #pragma region Delegates
 
 public:
 
+	/**Called once StartComponent has finished and every item has its item instance.
+	 * If item instance classes had to be streamed in, this is called
+	 * once they have loaded instead of during StartComponent.*/
 	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category = "EventDispatchers")
 	FComponentStarted ComponentStarted;
 
@@ -387,8 +478,8 @@ public:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category = "EventDispatchers")
 	FServerInventoryDataReceived ServerInventoryDataReceived;
 
-	/**Delegate used primarily for the ItemQuery system. This is called during StartComponent
-	 * BEFORE all items have their ItemEquipped delegate called. Because of how expensive
+	/**Delegate used primarily for the ItemQuery system. This is called right before ComponentStarted
+	 * and BEFORE all items have their ItemEquipped delegate called. Because of how expensive
 	 * blueprints and components are to create, this is the ideal moment to start any
 	 * foreground thread work. The primary example is O_ItemQueryBase -> OnInventoryStarted
 	 * 
@@ -427,6 +518,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Management")
 	void StartComponent(bool RemoveSkipValidationTags = false);
 
+	/**Collect the soft references this component is going to need (item instance
+	 * classes, item component classes and inventory images) and start loading them
+	 * asynchronously, each group with its own priority.
+	 * This is called by StartComponent, but can be called again after a large
+	 * amount of items have been added. Already loaded assets are skipped.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	void PreLoadItemAssets();
+
+	/**Returns true while any of the assets requested by PreLoadItemAssets are still loading.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Management")
+	bool IsPreLoadingItemAssets() const;
+
+	/**Returns true if this items instance is waiting for its class to finish loading.*/
+	bool IsItemInstanceDeferred(FS_UniqueID UniqueID) const;
+
 	/**This should be called whenever you add or reorganize ContainerSettings.
 	 * This will update all containers ContainerIndex's and widgets if valid.
 	 * If a container doesn't have a valid UniqueID, this will also generate one.
@@ -475,6 +581,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Management")
 	TArray<FS_ContainerSettings> GetContainersForSaveState();
 
+	/**Same as GetContainersForSaveState, but for a single container.
+	 * Used by incremental saves that only write the containers that changed.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	FS_ContainerSettings GetContainerForSaveState(const FS_ContainerSettings& Container);
+
 	UFUNCTION(BlueprintCallable, Category = "Management", meta = (DisplayName = "Reset All Unique ID's"))
 	void ResetAllUniqueIDs();
 
@@ -525,6 +636,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Management")
 	void BroadcastNewAssignedUniqueID(FS_UniqueID OldID, FS_UniqueID NewID);
 
+	/**Flag a container as modified, so the next incremental save writes it.
+	 * The Internal_ functions already call this, you only need this if you
+	 * are modifying the ContainerSettings directly.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	void MarkContainerDirty(FS_UniqueID ContainerID);
+
+	/**Flag every container in this component as modified.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	void MarkAllContainersDirty();
+
+	/**Returns the dirty containers and clears the list.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	TSet<int32> ConsumeDirtyContainers();
+
+	/**Flag the container the @Item is inside of as modified.
+	 * The item can belong to any component.*/
+	static void MarkItemsContainerDirty(const FS_InventoryItem& Item);
+
+	/**Flag the container at @ContainerIndex in this component as modified.*/
+	void MarkContainerIndexDirty(int32 ContainerIndex);
+
+	/**Get the hot data of every item in a container, in the same order as its Items.
+	 * This is rebuilt lazily whenever a container has been modified, so scanning
+	 * this instead of the Items array is only worth it for read-only queries.
+	 * The returned array is only valid until the component is modified.
+	 * Writes to the ContainerSettings that don't go through MarkContainerDirty,
+	 * such as from blueprints, are not picked up. Only use this where the
+	 * component is known to be modified through its own functions.*/
+	const TArray<FIFP_ItemPlacement>& GetItemPlacements(int32 ContainerIndex);
+
+	/**Throw away every item placement table. Only needed if you
+	 * assign the ContainerSettings directly.*/
+	void InvalidateItemPlacements();
+
+	/**Compare memory use and scan speed of the Items arrays against
+	 * the item placement tables and print the results.*/
+	UFUNCTION(BlueprintCallable, Category = "Management", meta = (DevelopmentOnly))
+	void BenchmarkItemPlacements(UDA_CoreItem* ItemAsset, int32 Iterations = 100);
+
+	/**Count how many bytes this component is using, split by what is using them.
+	 * Objects are counted by their own size, item instances and item components
+	 * that are shared between components are counted once per component.
+	 * Also see the IFP.DumpInventoryMemory console command.*/
+	UFUNCTION(BlueprintCallable, Category = "Management")
+	FS_InventoryMemoryReport GetMemoryReport();
+
 #pragma endregion
 	
 
@@ -653,6 +810,38 @@ public:
 	 * and assign it to the struct.*/
 	UFUNCTION(BlueprintCallable, Category = "Items")
 	UW_AttachmentParent* CreateAttachmentWidgetForItem(FS_InventoryItem Item, bool ResetData, bool DoNotBind, TArray<FS_ContainerSettings>& AddedContainers);
+
+	/**Returns the attachment widget of the @Item, creating it and its container
+	 * widgets the first time the item is expanded, or if it has been released since.
+	 * Call this when an item is opened or hovered instead of creating
+	 * attachment widgets for every item when the inventory is constructed.
+	 * Use GetItemsChildrenContainerIndexes to find out if an item can be expanded.*/
+	UFUNCTION(BlueprintCallable, Category = "Items|Attachments")
+	UW_AttachmentParent* ExpandAttachmentWidget(FS_InventoryItem Item);
+
+	/**Call when the attachment widget of the @Item is no longer shown.
+	 * It is released to the widget pool after AttachmentWidgetIdleTime, unless
+	 * it's expanded again. Widgets that are still on screen are left alone.*/
+	UFUNCTION(BlueprintCallable, Category = "Items|Attachments")
+	void CollapseAttachmentWidget(FS_InventoryItem Item);
+
+	/**Release the attachment widget of the @Item and its container widgets now.
+	 * Expanded attachment widgets of the items inside are released first.*/
+	UFUNCTION(BlueprintCallable, Category = "Items|Attachments")
+	void ReleaseAttachmentWidget(FS_InventoryItem Item);
+
+	/**Call before generating the icon of an item.
+	 * Returns true if the @ItemAsset already has an icon, either from
+	 * UInventoryIconCacheSubsystem or from GeneratedItemIcons.*/
+	UFUNCTION(BlueprintCallable, Category = "UI|Icon Generation")
+	bool FindItemIcon(UDA_CoreItem* ItemAsset, FSlateBrush& Icon);
+
+	/**Call once the icon of an item has been captured into the @RenderTarget.
+	 * Items the icon cache supports are copied into its atlas and the
+	 * @RenderTarget can be released. Other items that have OptimizeIconCreation
+	 * enabled keep the @RenderTarget in GeneratedItemIcons.*/
+	UFUNCTION(BlueprintCallable, Category = "UI|Icon Generation")
+	void StoreItemIcon(UDA_CoreItem* ItemAsset, UTextureRenderTarget2D* RenderTarget, FSlateBrush& Icon);
 	
 	/**Attempt to add an uninitialized item to this component.
 	 * This also stacks the item with other items if possible.
@@ -865,7 +1054,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Items")
 	UItemComponent* GetItemComponent(FS_InventoryItem Item, UIT_ItemComponentTrait* Trait, bool CreateComponent, AActor* Instigator = nullptr, FGameplayTag Event = FGameplayTag(), FItemComponentPayload Payload = FItemComponentPayload());
 
-	/**Creates and binds the item item instance to this item struct.*/
+	/**Creates and binds the item item instance to this item struct.
+	 * If the item instance class hasn't been streamed in by PreLoadItemAssets
+	 * yet, it is loaded synchronously since the instance is returned immediately.*/
 	UFUNCTION(BlueprintCallable, Category = "Items")
 	UItemInstance* CreateItemInstanceForItem(UPARAM(ref) FS_InventoryItem& Item);
 
@@ -1200,6 +1391,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Getters", meta = (ReturnDisplayName = "Containers"))
 	TArray<FS_ContainerSettings> GetItemsChildrenContainers(FS_InventoryItem Item);
 
+	/**Same as GetItemsChildrenContainers, but returns the container
+	 * indexes instead of copies of the containers.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Getters", meta = (ReturnDisplayName = "ContainerIndexes"))
+	TArray<int32> GetItemsChildrenContainerIndexes(FS_InventoryItem Item);
+
 	/**Gets the widget version of a container.
 	 * You can also use this to find out if a widget has been created
 	 * for a container by checking if @Widget is valid.*/
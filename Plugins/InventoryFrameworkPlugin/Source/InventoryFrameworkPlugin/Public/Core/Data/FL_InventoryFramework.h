@@ -305,7 +305,7 @@ class INVENTORYFRAMEWORKPLUGIN_API UFL_InventoryFramework : public UBlueprintFun
 	/**Get the tag values on the item. Optionally append the items asset tag values
 	 * to retrieve all the tag values this item has.*/
 	UFUNCTION(Category = "IFP|Items|Tags", BlueprintCallable, BlueprintPure)
-	static TArray<FS_TagValue> GetItemsTagValues(FS_InventoryItem Item, const bool IncludeAssetTagValues = true);
+	static TArray<FS_TagValue> GetItemsTagValues(const FS_InventoryItem& Item, const bool IncludeAssetTagValues = true);
 
 	/**Takes in a @Container and returns the item that owns it, if any.
 	 * Remember to check if returned item is valid.*/
@@ -316,7 +316,9 @@ class INVENTORYFRAMEWORKPLUGIN_API UFL_InventoryFramework : public UBlueprintFun
 	 * can be created when requested.
 	 * @DoNotConstruct if true, this will simply ignore the @ConstructOnRequest boolean in the
 	 * item instances class defaults and never create an object, simply fetching an object
-	 * if one exists.*/
+	 * if one exists.
+	 * Constructing loads the item instance class synchronously if
+	 * PreLoadItemAssets hasn't finished streaming it in yet.*/
 	UFUNCTION(Category = "IFP|Items", BlueprintCallable, BlueprintPure)
 	static UItemInstance* GetItemsInstance(FS_InventoryItem Item, bool DoNotConstruct);
 
@@ -491,15 +493,15 @@ class INVENTORYFRAMEWORKPLUGIN_API UFL_InventoryFramework : public UBlueprintFun
 	/**Check if the @Tag can be found in the @TagValues array.
 	 * @ArrayIndex returns -1 if not found.*/
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "IFP|Tags|Checkers")
-	static bool DoesTagValuesHaveTag(TArray<FS_TagValue> TagValues, FGameplayTag Tag, FS_TagValue& FoundTagValue, int32& TagIndex);
+	static bool DoesTagValuesHaveTag(const TArray<FS_TagValue>& TagValues, FGameplayTag Tag, FS_TagValue& FoundTagValue, int32& TagIndex);
 
 	/**Get the value associated with a specified @Tag inside of @TagValues*/
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "IFP|Tags|Checkers")
-	static float GetValueForTag(TArray<FS_TagValue> TagValues, FGameplayTag Tag, FS_TagValue& FoundTagValue, bool& TagFound);
+	static float GetValueForTag(const TArray<FS_TagValue>& TagValues, FGameplayTag Tag, FS_TagValue& FoundTagValue, bool& TagFound);
 
 	/**Strips out the values and wraps all the tags into a tag container.*/
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "IFP|Tags")
-	static FGameplayTagContainer ConvertTagValuesToTagContainer(TArray<FS_TagValue> TagValues);
+	static FGameplayTagContainer ConvertTagValuesToTagContainer(const TArray<FS_TagValue>& TagValues);
 
 	/**Get the children of a specified tag.
 	 * I don't know why this is not a base Unreal Engine function
@@ -0,0 +1,77 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+
+struct FItemInstanceRecord;
+
+/**Versions of the binary container format.
+ * Add new versions above VersionPlusOne, never reorder or remove them.*/
+namespace EIFP_ContainerFormatVersion
+{
+	enum Type : uint16
+	{
+		Initial = 1,
+		//Item instance records store the UniqueID of their item.
+		InstanceRecordItemID,
+
+		//-----<new versions can be added above this line>-----
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+}
+
+/**Native binary format for the containers of an inventory component.
+ * This is a lot smaller and faster than pushing the ContainerSettings
+ * through the generic SaveGame property serialization, which writes
+ * the name and type of every property for every item.
+ *
+ * Layout:
+ * - Header: magic number, version and flags.
+ * - Asset table: every asset the containers reference (item assets,
+ * item instance classes, images, currencies), written once.
+ * - Tag table: every gameplay tag the containers reference, written once.
+ * - Containers: packed container and item records that reference
+ * the tables by index.
+ * - Item instances: the bulk SaveGame payload of every item instance.
+ *
+ * Loading resolves each table entry once, then reads the containers
+ * in a single pass without using property reflection per item.
+ * The TileMap is written as a single block. IndexCoordinates is not
+ * written, it is rebuilt from the dimensions.
+ *
+ * Assets that aren't loaded yet are loaded synchronously while reading.
+ * Use GetAssetPaths to stream them in beforehand.*/
+class INVENTORYFRAMEWORKPLUGIN_API FIFP_ContainerSerializer
+{
+public:
+
+	static constexpr uint32 Magic = 0x43504649; //"IFPC"
+
+	/**Write the @Containers and the @InstanceRecords into @OutData.
+	 * The containers are expected to be in save state, see
+	 * UAC_Inventory::GetContainersForSaveState
+	 * To write off the game thread, pass the @AssetPaths gathered by
+	 * GatherAssetPaths, so no object is asked for its path there.*/
+	static void WriteContainers(const TArray<FS_ContainerSettings>& Containers, const TArray<FItemInstanceRecord>& InstanceRecords, TArray<uint8>& OutData,
+		const TMap<const UObject*, FSoftObjectPath>* AssetPaths = nullptr);
+
+	/**Resolve the path of every asset the @Containers and @InstanceRecords reference.
+	 * Must be called on the game thread.*/
+	static void GatherAssetPaths(const TArray<FS_ContainerSettings>& Containers, const TArray<FItemInstanceRecord>& InstanceRecords,
+		TMap<const UObject*, FSoftObjectPath>& OutAssetPaths);
+
+	/**Read containers written by WriteContainers. Returns false if
+	 * the data is not in this format or is from a newer version.*/
+	static bool ReadContainers(const TArray<uint8>& Data, TArray<FS_ContainerSettings>& OutContainers, TArray<FItemInstanceRecord>& OutInstanceRecords);
+
+	/**Get every asset the @Data references, so they can be streamed
+	 * in before calling ReadContainers. Returns false if the data
+	 * is not in this format or is from a newer version.*/
+	static bool GetAssetPaths(const TArray<uint8>& Data, TArray<FSoftObjectPath>& OutAssetPaths);
+
+	/**Returns the version the @Data was written with, or 0 if it isn't in this format.*/
+	static uint16 GetVersion(const TArray<uint8>& Data);
+};
@@ -473,10 +473,19 @@ struct FS_InventoryItem
 		return true;
 	}
 
+	/**Bytes this item has allocated on the heap, not including the struct itself.*/
+	int32 GetAllocatedSize() const
+	{
+		return Tags.GetGameplayTagArray().GetAllocatedSize() + TagValues.GetAllocatedSize()
+		+ OverrideSettings.AcceptedCurrenciesOverwrite.GetAllocatedSize() + ItemComponents.GetAllocatedSize()
+		+ ExternalObjects.GetAllocatedSize();
+	}
+
+	/**Bytes this item takes up, including its heap allocations.
+	 * This does not include the objects it references, such as the item instance.*/
 	int32 GetMemorySize() const
 	{
-		return sizeof(this) + sizeof(OverrideSettings) + Tags.GetGameplayTagArray().GetAllocatedSize() + TagValues.GetAllocatedSize()
-		+ ItemComponents.GetAllocatedSize() + ExternalObjects.GetAllocatedSize() + sizeof(UniqueID) + sizeof(RandomMinMaxCount);
+		return sizeof(FS_InventoryItem) + GetAllocatedSize();
 	}
 
 	UAC_Inventory* ParentComponent() const
@@ -485,6 +494,22 @@ struct FS_InventoryItem
 	}
 };
 
+/**Compact copy of the fields of FS_InventoryItem that are read when
+ * scanning a container, such as counting or finding items by asset.
+ * FS_InventoryItem is several hundred bytes, mostly arrays, widgets and
+ * override settings that a scan never reads. Keeping these in their own
+ * contiguous array lets a scan stay in cache.
+ * See UAC_Inventory::GetItemPlacements*/
+struct FIFP_ItemPlacement
+{
+	UDA_CoreItem* ItemAsset = nullptr;
+	int32 IdentityNumber = 0;
+	int32 ItemIndex = -1;
+	int32 TileIndex = -1;
+	int32 Count = 0;
+	TEnumAsByte<ERotation> Rotation = Zero;
+};
+
 //Settings for what is allowed in a container.
 USTRUCT(BlueprintType)
 struct FS_CompatibilitySettings
@@ -514,10 +539,11 @@ struct FS_CompatibilitySettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Compatibility")
 	TArray<UDA_CoreItem*> ItemBlacklist;
 
+	//Only the heap allocations, this struct is always a member of a container.
 	int32 GetMemorySize() const
 	{
 		return RequiredTags.GetGameplayTagArray().GetAllocatedSize() + BlockingTags.GetGameplayTagArray().GetAllocatedSize()
-		 + ItemWhitelist.GetAllocatedSize() + ItemBlacklist.GetAllocatedSize();
+		 + ItemTagTypes.GetGameplayTagArray().GetAllocatedSize() + ItemWhitelist.GetAllocatedSize() + ItemBlacklist.GetAllocatedSize();
 	}
 };
 
@@ -786,19 +812,38 @@ struct FS_ContainerSettings
 		return true;
 	}
 
-	int32 GetMemorySize(bool IncludeItemArray) const
+	//Bytes the TileMap, IndexCoordinates and TileTags have allocated.
+	int32 GetTileMapAllocatedSize() const
+	{
+		int32 TileTagsSize = TileTags.GetAllocatedSize();
+		for(auto& CurrentTileTag : TileTags)
+		{
+			TileTagsSize += CurrentTileTag.Tags.GetGameplayTagArray().GetAllocatedSize();
+		}
+		return TileMap.GetAllocatedSize() + IndexCoordinates.GetAllocatedSize() + TileTagsSize;
+	}
+
+	/**Bytes this container has allocated on the heap, not including the struct itself.
+	 * If @IncludeItemArray is true, this includes the Items array and every items allocations.*/
+	int32 GetAllocatedSize(bool IncludeItemArray) const
 	{
 		int32 ItemArraySize = 0;
 		if(IncludeItemArray)
 		{
+			ItemArraySize = Items.GetAllocatedSize();
 			for(auto& CurrentItem : Items)
 			{
-				ItemArraySize += CurrentItem.GetMemorySize();
+				ItemArraySize += CurrentItem.GetAllocatedSize();
 			}
 		}
-		return sizeof(this) + sizeof(Dimensions) + Tags.GetGameplayTagArray().GetAllocatedSize() + TagValues.GetAllocatedSize()
-		+ CompatibilitySettings.GetMemorySize() + TileTags.GetAllocatedSize() + sizeof(BelongsToItem) + ItemArraySize + TileMap.GetAllocatedSize()
-		+ IndexCoordinates.GetAllocatedSize() + sizeof(UniqueID) + ExternalObjects.GetAllocatedSize();
+		return Tags.GetGameplayTagArray().GetAllocatedSize() + TagValues.GetAllocatedSize() + CompatibilitySettings.GetMemorySize()
+		+ GetTileMapAllocatedSize() + ExternalObjects.GetAllocatedSize() + ItemArraySize;
+	}
+
+	/**Bytes this container takes up, including its heap allocations.*/
+	int32 GetMemorySize(bool IncludeItemArray) const
+	{
+		return sizeof(FS_ContainerSettings) + GetAllocatedSize(IncludeItemArray);
 	}
 
 	UAC_Inventory* ParentComponent() const
@@ -1076,4 +1121,59 @@ struct FRotationAndShape
 	}
 };
 
+/**How many bytes an inventory component is using, split by what is using them.
+ * See UAC_Inventory::GetMemoryReport*/
+USTRUCT(BlueprintType)
+struct FS_InventoryMemoryReport
+{
+	GENERATED_BODY()
+
+	//Container structs and their tags, tag values and settings.
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 Containers = 0;
+
+	//Item structs, their allocations and the item placement tables.
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 Items = 0;
+
+	//TileMap, IndexCoordinates and TileTags of every container.
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 TileMaps = 0;
+
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 IDMap = 0;
+
+	//Container and item widgets. Only the UObjects, not their Slate widgets.
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 Widgets = 0;
+
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 ItemInstances = 0;
+
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 ItemComponents = 0;
+
+	//Generated icon render targets, including their texture memory.
+	UPROPERTY(Category = "Memory", VisibleAnywhere, BlueprintReadOnly)
+	int64 Icons = 0;
+
+	int64 GetTotal() const
+	{
+		return Containers + Items + TileMaps + IDMap + Widgets + ItemInstances + ItemComponents + Icons;
+	}
+
+	FS_InventoryMemoryReport& operator+=(const FS_InventoryMemoryReport& Other)
+	{
+		Containers += Other.Containers;
+		Items += Other.Items;
+		TileMaps += Other.TileMaps;
+		IDMap += Other.IDMap;
+		Widgets += Other.Widgets;
+		ItemInstances += Other.ItemInstances;
+		ItemComponents += Other.ItemComponents;
+		Icons += Other.Icons;
+		return *this;
+	}
+};
+
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,51 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+
+/**Memory tracking for the inventory framework.
+ *
+ * - Allocations made while starting components, adding items and creating
+ * item instances are tagged with the InventoryFramework LLM tag.
+ * Run with -llm and use "stat LLMFULL" or an LLM csv to see them.
+ * - "stat InventoryFramework" shows the totals of every inventory
+ * component, split the same way as UAC_Inventory::GetMemoryReport.
+ * - "IFP.DumpInventoryMemory [Count]" prints the components using the most memory.
+ * - The same stat group shows the hit rate of the widget pools
+ * and the size of the icon atlas.*/
+
+LLM_DECLARE_TAG_API(InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+
+DECLARE_STATS_GROUP(TEXT("InventoryFramework"), STATGROUP_InventoryFramework, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Inventory Components"), STAT_IFP_Components, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Items"), STAT_IFP_ItemCount, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Containers"), STAT_IFP_ContainersMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Items"), STAT_IFP_ItemsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Tile Maps"), STAT_IFP_TileMapsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("ID Maps"), STAT_IFP_IDMapsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Widgets"), STAT_IFP_WidgetsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Item Instances"), STAT_IFP_ItemInstancesMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Item Components"), STAT_IFP_ItemComponentsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Icons"), STAT_IFP_IconsMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+
+//Updated by UInventoryWidgetPoolSubsystem.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Widget Pool Hits"), STAT_IFP_WidgetPoolHits, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Widget Pool Misses"), STAT_IFP_WidgetPoolMisses, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Widgets"), STAT_IFP_PooledWidgets, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Widget Pool Hit Rate %"), STAT_IFP_WidgetPoolHitRate, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+
+//Updated by UInventoryIconCacheSubsystem.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached Icons"), STAT_IFP_CachedIcons, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Icon Atlas"), STAT_IFP_IconAtlasMemory, STATGROUP_InventoryFramework, INVENTORYFRAMEWORKPLUGIN_API);
+
+namespace IFP_MemoryTracking
+{
+	/**Start updating the InventoryFramework stat group. Called by the module.*/
+	void Startup();
+
+	void Shutdown();
+}
@@ -8,6 +8,7 @@
 #include "SG_InventorySerialization.generated.h"
 
 struct FS_InventoryItem;
+class UAC_Inventory;
 class UItemInstance;
 
 class INVENTORYFRAMEWORKPLUGIN_API FSaveGameArchive : public FObjectAndNameAsStringProxyArchive
@@ -35,6 +36,11 @@ public:
 	UPROPERTY()
 	int32 ItemIndex = -1;
 
+	/**The UniqueID of the item this object belonged to.
+	 * Records from saves made before this was added are 0.*/
+	UPROPERTY()
+	int32 ItemID = 0;
+
 	UPROPERTY()
 	UClass* ObjectClass = nullptr;
 
@@ -43,28 +49,91 @@ public:
 	TArray<uint8> PropertyData;
 };
 
+/**The containers of a single actor, written in the
+ * binary format of FIFP_ContainerSerializer.*/
+USTRUCT(BlueprintType)
+struct FContainerRecord
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	TArray<uint8> Data;
+};
+
 /**Save game class that helps with serializing the ContainerSettings in an
  * inventory component.
- * This is only needed for serializing item instances.
+ * This is only needed for serializing item instances, or if you want to
+ * use the binary container format through SaveContainersForActor.
  * This class needs to be somewhere in your hierarchy for your save game class.*/
 UCLASS()
 class INVENTORYFRAMEWORKPLUGIN_API USG_InventorySerialization : public USaveGame
 {
 	GENERATED_BODY()
 
-	//The records of all the item instances
+	/**The records of all the item instances from older saves.
+	 * New records go into ItemInstanceRecordsByID, this is only
+	 * still read so existing saves keep loading.*/
 	UPROPERTY()
 	TArray<FItemInstanceRecord> ItemInstanceRecords;
 
+	//The records of all the item instances, keyed by the UniqueID of their item.
+	UPROPERTY()
+	TMap<int32, FItemInstanceRecord> ItemInstanceRecordsByID;
+
+	/**ContainerIndex and ItemIndex -> index in ItemInstanceRecords.
+	 * Built the first time a legacy record is looked up.*/
+	TMap<FIntPoint, int32> LegacyRecordLookup;
+
+	//Binary container records, keyed by the actors name.
+	UPROPERTY()
+	TMap<FString, FContainerRecord> ContainerRecords;
+
 	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void SaveItemInstance(UItemInstance* ItemInstance);
 
 	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void LoadItemInstance(FS_InventoryItem Item);
 
-	UFUNCTION(Category = "IFP Serialization")
+	/**Restore the item instance of every item in the @Inventory in a single pass.
+	 * This is a lot faster than calling LoadItemInstance for every item.
+	 * Items whose instance is constructed on request will have it constructed.
+	 * Returns how many item instances were restored.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	int32 LoadAllItemInstances(UAC_Inventory* Inventory);
+
+	const FItemInstanceRecord* FindItemInstanceRecord(const FS_InventoryItem& Item);
+
+public:
+
+	/**Write the actors containers and item instances into this save
+	 * using the compact binary format of FIFP_ContainerSerializer.
+	 * This is a lot smaller and faster than saving the result of
+	 * GetContainersForSaveState as a SaveGame property.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void SaveContainersForActor(AActor* Actor);
 
-	UFUNCTION(Category = "IFP Serialization")
+	/**Restore the containers saved with SaveContainersForActor.
+	 * This must be called before the inventory component has been
+	 * started, as it will start the component and then restore
+	 * the item instances.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
 	void LoadContainersForActor(AActor* Actor);
+
+	/**Time saving and loading the @Inventory through the binary format
+	 * against the generic SaveGame property serialization and print the results.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, meta = (DevelopmentOnly))
+	static void BenchmarkContainerSerialization(UAC_Inventory* Inventory, int32 Iterations = 10);
+
+	/**Assign the @Containers to the @Inventory, start it and deserialize the
+	 * @InstanceRecords into the items instances. The component must not be started.*/
+	static void RestoreContainers(UAC_Inventory* Inventory, const TArray<FS_ContainerSettings>& Containers, const TArray<FItemInstanceRecord>& InstanceRecords);
+
+	/**Serialize the SaveGame properties of the @ItemInstance into a record.*/
+	static FItemInstanceRecord CreateItemInstanceRecord(UItemInstance* ItemInstance);
+
+private:
+
+	static UAC_Inventory* GetInventoryFromActor(AActor* Actor);
 };
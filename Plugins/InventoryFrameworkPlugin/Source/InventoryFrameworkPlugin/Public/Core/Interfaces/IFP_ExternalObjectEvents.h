@@ -0,0 +1,90 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+
+class UTexture;
+
+/**Item events sent to external objects through UFL_ExternalObjects.
+ * Only events that describe the current state of an item are here.
+ * Tag, tag value and equip events carry the individual change
+ * and are always delivered immediately.*/
+enum class EIFP_ExternalObjectEvent : uint8
+{
+	ItemCount,
+	Location,
+	Size,
+	Rotation,
+	Rarity,
+	Image,
+	Name,
+	Icon,
+	Affordability,
+	OverrideSettings,
+	BackgroundColor,
+	WidgetSelection
+};
+
+struct FIFP_ExternalObjectEvent
+{
+	EIFP_ExternalObjectEvent Type = EIFP_ExternalObjectEvent::Location;
+
+	//ItemCount
+	int32 OldValue = 0;
+	int32 NewValue = 0;
+
+	//Icon
+	TWeakObjectPtr<UTexture> Texture;
+
+	//Affordability, BackgroundColor (IsTemporary), WidgetSelection
+	bool Flag = false;
+
+	//BackgroundColor
+	FLinearColor Color = FLinearColor::White;
+
+	//OverrideSettings
+	FS_ItemOverwriteSettings OldOverride;
+	FS_ItemOverwriteSettings NewOverride;
+
+	FIFP_ExternalObjectEvent() {}
+
+	explicit FIFP_ExternalObjectEvent(EIFP_ExternalObjectEvent InType)
+		: Type(InType)
+	{}
+};
+
+/**Coalesces the item events of UFL_ExternalObjects.
+ *
+ * A sort or a bulk add can fire hundreds of events for the same items,
+ * each of which gathers every widget, item instance and item component of
+ * the item. Instead, events are queued during the frame and delivered once
+ * at the end of it, one per item and event type:
+ * - ItemCount keeps the first old value and the last new value.
+ * - OverrideSettings keeps the first old override and the last new one.
+ * - Every other event keeps its latest values.
+ *
+ * Objects for an item are gathered once per flush, and whether a class
+ * implements I_ExternalObjects is cached instead of being looked up
+ * for every object and event.
+ *
+ * "IFP.ExternalObjects.DeferEvents 0" delivers every event immediately.*/
+namespace IFP_ExternalObjectEvents
+{
+	/**Queue or, if deferring is disabled, immediately deliver the @Event for the @Item.*/
+	INVENTORYFRAMEWORKPLUGIN_API void QueueItemEvent(const FS_InventoryItem& Item, const FIFP_ExternalObjectEvent& Event);
+
+	/**Deliver every queued event now.*/
+	INVENTORYFRAMEWORKPLUGIN_API void Flush();
+
+	INVENTORYFRAMEWORKPLUGIN_API int32 GetQueuedEventCount();
+
+	/**Cached per class version of ImplementsInterface(UI_ExternalObjects::StaticClass()).*/
+	INVENTORYFRAMEWORKPLUGIN_API bool ImplementsExternalObjects(const UObject* Object);
+
+	/**Start flushing at the end of every frame. Called by the module.*/
+	void Startup();
+
+	void Shutdown();
+}
@@ -113,6 +113,11 @@ public:
 	void ItemDestroyed(FS_InventoryItem Item);
 };
 
+/**Item state events (count, location, size, rotation, rarity, image, name, icon,
+ * affordability, override settings, background color and widget selection)
+ * are queued and delivered once at the end of the frame, one per item and event.
+ * Tag, tag value and equip events are delivered immediately.
+ * See IFP_ExternalObjectEvents.h.*/
 UCLASS()
 class UFL_ExternalObjects : public UBlueprintFunctionLibrary
 {
@@ -120,6 +125,12 @@ class UFL_ExternalObjects : public UBlueprintFunctionLibrary
 
 public:
 
+	/**Deliver every queued item event right now instead of at
+	 * the end of the frame. Useful when a widget needs to be
+	 * up to date before it is drawn or read from this frame.*/
+	UFUNCTION(BlueprintCallable, Category = "IFP|External Objects")
+	static void FlushQueuedEvents();
+
 	UFUNCTION(BlueprintCallable, Category = "IFP|External Objects")
 	static void BroadcastItemCountUpdated(FS_InventoryItem Item, int32 OldValue, int32 NewValue);
 
@@ -0,0 +1,37 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "I_PooledWidget.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI)
+class UI_PooledWidget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**Reset hooks for widgets that are reused through the UInventoryWidgetPoolSubsystem.
+ * Widgets that don't implement this are still pooled, they just
+ * keep whatever state they had when they were released.*/
+class INVENTORYFRAMEWORKPLUGIN_API II_PooledWidget
+{
+	GENERATED_BODY()
+
+	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
+public:
+
+	/**The widget was handed out by the pool. Construct is
+	 * still called once the widget is added to a parent.*/
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Pooling")
+	void AcquiredFromPool();
+
+	/**The widget was removed from its parent and returned to the pool.
+	 * Clear any references to items, containers and components here,
+	 * so the widget doesn't keep them alive while it's waiting.*/
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Pooling")
+	void ReleasedToPool();
+};
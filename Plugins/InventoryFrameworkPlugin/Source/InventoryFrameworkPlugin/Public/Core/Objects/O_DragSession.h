@@ -0,0 +1,139 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "O_DragSession.generated.h"
+
+class UAC_Inventory;
+
+/**Caches where the item being dragged can be placed.
+ *
+ * While dragging, the highlight is updated on every mouse move, and
+ * CheckAllRotationsForSpace copies the container and walks the items
+ * shape for every rotation each time, even when the hovered tile hasn't changed.
+ * Instead, the first time a container is hovered, the session works out
+ * for every tile and rotation whether the item fits there, using the
+ * containers current TileMap. Every check after that is an array lookup.
+ *
+ * A container is only recalculated if an item is added, removed or moved
+ * in it, or if it is resized while the drag is in progress.
+ *
+ * This only answers whether the item fits. Stacking, combining and swapping
+ * still need the items in the way, so when a tile is blocked, call
+ * CheckForSpace on the component to find out what is blocking it.
+ *
+ * The active drag widget owns a session, see UW_Drag::GetDragSession.*/
+UCLASS(BlueprintType)
+class INVENTORYFRAMEWORKPLUGIN_API UO_DragSession : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**Start a session for the @Item. The container the item is
+	 * currently in is calculated immediately, since that is
+	 * the first container that will be hovered.
+	 * @ItemsToIgnore are treated as if they were not in any container.*/
+	UFUNCTION(Category = "Drag Session", BlueprintCallable, meta = (DefaultToSelf = "Outer"))
+	static UO_DragSession* CreateDragSession(UObject* Outer, FS_InventoryItem Item, TArray<FS_InventoryItem> ItemsToIgnore);
+
+	/**Same result as UAC_Inventory::CheckForSpace with Optimize enabled,
+	 * for the @Rotation of the dragged item.*/
+	UFUNCTION(Category = "Drag Session", BlueprintCallable)
+	void CheckForSpace(const FS_ContainerSettings& Container, int32 TopLeftIndex, TEnumAsByte<ERotation> Rotation, bool& SpotAvailable);
+
+	/**Same result as UAC_Inventory::CheckAllRotationsForSpace with Optimize enabled.
+	 * Rotations are tried in the same order, starting at @StartingRotation.*/
+	UFUNCTION(Category = "Drag Session", BlueprintCallable)
+	void CheckAllRotationsForSpace(const FS_ContainerSettings& Container, int32 TopLeftIndex, TEnumAsByte<ERotation> StartingRotation, bool& SpotAvailable,
+		TEnumAsByte<ERotation>& NeededRotation);
+
+	/**Recalculate the container the next time it is checked.
+	 * This is done automatically for changes made through the component.*/
+	UFUNCTION(Category = "Drag Session", BlueprintCallable)
+	void InvalidateContainer(FS_UniqueID ContainerID);
+
+	UFUNCTION(Category = "Drag Session", BlueprintCallable)
+	void InvalidateAllContainers();
+
+	/**Stop listening to the components. Called by the drag widget
+	 * when the drag is over.*/
+	UFUNCTION(Category = "Drag Session", BlueprintCallable)
+	void EndSession();
+
+	UFUNCTION(Category = "Drag Session", BlueprintCallable, BlueprintPure)
+	FS_InventoryItem GetItem() const { return Item; }
+
+	virtual void BeginDestroy() override;
+
+private:
+
+	struct FContainerKey
+	{
+		TObjectKey<UAC_Inventory> Component;
+		int32 IdentityNumber = 0;
+
+		bool operator==(const FContainerKey& Other) const
+		{
+			return Component == Other.Component && IdentityNumber == Other.IdentityNumber;
+		}
+
+		friend uint32 GetTypeHash(const FContainerKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Component), GetTypeHash(Key.IdentityNumber));
+		}
+	};
+
+	struct FContainerPlacement
+	{
+		/**One entry per tile, with a bit per rotation
+		 * that is set when the item fits there.*/
+		TArray<uint8> RotationMasks;
+
+		//Whether the destination component allows the item to be rotated.
+		bool CanRotate = false;
+
+		//Data only containers accept the item on any tile.
+		bool AcceptsAnyTile = false;
+
+		bool Dirty = true;
+	};
+
+	UPROPERTY(Transient)
+	FS_InventoryItem Item;
+
+	TArray<FS_UniqueID> IgnoredItems;
+
+	TMap<FContainerKey, FContainerPlacement> Containers;
+
+	//Components whose delegates we are bound to.
+	TArray<TWeakObjectPtr<UAC_Inventory>> BoundComponents;
+
+	/**Returns the placement for the @Container, calculating it
+	 * if it hasn't been or if it has been invalidated.*/
+	const FContainerPlacement& GetPlacement(const FS_ContainerSettings& Container);
+
+	void BuildPlacement(const FS_ContainerSettings& Container, FContainerPlacement& OutPlacement);
+
+	void BindToComponent(UAC_Inventory* Component);
+
+	UFUNCTION()
+	void HandleItemAdded(FS_InventoryItem ItemData, int32 ToIndex, FS_ContainerSettings ToContainer);
+
+	UFUNCTION()
+	void HandleItemRemoved(FS_InventoryItem ItemData, FS_ContainerSettings FromContainer);
+
+	UFUNCTION()
+	void HandleItemMoved(FS_InventoryItem OriginalItemData, FS_InventoryItem NewItemData, FS_ContainerSettings FromContainer, FS_ContainerSettings ToContainer,
+		UAC_Inventory* FromComponent, UAC_Inventory* ToComponent);
+
+	UFUNCTION()
+	void HandleContainerSizeAdjusted(FS_ContainerSettings Container, FMargin Expansion);
+
+	UFUNCTION()
+	void HandleServerInventoryDataReceived(AActor* InstigatingActor);
+};
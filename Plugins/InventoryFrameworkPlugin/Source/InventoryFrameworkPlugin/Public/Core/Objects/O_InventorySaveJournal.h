@@ -0,0 +1,104 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "UObject/Object.h"
+#include "O_InventorySaveJournal.generated.h"
+
+class UAC_Inventory;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FJournalCompacted, bool, Success);
+
+/**Incremental save file for a single inventory component.
+ *
+ * The save is split into two files. The base file holds every container,
+ * the journal is appended to with only the containers that were modified
+ * since the last write, using the components DirtyContainers.
+ * Item instances can change their SaveGame properties without marking
+ * their container dirty, so a container is also rewritten when the
+ * SaveGame data of its item instances no longer matches the last write.
+ * This makes the cost of an autosave scale with what has changed,
+ * not with how many items the inventory has.
+ *
+ * Once the journal grows past @CompactionThreshold, it is folded into the
+ * base file on a worker thread. Every journal entry replaces or removes a
+ * whole container, so replaying an entry twice is harmless. This is what
+ * allows a crash during compaction to be recovered from on the next load.
+ *
+ * Containers are stored in the binary format of FIFP_ContainerSerializer.*/
+UCLASS(BlueprintType)
+class INVENTORYFRAMEWORKPLUGIN_API UO_InventorySaveJournal : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**Create a journal that saves to Saved/SaveGames/@SaveName.ifp*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, meta = (DefaultToSelf = "Outer"))
+	static UO_InventorySaveJournal* CreateSaveJournal(UObject* Outer, FString SaveName);
+
+	/**Once the journal file is larger than this (in bytes), it is
+	 * automatically compacted after the next incremental write.*/
+	UPROPERTY(Category = "IFP Serialization", EditAnywhere, BlueprintReadWrite)
+	int64 CompactionThreshold = 1024 * 1024;
+
+	UPROPERTY(Category = "IFP Serialization", BlueprintAssignable)
+	FJournalCompacted JournalCompacted;
+
+	/**Append every container that has been modified, added or removed since
+	 * the last write to the journal. If there is no base file yet, this
+	 * writes a full save instead.
+	 * Returns how many containers were written.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	int32 WriteIncremental(UAC_Inventory* Inventory);
+
+	/**Write every container to the base file and clear the journal.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool WriteFull(UAC_Inventory* Inventory);
+
+	/**Read the base file and replay the journal on top of it, then restore
+	 * the result into the @Inventory. The component must not be started.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool LoadIntoInventory(UAC_Inventory* Inventory);
+
+	/**Fold the journal into the base file on a worker thread.
+	 * Writes can continue while this is running, they go into a new journal.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	void CompactAsync();
+
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, BlueprintPure)
+	bool IsCompacting() const;
+
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, BlueprintPure)
+	FString GetBaseFilePath() const;
+
+private:
+
+	FString BaseFilePath;
+
+	FString GetJournalFilePath() const;
+
+	/**The journal is moved here while it is being compacted.*/
+	FString GetCompactingFilePath() const;
+
+	/**UniqueID -> ContainerIndex of every container the files currently hold.
+	 * Used to find containers that were added, removed or reordered.*/
+	TMap<int32, int32> WrittenContainers;
+
+	/**UniqueID -> hash of the item instance records of every container
+	 * the files currently hold. Containers without instances are left out.*/
+	TMap<int32, uint32> WrittenInstanceHashes;
+
+	bool Compacting = false;
+
+	/**Serialize a single container with its item instances.*/
+	static TArray<uint8> SerializeContainer(UAC_Inventory* Inventory, const FS_ContainerSettings& Container);
+
+	/**Hash of the SaveGame data of every item instance in the @Container, 0 if it has none.*/
+	static uint32 GetInstanceHash(const FS_ContainerSettings& Container);
+
+	/**Remember the containers of the @Inventory as written, along with the @InstanceHashes they were written with.*/
+	void UpdateWrittenContainers(UAC_Inventory* Inventory, TMap<int32, uint32>&& InstanceHashes);
+};
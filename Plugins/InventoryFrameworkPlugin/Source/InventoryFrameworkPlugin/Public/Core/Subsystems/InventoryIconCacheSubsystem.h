@@ -0,0 +1,150 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "InventoryIconCacheSubsystem.generated.h"
+
+class UDA_CoreItem;
+class UTexture2D;
+class UTextureRenderTarget2D;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FIconEvicted, UDA_CoreItem*, ItemAsset);
+
+/**Shared cache for generated item icons.
+ *
+ * Instead of a render target per generated icon, icons are copied into
+ * cells of a few large atlas pages. Every icon is handed out as a brush
+ * pointing at its cell of the page.
+ *
+ * Once the pages use up @MemoryBudgetMB, the least recently used icon is
+ * evicted to make room and IconEvicted is broadcast, so anything still
+ * showing that icon can request it again.
+ *
+ * Generated icons are also written to Saved/InventoryFramework/IconCache,
+ * keyed by the item asset and a hash of its icon settings.
+ * Later sessions load the icon from there instead of generating it again.
+ * The hash includes the build version, so a patch regenerates every icon.
+ *
+ * Only items that use a static capture and have OptimizeIconCreation
+ * enabled are cached, as every other item can look different per instance.
+ *
+ * Budget and cache settings can be changed in the [/Script/InventoryFrameworkPlugin.InventoryIconCacheSubsystem]
+ * section of DefaultGame.ini.*/
+UCLASS(Config = Game)
+class INVENTORYFRAMEWORKPLUGIN_API UInventoryIconCacheSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	static UInventoryIconCacheSubsystem* Get(const UObject* WorldContext);
+
+	/**Width and height of a single icon in the atlas.
+	 * Icons of a different resolution are scaled to fit.*/
+	UPROPERTY(Category = "IFP Icon Cache", Config, EditAnywhere, BlueprintReadOnly)
+	int32 IconResolution = 256;
+
+	/**Width and height of an atlas page. Must be a multiple of @IconResolution.*/
+	UPROPERTY(Category = "IFP Icon Cache", Config, EditAnywhere, BlueprintReadOnly)
+	int32 PageResolution = 2048;
+
+	/**How much memory the atlas pages may use before icons are evicted.*/
+	UPROPERTY(Category = "IFP Icon Cache", Config, EditAnywhere, BlueprintReadWrite)
+	int32 MemoryBudgetMB = 64;
+
+	/**Write generated icons to disk and read them back in later sessions.*/
+	UPROPERTY(Category = "IFP Icon Cache", Config, EditAnywhere, BlueprintReadWrite)
+	bool UseDiskCache = true;
+
+	UPROPERTY(Category = "IFP Icon Cache", BlueprintAssignable)
+	FIconEvicted IconEvicted;
+
+	/**Get the icon for the @ItemAsset from the atlas or, if it was
+	 * generated in an earlier session, from the disk cache.
+	 * Returns false if the icon has to be generated.*/
+	UFUNCTION(Category = "IFP Icon Cache", BlueprintCallable)
+	bool FindIcon(UDA_CoreItem* ItemAsset, FSlateBrush& Icon);
+
+	/**Copy a freshly generated icon into the atlas and the disk cache.
+	 * The @RenderTarget is no longer needed once this returns.
+	 * Returns false if the item doesn't support cached icons.*/
+	UFUNCTION(Category = "IFP Icon Cache", BlueprintCallable)
+	bool StoreIcon(UDA_CoreItem* ItemAsset, UTextureRenderTarget2D* RenderTarget, FSlateBrush& Icon);
+
+	/**Whether icons of the @ItemAsset can be shared through this cache.*/
+	UFUNCTION(Category = "IFP Icon Cache", BlueprintCallable, BlueprintPure)
+	static bool CanCacheIcon(const UDA_CoreItem* ItemAsset);
+
+	/**Evict every icon. If @DeleteDiskCache is true, the
+	 * icons written to disk are deleted as well.*/
+	UFUNCTION(Category = "IFP Icon Cache", BlueprintCallable)
+	void ClearCache(bool DeleteDiskCache);
+
+	UFUNCTION(Category = "IFP Icon Cache", BlueprintCallable, BlueprintPure)
+	void GetCacheStats(int32& CachedIcons, int32& PageCount, int64& MemoryUsage) const;
+
+	static FString GetDiskCacheDirectory();
+
+private:
+
+	struct FIconCell
+	{
+		int32 Page = 0;
+		FIntPoint Position = FIntPoint(0, 0);
+		FName CacheKey;
+		TWeakObjectPtr<UDA_CoreItem> ItemAsset;
+
+		//GFrameCounter of the last time this icon was requested.
+		uint64 LastUsedFrame = 0;
+	};
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTexture2D>> Pages;
+
+	TArray<FIconCell> Cells;
+
+	TArray<int32> FreeCells;
+
+	TMap<FName, int32> CellIndexes;
+
+	//Files that are still being written on a worker thread.
+	TSet<FName> PendingWrites;
+
+	//Broadcast once the icon that caused them has been stored.
+	TArray<TWeakObjectPtr<UDA_CoreItem>> PendingEvictions;
+
+	/**Asset path and icon settings hash, which is also the file name in the disk cache.*/
+	static FName GetCacheKey(const UDA_CoreItem* ItemAsset);
+
+	FString GetCacheFilePath(FName CacheKey) const;
+
+	int32 GetPageSize() const;
+
+	//Bytes used by a single page.
+	int64 GetPageMemory() const;
+
+	/**Returns a free cell, adding a page or evicting the
+	 * least recently used icon if there is none.*/
+	int32 AllocateCell();
+
+	void AddPage();
+
+	/**Copy the @Pixels of a @Size icon into the @CellIndex, scaling them if needed.*/
+	void UploadIcon(int32 CellIndex, const TArray<FColor>& Pixels, FIntPoint Size);
+
+	bool LoadFromDisk(FName CacheKey, TArray<FColor>& OutPixels, FIntPoint& OutSize) const;
+
+	/**Compress and write the icon on a worker thread.*/
+	void WriteToDisk(FName CacheKey, TArray<FColor>&& Pixels, FIntPoint Size);
+
+	FSlateBrush MakeBrush(const FIconCell& Cell) const;
+
+	void BroadcastEvictions();
+
+	void UpdateStats() const;
+};
@@ -0,0 +1,109 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "Core/Data/SG_InventorySerialization.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "InventorySaveSubsystem.generated.h"
+
+class UAC_Inventory;
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FInventorySaveComplete, const FString&, SlotName, bool, Success);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FInventoryLoadComplete, const FString&, SlotName, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FInventorySaveFinished, const FString&, SlotName, bool, Success);
+
+/**Saves inventory components without hitching the game thread.
+ *
+ * The game thread only takes a snapshot of the component, which is a copy
+ * of GetContainersForSaveState, the SaveGame properties of every item instance
+ * and the path of every asset they reference.
+ * Converting that snapshot to the binary container format, compressing it
+ * and writing the file all happen on the thread pool.
+ *
+ * Only @MaxConcurrentSaves saves run at the same time, the rest are queued.
+ * If a slot is saved again while it is still queued, the queued snapshot
+ * is replaced instead of writing the slot twice.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventorySaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/**How many saves can be serialized and written at the same time.
+	 * Keeps a large amount of saves, such as every player being saved
+	 * at once, from flooding the thread pool.*/
+	UPROPERTY(Category = "IFP Serialization", EditAnywhere, BlueprintReadWrite)
+	int32 MaxConcurrentSaves = 4;
+
+	/**Broadcast on the game thread whenever a save has finished.*/
+	UPROPERTY(Category = "IFP Serialization", BlueprintAssignable)
+	FInventorySaveFinished SaveFinished;
+
+	/**Snapshot the @Inventory and write it to the @SlotName on a worker thread.
+	 * @OnComplete is called on the game thread once the file has been written.
+	 * Returns false if the component could not be snapshotted.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, meta = (AutoCreateRefTerm = "OnComplete"))
+	bool SaveInventoryAsync(UAC_Inventory* Inventory, FString SlotName, const FInventorySaveComplete& OnComplete);
+
+	/**Load a slot written by SaveInventoryAsync into the @Inventory.
+	 * The component must not have been started yet.
+	 * Any asset the slot references that isn't loaded yet is loaded
+	 * synchronously, prefer LoadInventoryAsync.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable)
+	bool LoadInventory(UAC_Inventory* Inventory, FString SlotName);
+
+	/**Stream in every asset the slot references, then load it into the @Inventory.
+	 * The component must not be started until @OnComplete has been called.
+	 * Returns false if the slot could not be read.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, meta = (AutoCreateRefTerm = "OnComplete"))
+	bool LoadInventoryAsync(UAC_Inventory* Inventory, FString SlotName, const FInventoryLoadComplete& OnComplete);
+
+	/**Returns the amount of saves that are queued or running.*/
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, BlueprintPure)
+	int32 GetPendingSaveCount() const;
+
+	UFUNCTION(Category = "IFP Serialization", BlueprintCallable, BlueprintPure)
+	bool IsSlotSaving(const FString& SlotName) const;
+
+	static FString GetSlotFilePath(const FString& SlotName);
+
+private:
+
+	/**Everything a worker needs to write a save.
+	 * Once started, only the worker reads from it.*/
+	struct FSaveJob
+	{
+		FString SlotName;
+		TArray<FS_ContainerSettings> Containers;
+		TArray<FItemInstanceRecord> InstanceRecords;
+		//Resolved during the snapshot, the worker must not ask objects for their path.
+		TMap<const UObject*, FSoftObjectPath> AssetPaths;
+		TArray<FInventorySaveComplete> Callbacks;
+		TFuture<bool> Result;
+	};
+
+	TArray<TSharedPtr<FSaveJob>> QueuedJobs;
+
+	TArray<TSharedPtr<FSaveJob>> RunningJobs;
+
+	void StartQueuedJobs();
+
+	void FinishJob(TSharedPtr<FSaveJob> Job, bool Success);
+
+	/**Read and decompress the container data of the @SlotName.*/
+	bool ReadSlot(const FString& SlotName, TArray<uint8>& OutContainerData);
+
+	/**Read the @ContainerData and restore it into the @Inventory.*/
+	bool RestoreSlot(UAC_Inventory* Inventory, const TArray<uint8>& ContainerData);
+
+	/**Serialize, compress and write the @Job. Runs on a worker thread.*/
+	static bool WriteJob(const FSaveJob& Job);
+};
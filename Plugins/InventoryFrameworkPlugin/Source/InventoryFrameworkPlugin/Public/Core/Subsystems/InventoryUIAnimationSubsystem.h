@@ -0,0 +1,50 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryUIAnimationSubsystem.generated.h"
+
+class UW_Container;
+class UW_InventoryItem;
+
+/**Drives the transitions of inventory widgets, so the widgets themselves never tick.
+ *
+ * Item widgets register here when their opacity or scale target changes
+ * and are removed again once they have reached it. Containers register
+ * when the gamepad navigated tile changes and are removed once the cursor
+ * has been moved onto the tile. When nothing is animating, this doesn't tick.
+ *
+ * Uses the real delta time and keeps ticking while the game is paused,
+ * since inventories are often opened while paused.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventoryUIAnimationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UInventoryUIAnimationSubsystem* Get(const UObject* WorldContext);
+
+	/**Start ticking the transition of the @Widget until it reports it has finished.*/
+	void AnimateItemWidget(UW_InventoryItem* Widget);
+
+	/**Keep the cursor on the @Container's navigated tile until it has settled,
+	 * for example while the scroll box is scrolling the tile into view.*/
+	void SyncNavigationCursor(UW_Container* Container);
+
+	UFUNCTION(Category = "IFP|UI", BlueprintCallable, BlueprintPure)
+	int32 GetActiveAnimationCount() const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	TArray<TWeakObjectPtr<UW_InventoryItem>> ActiveItemWidgets;
+
+	TArray<TWeakObjectPtr<UW_Container>> ActiveContainers;
+};
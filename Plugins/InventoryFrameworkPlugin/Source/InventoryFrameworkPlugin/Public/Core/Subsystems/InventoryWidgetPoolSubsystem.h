@@ -0,0 +1,120 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "InventoryWidgetPoolSubsystem.generated.h"
+
+USTRUCT()
+struct FIFP_WidgetPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> Widgets;
+};
+
+/**Reuses item, tile and drag widgets instead of destroying and creating them.
+ *
+ * Opening and closing inventories, resizing containers and reconstructing
+ * them creates a lot of widgets that are thrown away moments later.
+ * Releasing those widgets here and acquiring them again the next time
+ * one is needed avoids that churn and the garbage collection it causes.
+ *
+ * Widgets implementing I_PooledWidget are told when they are handed out
+ * and returned, so they can clear their state. Item widgets can be bound
+ * to a different item through UW_InventoryItem::RebindItem.
+ *
+ * One pool exists per local player, so split screen players never
+ * receive each others widgets. "stat InventoryFramework" shows the hit rate.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UInventoryWidgetPoolSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**Returns the pool of the local player owning the @WorldContext
+	 * if it's a widget, otherwise the pool of the first local player.*/
+	static UInventoryWidgetPoolSubsystem* Get(const UObject* WorldContext);
+
+	/**How many inactive widgets of a single class are kept around.
+	 * Widgets released past this are left for garbage collection.*/
+	UPROPERTY(Category = "IFP Widget Pool", EditAnywhere, BlueprintReadWrite)
+	int32 MaxPooledWidgetsPerClass = 256;
+
+	/**Take a widget of the @WidgetClass out of the pool,
+	 * creating one if the pool is empty.*/
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable, meta = (DeterminesOutputType = "WidgetClass"))
+	UUserWidget* AcquireWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	template<typename WidgetType>
+	WidgetType* AcquireWidget(TSubclassOf<WidgetType> WidgetClass)
+	{
+		return Cast<WidgetType>(AcquireWidget(TSubclassOf<UUserWidget>(WidgetClass)));
+	}
+
+	/**AcquireWidget from the pool of the @Owner's local player. Falls back
+	 * to CreateWidget if there is no pool, for example in editor utility widgets.
+	 * @Owner is anything CreateWidget accepts as an owner, such as a widget or world.*/
+	template<typename WidgetType, typename OwnerType>
+	static WidgetType* AcquireWidget(OwnerType* Owner, TSubclassOf<WidgetType> WidgetClass)
+	{
+		if(!WidgetClass)
+		{
+			return nullptr;
+		}
+
+		if(UInventoryWidgetPoolSubsystem* WidgetPool = Get(Owner))
+		{
+			return WidgetPool->AcquireWidget<WidgetType>(WidgetClass);
+		}
+
+		return CreateWidget<WidgetType>(Owner, WidgetClass);
+	}
+
+	/**Remove the @Widget from its parent and return it to the pool.*/
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable)
+	void ReleaseWidget(UUserWidget* Widget);
+
+	/**Create widgets ahead of time so the first time a screen
+	 * is opened doesn't pay for them, for example vendor screens.*/
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable)
+	void PrewarmWidgets(TSubclassOf<UUserWidget> WidgetClass, int32 Count);
+
+	/**Let every inactive widget be garbage collected.*/
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable)
+	void EmptyPool();
+
+	/**The fraction of acquired widgets that came from the pool.*/
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable, BlueprintPure)
+	float GetHitRate() const;
+
+	UFUNCTION(Category = "IFP Widget Pool", BlueprintCallable, BlueprintPure)
+	void GetPoolStats(int32& PoolHits, int32& PoolMisses, int32& PooledWidgets) const;
+
+private:
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FIFP_WidgetPoolBucket> Pool;
+
+	int32 Hits = 0;
+
+	int32 Misses = 0;
+
+	int32 PooledCount = 0;
+
+	FDelegateHandle WorldCleanupHandle;
+
+	UUserWidget* CreatePoolWidget(TSubclassOf<UUserWidget> WidgetClass) const;
+
+	/**Pooled widgets belong to the world they were created in.*/
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	void UpdateStats() const;
+};
@@ -0,0 +1,129 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+#include "Widgets/SLeafWidget.h"
+
+DECLARE_DELEGATE_OneParam(FOnVirtualizedGridTileHovered, int32 /*TileIndex*/);
+
+/**Everything the grid needs to draw a single item.*/
+struct FIFP_GridItemDrawData
+{
+	//Top left tile of the item.
+	FIntPoint Tile = FIntPoint(0, 0);
+
+	//Dimensions after rotation has been applied.
+	FIntPoint Dimensions = FIntPoint(1, 1);
+
+	//Rotation of the icon in degrees.
+	float Angle = 0;
+
+	FSlateBrush Icon;
+
+	/**Hidden items still block their tiles for hit testing,
+	 * they are just not drawn. Used while a real item widget
+	 * is representing the item.*/
+	bool Hidden = false;
+};
+
+/**Draws an entire grid container as a single widget.
+ *
+ * Tile backgrounds and item icons are emitted as draw elements directly,
+ * and only for the tiles that intersect the culling rect, so a large
+ * container inside a scroll box only pays for what is on screen.
+ * Hit testing is done with arithmetic on the tile size instead of
+ * asking Slate to hit test a widget per tile.
+ *
+ * Tile indexes follow the same layout as UFL_InventoryFramework::IndexToTile.*/
+class INVENTORYFRAMEWORKPLUGIN_API SIFP_VirtualizedGrid : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SIFP_VirtualizedGrid)
+		: _TileSize(FVector2D(60, 60))
+		{}
+		SLATE_ARGUMENT(FVector2D, TileSize)
+		SLATE_ARGUMENT(FMargin, TilePadding)
+		SLATE_ARGUMENT(FMargin, ItemPadding)
+		SLATE_EVENT(FOnVirtualizedGridTileHovered, OnTileHovered)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	void SetGridSize(FIntPoint NewGridSize);
+
+	void SetTileSize(FVector2D NewTileSize);
+
+	void SetPadding(const FMargin& NewTilePadding, const FMargin& NewItemPadding);
+
+	void SetTileBrush(const FSlateBrush& NewTileBrush);
+
+	void SetHighlightBrush(const FSlateBrush& NewHighlightBrush);
+
+	/**Replace every item and rebuild the tile occupancy.*/
+	void SetItems(TArray<FIFP_GridItemDrawData>&& NewItems);
+
+	void SetItemHidden(int32 ItemIndex, bool Hidden);
+
+	void SetHighlightedTile(int32 TileIndex);
+
+	FIntPoint GetGridSize() const { return GridSize; }
+
+	int32 GetHoveredTile() const { return HoveredTile; }
+
+	int32 GetHighlightedTile() const { return HighlightedTile; }
+
+	/**Returns the tile under the @LocalPosition or -1 if it's outside the grid.*/
+	int32 GetTileAtLocalPosition(const FVector2D& LocalPosition) const;
+
+	/**Returns the index of the item occupying the @TileIndex or -1.*/
+	int32 GetItemAtTile(int32 TileIndex) const;
+
+	/**Top left corner of the @TileIndex, relative to the grid.*/
+	FVector2D GetTileLocalPosition(int32 TileIndex) const;
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	virtual void OnDragEnter(const FGeometry& MyGeometry, const FDragDropEvent& DragDropEvent) override;
+	virtual FReply OnDragOver(const FGeometry& MyGeometry, const FDragDropEvent& DragDropEvent) override;
+	virtual void OnDragLeave(const FDragDropEvent& DragDropEvent) override;
+
+protected:
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+
+	FIntPoint GridSize = FIntPoint(0, 0);
+
+	FVector2D TileSize = FVector2D(60, 60);
+
+	FMargin TilePadding;
+
+	FMargin ItemPadding;
+
+	FSlateBrush TileBrush;
+
+	FSlateBrush HighlightBrush;
+
+	TArray<FIFP_GridItemDrawData> Items;
+
+	//Item index per tile, -1 for empty tiles.
+	TArray<int32> TileOccupancy;
+
+	int32 HoveredTile = -1;
+
+	int32 HighlightedTile = -1;
+
+	FOnVirtualizedGridTileHovered OnTileHovered;
+
+	void UpdateHoveredTile(int32 NewTile);
+
+	/**Converts the @MyCullingRect into the range of tiles that are visible.
+	 * Returns false if no tile is visible.*/
+	bool GetVisibleTileRange(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FIntPoint& OutMin, FIntPoint& OutMax) const;
+};
@@ -8,13 +8,14 @@
 #include "Blueprint/UserWidget.h"
 #include "Core/Data/IFP_CoreData.h"
 #include "Core/Interfaces/I_InventoryWidgets.h"
+#include "Core/Interfaces/I_PooledWidget.h"
 #include "W_AttachmentParent.generated.h"
 
 /**Parent widget meant to host a set of container widgets.
  * This is used by items that can be opened, such as a backpack
  * to display its containers.*/
 UCLASS(Abstract)
-class INVENTORYFRAMEWORKPLUGIN_API UW_AttachmentParent : public UUserWidget, public II_InventoryWidgets
+class INVENTORYFRAMEWORKPLUGIN_API UW_AttachmentParent : public UUserWidget, public II_InventoryWidgets, public II_PooledWidget
 {
 	GENERATED_BODY()
 
@@ -34,4 +35,11 @@ public:
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Getters", meta = (CompactNodeTitle = "Inventory"))
 	void GetInventory(UAC_Inventory*& Component);
+
+	//--------------------
+	//Start of I_PooledWidget interface
+
+	virtual void ReleasedToPool_Implementation() override;
+
+	//End of I_PooledWidget interface
 };
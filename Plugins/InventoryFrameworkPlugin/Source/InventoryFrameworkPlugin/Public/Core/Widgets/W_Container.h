@@ -15,6 +15,8 @@
 #include "Core/Components/AC_Inventory.h"
 #include "W_Container.generated.h"
 
+class UW_VirtualizedGrid;
+
 UENUM(BlueprintType)
 enum EContainerNavigationDirection
 {
@@ -27,8 +29,9 @@ enum EContainerNavigationDirection
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FNavigatedOutOfBounds, EContainerNavigationDirection, LastDirection, UW_Container*, FromContainer, UW_Container*, ToContainer);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FNavigatedTo, EContainerNavigationDirection, InDirection, UW_Container*, FromContainer, UW_Container*, ToContainer);
 
-/**Widget representing a container, which hosts tiles and items.*/
-UCLASS(Abstract)
+/**Widget representing a container, which hosts tiles and items.
+ * Doesn't tick, gamepad cursor placement is driven by UInventoryUIAnimationSubsystem.*/
+UCLASS(Abstract, meta = (DisableNativeTick))
 class INVENTORYFRAMEWORKPLUGIN_API UW_Container : public UUserWidget, public II_ExternalObjects
 {
 	GENERATED_BODY()
@@ -84,6 +87,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", meta = (EditCondition = "UseCustomTileBrush"))
 	FSlateBrush CustomTileBrush;
 
+	/**Draw the tiles and item icons with a single UW_VirtualizedGrid instead
+	 * of creating a tile widget per tile and an item widget per item.
+	 * Real item widgets are only created for the item that is hovered,
+	 * navigated to or dragged.
+	 *
+	 * ConstructContainers should call ConstructVirtualizedGrid instead
+	 * of creating tiles and items when this is enabled.
+	 * Only supported by spacial containers.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings|Virtualization")
+	bool UseVirtualizedGrid = false;
+
+	/**The item widget created for the hovered or navigated item
+	 * while using a virtualized grid.*/
+	UPROPERTY(BlueprintReadOnly, Category = "Items")
+	TObjectPtr<UW_InventoryItem> VirtualizedItemWidget = nullptr;
+
 	UPROPERTY(BlueprintReadWrite, Category = "Items", meta = (DeprecatedProperty, DeprecationMessage = "Replaced with GetAllItemWidgets"))
 	TArray<TObjectPtr<UW_InventoryItem>> Items;
 	
@@ -141,12 +160,68 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, BlueprintPure, Category = "Design", meta = (CompactNodeTitle = "Scroll Box"))
 	UScrollBox* GetScrollBox();
 
+	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, BlueprintPure, Category = "Design", meta = (CompactNodeTitle = "Virtualized Grid"))
+	UW_VirtualizedGrid* GetVirtualizedGrid();
+
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="CPP Functions||Initialization")
 	void ConstructContainers(FS_ContainerSettings ContainerSetting, UAC_Inventory* InventoryComponent, bool Reinitialize);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Getters", meta = (CompactNodeTitle = "Inventory"))
 	UAC_Inventory* GetInventory();
 
+	/**Return every tile and item widget of this container to the widget pool
+	 * and empty the Tiles array. Call this before constructing the container
+	 * again, for example when ConstructContainers is called with Reinitialize
+	 * or the container has been resized, then acquire the new widgets
+	 * from UInventoryWidgetPoolSubsystem.*/
+	UFUNCTION(BlueprintCallable, Category = "Initialization")
+	void ReleaseWidgetsToPool();
+
+	/**Take a tile widget for @TileIndex out of the widget pool, creating one
+	 * if the pool is empty, set it up for this container and add it to the
+	 * Tiles array and the grid panel.
+	 * ConstructContainers should use this instead of creating the tiles.*/
+	UFUNCTION(BlueprintCallable, Category = "Initialization")
+	UW_Tile* AcquireTileWidget(int32 TileIndex);
+
+	/**Take an item widget out of the widget pool, creating one if the pool is
+	 * empty, and bind it to the @Item through RebindItem. The class comes from
+	 * the items ItemWidgetOverrides for this container, otherwise ItemClass.*/
+	UFUNCTION(BlueprintCallable, Category = "Items")
+	UW_InventoryItem* AcquireItemWidget(UPARAM(ref) FS_InventoryItem& Item);
+
+	/**Bind to and build the virtualized grid.
+	 * Returns false if there's no virtualized grid or the container
+	 * is not a spacial container.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualization")
+	bool ConstructVirtualizedGrid();
+
+	/**Rebuild the virtualized grid after items have been
+	 * added, removed or moved.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualization")
+	void RefreshVirtualizedGrid();
+
+	/**Refresh the virtualized grid on the next tick, so several items changing
+	 * at once only rebuild it once. The inventory component calls this
+	 * whenever this container is marked dirty.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualization")
+	void MarkVirtualizedGridDirty();
+
+	/**Called by the inventory component when an item in this container needs a
+	 * widget after being added, moved or split. Virtualized containers only create
+	 * one if the item is hovered or navigated to, every other item is drawn by the
+	 * grid. Otherwise this calls CreateWidgetForItem.*/
+	UW_InventoryItem* RequestWidgetForItem(FS_InventoryItem& Item);
+
+	/**Create a real widget for the @Item, replacing the widget of
+	 * the previously realized item unless that item is being dragged.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualization")
+	UW_InventoryItem* RealizeVirtualizedItem(FS_InventoryItem Item);
+
+	/**Destroy the realized item widget and draw its icon in the grid again.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualization")
+	void ReleaseVirtualizedItem();
+
 	/**Even though container widgets have a ContainerSettings, you should only use that variable
 	 * for information that would never change (for example it's UniqueID, container type...)
 	 * since this function might get heavy if a component has A LOT of containers.*/
@@ -158,7 +233,9 @@ public:
 
 	/**This is mainly handled on the Blueprint level because designers might want to create children
 	 * of W_Container and have this function behave completely differently.
-	 * This should allow this system to be converted into a list style inventory.*/
+	 * This should allow this system to be converted into a list style inventory.
+	 * The default implementation gets the widget through AcquireItemWidget
+	 * and adds it to the grid panel at the items tile.*/
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Items")
 	void CreateWidgetForItem(UPARAM(ref) FS_InventoryItem& Item, UW_InventoryItem*& Widget);
 
@@ -222,8 +299,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Navigation")
 	void StopNavigation();
 
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	/**Move the cursor onto the navigated tile to simulate as if the player
+	 * is still using the mouse. Returns true once the tile has stopped
+	 * moving, for example when the scroll box finished scrolling it into view.
+	 * Called by UInventoryUIAnimationSubsystem.*/
+	bool TickNavigationCursor();
 
 	virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
+
+protected:
+
+	UPROPERTY()
+	FS_InventoryItem VirtualizedItem;
+
+	bool VirtualizedGridDirty = false;
+
+	//Where TickNavigationCursor last put the cursor.
+	FIntPoint LastNavigationCursorPosition = FIntPoint(INDEX_NONE);
+
+	void StartNavigationCursorSync();
+
+	UFUNCTION()
+	void VirtualizedTileHovered(int32 TileIndex, FS_InventoryItem Item);
 };
\ No newline at end of file
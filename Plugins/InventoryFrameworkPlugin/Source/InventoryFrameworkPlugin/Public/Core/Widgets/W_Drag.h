@@ -8,8 +8,11 @@
 #include "CoreMinimal.h"
 #include "W_Tile.h"
 #include "Blueprint/UserWidget.h"
+#include "Core/Interfaces/I_PooledWidget.h"
 #include "W_Drag.generated.h"
 
+class UO_DragSession;
+
 UENUM(BlueprintType)
 enum EDropOperation
 {
@@ -28,7 +31,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHoverTileUpdated, UW_Tile*, NewTile
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDestroyed);
 
 UCLASS()
-class INVENTORYFRAMEWORKPLUGIN_API UW_Drag : public UUserWidget
+class INVENTORYFRAMEWORKPLUGIN_API UW_Drag : public UUserWidget, public II_PooledWidget
 {
 	GENERATED_BODY()
 
@@ -90,4 +93,29 @@ public:
 
 	UFUNCTION(Category = "Drag", BlueprintImplementableEvent, BlueprintCallable)
 	void RotateItem();
+
+	/**Returns the session caching where @ItemData can be placed,
+	 * creating it the first time this is called for the item.
+	 * Use this instead of CheckAllRotationsForSpace when
+	 * updating the highlight while dragging.*/
+	UFUNCTION(Category = "Drag", BlueprintCallable)
+	UO_DragSession* GetDragSession();
+
+	//--------------------
+	//Start of I_PooledWidget interface
+
+	virtual void ReleasedToPool_Implementation() override;
+
+	//End of I_PooledWidget interface
+
+protected:
+
+	virtual void NativeDestruct() override;
+
+private:
+
+	UPROPERTY(Transient)
+	TObjectPtr<UO_DragSession> DragSession = nullptr;
+
+	void EndDragSession();
 };
@@ -12,9 +12,11 @@
 #include "Components/CircularThrobber.h"
 #include "Components/Image.h"
 #include "Core/Interfaces/I_ExternalObjects.h"
+#include "Core/Interfaces/I_PooledWidget.h"
 #include "W_InventoryItem.generated.h"
 
 class UW_Tile;
+class UW_Drag;
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FItemCountChanged, int32, OldCount, int32, NewCount);
@@ -24,9 +26,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FItemDragEnded, UW_InventoryItem*, I
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FItemPressed, UW_InventoryItem*, Item);
 
 
-/**Base widget to represent items.*/
-UCLASS(Abstract)
-class INVENTORYFRAMEWORKPLUGIN_API UW_InventoryItem : public UUserWidget, public II_ExternalObjects
+/**Base widget to represent items.
+ * Doesn't tick, opacity and scale transitions are driven by UInventoryUIAnimationSubsystem.*/
+UCLASS(Abstract, meta = (DisableNativeTick))
+class INVENTORYFRAMEWORKPLUGIN_API UW_InventoryItem : public UUserWidget, public II_ExternalObjects, public II_PooledWidget
 {
 	GENERATED_BODY()
 
@@ -54,10 +57,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Container")
 	UW_Container* ParentContainer;
 
-	UPROPERTY(BlueprintReadWrite, Category = "Settings")
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetOpacityTarget, Category = "Settings")
 	float OpacityTarget = 1.0;
 
-	UPROPERTY(BlueprintReadWrite, Category = "Settings")
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetScaleTarget, Category = "Settings")
 	float ScaleTarget = 1.0;
 
 	/**When the player clicks on the item, which background tile is being clicked?
@@ -139,6 +142,12 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "UI")
 	void ConstructItemWidget();
 
+	/**Point this widget at a different item and refresh it through
+	 * ConstructItemWidget, without reconstructing the widget.
+	 * Mostly used with widgets acquired from the widget pool.*/
+	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "UI")
+	void RebindItem(FS_InventoryItem NewItem, UW_Container* NewParentContainer);
+
 	/**Used for custom shaped items. When dragging and rotating, you might want the item to rotate and
 	 * be offset by a specific tile. In WBP_DemoInventoryItem, the anchor point is whatever tile
 	 * you clicked on the item. For other types of items, you will want to return 0, 0.*/
@@ -183,8 +192,27 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Design")
 	void ItemHighlightUpdated(bool NewIsHighlighted);
 
+	/**Smoothly fade the widget towards the @NewOpacityTarget.*/
+	UFUNCTION(BlueprintSetter)
+	void SetOpacityTarget(float NewOpacityTarget);
+
+	/**Smoothly scale the widget towards the @NewScaleTarget.*/
+	UFUNCTION(BlueprintSetter)
+	void SetScaleTarget(float NewScaleTarget);
+
+	/**Move the opacity and scale towards their targets.
+	 * Returns true once both have been reached.
+	 * Called by UInventoryUIAnimationSubsystem.*/
+	bool TickTransition(float DeltaTime);
+
 	UFUNCTION(Category = "Drag and Drop", BlueprintNativeEvent, BlueprintCallable)
 	UDragDropOperation* StartDragItem();
+
+	/**Take a drag widget of the @DragClass out of the widget pool, creating one if
+	 * the pool is empty, fill it in for this item and make it the local inventory's
+	 * DragWidget. OnDragDetected should use this instead of creating the widget.*/
+	UFUNCTION(Category = "Drag and Drop", BlueprintCallable)
+	UW_Drag* AcquireDragWidget(TSubclassOf<UW_Drag> DragClass);
 	
 	UFUNCTION(Category = "Drag and Drop", BlueprintNativeEvent, BlueprintCallable)
 	void StopDragItem();
@@ -200,9 +228,21 @@ public:
 	virtual FLinearColor GetBackgroundColor_Implementation() override;
 
 	//End of I_ExternalObjects interface
+
+	//--------------------
+	//Start of I_PooledWidget interface
+
+	virtual void ReleasedToPool_Implementation() override;
+
+	//End of I_PooledWidget interface
 	
 
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeConstruct() override;
+
+	/**Hovering an item that can be opened builds its attachment widget
+	 * through ExpandAttachmentWidget, so it's ready once the item is opened.*/
+	virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
 	
 	
 	//--------------------
@@ -213,4 +253,15 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent, Category = "Networking")
 	void ParentItemRemovedFromNetworkQueue();
+
+private:
+
+	/**Register with the animation subsystem, or jump straight
+	 * to the targets if there is none, for example in the editor.*/
+	void StartTransition();
+
+	/**Clear the Widget ref of the item in its component if it still
+	 * points at this widget, so a released widget isn't treated
+	 * as the widget of the item it was last bound to.*/
+	void ClearItemWidgetReference();
 };
@@ -8,6 +8,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/Data/IFP_CoreData.h"
+#include "Core/Interfaces/I_PooledWidget.h"
 #include "W_Tile.generated.h"
 
 
@@ -27,7 +28,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDragEnd, UW_Tile*, Tile);
 
 /**Simple widget representing the tiles inside a container widget.*/
 UCLASS(Abstract)
-class INVENTORYFRAMEWORKPLUGIN_API UW_Tile : public UUserWidget
+class INVENTORYFRAMEWORKPLUGIN_API UW_Tile : public UUserWidget, public II_PooledWidget
 {
 	GENERATED_BODY()
 
@@ -137,6 +138,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Visibility", BlueprintPure, meta = (CompactNodeTitle = "Tags"))
 	FGameplayTagContainer GetTileTags();
 	
+	//--------------------
+	//Start of I_PooledWidget interface
+
+	virtual void ReleasedToPool_Implementation() override;
+
+	//End of I_PooledWidget interface
+	
 	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
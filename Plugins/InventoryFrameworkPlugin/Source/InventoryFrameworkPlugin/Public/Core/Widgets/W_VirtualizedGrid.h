@@ -0,0 +1,116 @@
+// Copyright (C) Varian Daemon 2023. All Rights Reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Core/Data/IFP_CoreData.h"
+#include "W_VirtualizedGrid.generated.h"
+
+class SIFP_VirtualizedGrid;
+class UW_Container;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FVirtualizedGridTileHovered, int32, TileIndex, FS_InventoryItem, Item);
+
+/**Renders a grid container with a single widget instead of a tile
+ * widget per tile and an item widget per item.
+ *
+ * Tile backgrounds and item icons are drawn directly and only for
+ * the part of the grid that is visible, which keeps large containers
+ * such as stashes cheap to lay out, paint and hit test.
+ * The owning container creates real item widgets on demand for
+ * the item that is hovered, navigated to or dragged.
+ *
+ * Place this inside the container's scroll box or overlay and return
+ * it from UW_Container::GetVirtualizedGrid.*/
+UCLASS()
+class INVENTORYFRAMEWORKPLUGIN_API UW_VirtualizedGrid : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+
+	//--------------------
+	// Variables
+
+	/**Brush drawn behind every tile. If the container is using
+	 * a custom tile brush, that brush is used instead.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateBrush TileBrush;
+
+	//Brush drawn over the tile that is being navigated with a gamepad.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+	FSlateBrush HighlightBrush;
+
+	/**Broadcast when the cursor or a drag moves to a different tile.
+	 * @TileIndex is -1 when the cursor leaves the grid.*/
+	UPROPERTY(BlueprintAssignable, Category = "EventDispatchers")
+	FVirtualizedGridTileHovered TileHovered;
+
+	//--------------------
+	// Functions
+
+	/**Rebuild the grid from the @Container's current settings and items.
+	 * Call this whenever items are added, removed, moved or the
+	 * container is resized.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualized Grid")
+	void RefreshGrid(UW_Container* Container);
+
+	/**Hide or show the icon of the @Item. Used while a real
+	 * item widget is representing the item.*/
+	UFUNCTION(BlueprintCallable, Category = "Virtualized Grid")
+	void SetItemHidden(FS_InventoryItem Item, bool Hidden);
+
+	UFUNCTION(BlueprintCallable, Category = "Virtualized Grid")
+	void SetHighlightedTile(int32 TileIndex);
+
+	/**Returns the tile under the @AbsolutePosition, for example the
+	 * screen space position of a drag event, or -1.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Virtualized Grid")
+	int32 GetTileAtAbsolutePosition(FVector2D AbsolutePosition) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Virtualized Grid")
+	int32 GetHoveredTile() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Virtualized Grid")
+	int32 GetHighlightedTile() const;
+
+	/**Top left corner of the @TileIndex, relative to the grid.*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Virtualized Grid")
+	FVector2D GetTileLocalPosition(int32 TileIndex) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Virtualized Grid")
+	FS_InventoryItem GetItemAtTile(int32 TileIndex) const;
+
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override;
+#endif
+
+protected:
+
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+private:
+
+	TSharedPtr<SIFP_VirtualizedGrid> MyGrid;
+
+	//The items in the same order as the draw data given to the Slate widget.
+	UPROPERTY(Transient)
+	TArray<FS_InventoryItem> GridItems;
+
+	//Keeps the icons that are being drawn alive.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTexture2D>> Icons;
+
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UW_Container> LastContainer;
+
+	TSharedPtr<FStreamableHandle> IconLoadHandle;
+
+	void HandleTileHovered(int32 TileIndex);
+};
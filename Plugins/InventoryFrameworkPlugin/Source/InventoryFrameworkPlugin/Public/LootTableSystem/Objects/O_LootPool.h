@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Core/Data/IFP_CoreData.h"
+#include "Engine/StreamableManager.h"
 #include "UObject/Object.h"
 #include "O_LootPool.generated.h"
 
@@ -49,10 +50,24 @@ public:
 
 	/**Start loading assets, such as any item assets this pool is referencing.
 	 * By default, this is never called. You might want to call this when the
-	 * player is in close proximity of the owner of this loot pool.*/
+	 * player is in close proximity of the owner of this loot pool.
+	 * The default implementation asynchronously loads everything returned
+	 * by @GetAssetsToPreLoad, so it never blocks the game thread.*/
 	UFUNCTION(Category = "Loot Pool", BlueprintNativeEvent)
 	void PreLoadAssets();
 
+	/**The soft references this pool wants loaded when @PreLoadAssets is called.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintNativeEvent, BlueprintPure)
+	TArray<FSoftObjectPath> GetAssetsToPreLoad();
+
+	/**Async load priority used by the default @PreLoadAssets implementation.*/
+	UPROPERTY(Category = "Loot Pool", EditAnywhere, BlueprintReadWrite)
+	int32 PreLoadPriority = FStreamableManager::DefaultAsyncLoadPriority;
+
+	/**Called once all assets requested by @PreLoadAssets have finished loading.*/
+	UFUNCTION(Category = "Loot Pool", BlueprintImplementableEvent)
+	void AssetsPreLoaded();
+
 	/**Get the number of items that this pool has spawned, optionally including
 	 * the amount of all loot tables and the quantity of items they have spawned.
 	 * This is useful for moments where you want to control how many items
@@ -73,6 +88,13 @@ public:
 	UFUNCTION(Category = "Loot Pool", BlueprintCallable, DisplayName = "Add Item (Pre-initialize only)")
 	void AddItemPreInitializeOnly(FS_InventoryItem Item, FS_ContainerSettings Container, bool IncludeLootTable = true);
 
+private:
+
+	/**Keeps the preloaded assets resident until the pool is destroyed.*/
+	TSharedPtr<FStreamableHandle> PreLoadHandle;
+
+public:
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
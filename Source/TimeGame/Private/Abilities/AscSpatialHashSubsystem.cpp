@@ -0,0 +1,72 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/AscSpatialHashSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+
+bool UAscSpatialHashSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAscSpatialHashSubsystem::RegisterAsc(UAbilitySystemComponent* Asc)
+{
+	Ascs.AddUnique(Asc);
+}
+
+void UAscSpatialHashSubsystem::UnregisterAsc(UAbilitySystemComponent* Asc)
+{
+	Ascs.RemoveSwap(Asc);
+}
+
+FIntVector UAscSpatialHashSubsystem::GetCell(const FVector& Location)
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UAscSpatialHashSubsystem::Update()
+{
+	if (BuiltFrame == GFrameCounter) return;
+	BuiltFrame = GFrameCounter;
+
+	Entries.Reset();
+	Cells.Reset();
+	MaxRadius = 0;
+
+	for (int32 Index = Ascs.Num() - 1; Index >= 0; Index--)
+	{
+		UAbilitySystemComponent* Asc = Ascs[Index].Get();
+		if (!Asc)
+		{
+			Ascs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const AActor* Avatar = Asc->GetAvatarActor();
+		if (!IsValid(Avatar)) continue;
+
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Asc = Asc;
+		Entry.Avatar = Avatar;
+		Entry.Location = Avatar->GetActorLocation();
+		Entry.Radius = Avatar->GetSimpleCollisionRadius();
+		Entry.Cell = GetCell(Entry.Location);
+		MaxRadius = FMath::Max(MaxRadius, Entry.Radius);
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B)
+	{
+		if (A.Cell.X != B.Cell.X) return A.Cell.X < B.Cell.X;
+		if (A.Cell.Y != B.Cell.Y) return A.Cell.Y < B.Cell.Y;
+		return A.Cell.Z < B.Cell.Z;
+	});
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		TPair<int32, int32>& Range = Cells.FindOrAdd(Entries[Index].Cell, TPair<int32, int32>(Index, 0));
+		Range.Value++;
+	}
+}
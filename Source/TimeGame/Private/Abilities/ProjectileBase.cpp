@@ -3,17 +3,17 @@
 
 #include "Abilities/ProjectileBase.h"
 
-#include "AbilitySystemComponent.h"
-#include "AbilitySystemInterface.h"
+#include "Abilities/ProjectileSubsystem.h"
 #include "Components/SphereComponent.h"
-#include "Kismet/GameplayStatics.h"
 
 
 AProjectileBase::AProjectileBase()
 {
+	//Visual only, every machine simulates its own copy of the projectile.
 	PrimaryActorTick.bCanEverTick = true;
-	bReplicates = true;
-	SetReplicatingMovement(true);
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	bReplicates = false;
+	SetReplicatingMovement(false);
 	
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>("SphereComponent");
 	SetRootComponent(CollisionComponent);
@@ -22,14 +22,12 @@ AProjectileBase::AProjectileBase()
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>("StaticMeshComponent");
 	MeshComponent->SetupAttachment(CollisionComponent);
 	ProjectileMovementComponent = CreateDefaultSubobject<UProjectileMovementComponent>("ProjectileMovementComponent");
-	ProjectileMovementComponent->SetIsReplicated(true);
+	ProjectileMovementComponent->bAutoActivate = false;
 
-	CollisionComponent->SetGenerateOverlapEvents(true);
+	CollisionComponent->SetGenerateOverlapEvents(false);
 	CollisionComponent->SetNotifyRigidBodyCollision(false);
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::Type::NoCollision);
 
-	ProjectileMovementComponent->bRotationFollowsVelocity;
-	ProjectileMovementComponent->bInterpMovement = true;
-	ProjectileMovementComponent->SetInterpolatedComponent(MeshComponent);
 	ProjectileMovementComponent->ProjectileGravityScale = 0;
 	ProjectileMovementComponent->MaxSpeed = 4000;
 	ProjectileMovementComponent->InitialSpeed = 4000;
@@ -43,62 +41,16 @@ AProjectileBase* AProjectileBase::SpawnProjectile(UObject* WorldContextObject,
 	const FVector& Origin, const FVector& Direction, const bool bInDestroyOnOverlap, const TArray<AActor*>& InActorsToIgnore,
 	const bool bInCreateZone, const FZoneParams& InZoneParams)
 {
-	const FRotator Rot = Direction.Rotation();
-	AProjectileBase* Projectile = WorldContextObject->GetWorld()->SpawnActorDeferred<AProjectileBase>(ProjectileClass, FTransform(Rot, Origin));
+	UProjectileSubsystem* ProjectileSubsystem = WorldContextObject->GetWorld()->GetSubsystem<UProjectileSubsystem>();
+	if (!ProjectileSubsystem) return nullptr;
 
-	Projectile->OverlapEffectSpecs = EffectSpecsOnOverlap;
-
-	Projectile->ActorsToIgnore = InActorsToIgnore;
-	Projectile->bDestroyOnOverlap = bInDestroyOnOverlap;
-
-	Projectile->bCreateZone = bInCreateZone;
-	Projectile->ZoneParams = InZoneParams;
-
-	UGameplayStatics::FinishSpawningActor(Projectile, FTransform(Rot, Origin));
-
-	return Projectile;
-}
-
-void AProjectileBase::BeginPlay()
-{
-	Super::BeginPlay();
-
-	if (!HasAuthority()) return;
-	CollisionComponent->OnComponentBeginOverlap.AddUniqueDynamic(this, &AProjectileBase::OnOverlap);
+	return ProjectileSubsystem->FireProjectile(ProjectileClass, EffectSpecsOnOverlap, Origin, Direction, bInDestroyOnOverlap,
+	                                           InActorsToIgnore, bInCreateZone, InZoneParams);
 }
 
-void AProjectileBase::OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AProjectileBase::SetVisualActive(const bool bActive)
 {
-	if (!HasAuthority()) return;
-	if (ActorsToIgnore.Contains(Other)) return;
-	if (const IAbilitySystemInterface* TargetAscInterface = Cast<IAbilitySystemInterface>(Other))
-	{
-		if (UAbilitySystemComponent* Asc = TargetAscInterface->GetAbilitySystemComponent())
-		{
-			for (FGameplayEffectSpecHandle Spec : OverlapEffectSpecs)
-			{
-				if (!Spec.Data) continue;
-			
-				Spec.Data->GetContext().AddHitResult(SweepResult);
-				Asc->BP_ApplyGameplayEffectSpecToTarget(Spec, Asc);
-			}
-		}
-	}
-	if (bCreateZone)
-	{
-		AZoneBase::SpawnZone(Other, SweepResult.ImpactPoint, ZoneParams);
-	}
-	if (bDestroyOnOverlap) Destroy(true);
+	SetActorHiddenInGame(!bActive);
+	SetActorTickEnabled(bActive);
+	if (bActive) OnVisualActivated();
 }
-
-void AProjectileBase::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (!HasAuthority()) return;
-
-	DespawnTime -= DeltaTime;
-	if (DespawnTime <= 0) Destroy(true);
-}
-
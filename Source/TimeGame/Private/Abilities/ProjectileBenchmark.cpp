@@ -0,0 +1,74 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Abilities/ProjectileBase.h"
+#include "Abilities/ProjectileSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Tg.Benchmark.Projectiles [Count] [Frames] [ProjectileClass]
+ * Fires Count projectiles from random points in a 100m cube, then steps the projectile subsystem Frames times
+ * at 60 fps, reporting the time spent firing and per simulated frame, which is 10000 projectiles by default.
+ * Uses AProjectileBase unless a class path is given. Classes with bNeedsVisualActor also time their visual actors.
+ */
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TgProjectileBenchmark(
+	TEXT("Tg.Benchmark.Projectiles"),
+	TEXT("Time simulating many projectiles. Args: [Count=10000] [Frames=120] [ProjectileClass]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UProjectileSubsystem* Projectiles = World ? World->GetSubsystem<UProjectileSubsystem>() : nullptr;
+		if (!Projectiles || World->GetNetMode() == NM_Client)
+		{
+			Ar.Log(TEXT("Run this in a server or standalone game world."));
+			return;
+		}
+
+		const int32 Count = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 Frames = Args.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 120;
+		TSubclassOf<AProjectileBase> ProjectileClass = AProjectileBase::StaticClass();
+		if (Args.IsValidIndex(2))
+		{
+			ProjectileClass = LoadClass<AProjectileBase>(nullptr, *Args[2]);
+			if (!ProjectileClass)
+			{
+				Ar.Logf(TEXT("%s is not a projectile class."), *Args[2]);
+				return;
+			}
+		}
+
+		//Anything fired before would be counted too.
+		Projectiles->ClearProjectiles();
+
+		FRandomStream Random(Count);
+		const TArray<FGameplayEffectSpecHandle> NoEffects;
+		const TArray<AActor*> NoActorsToIgnore;
+		const double FireStartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			const FVector Origin = Random.GetUnitVector() * Random.FRandRange(0, 5000);
+			Projectiles->FireProjectile(ProjectileClass, NoEffects, Origin, Random.GetUnitVector(), false, NoActorsToIgnore, false, FZoneParams());
+		}
+		const double FireSeconds = FPlatformTime::Seconds() - FireStartTime;
+
+		double WorstFrame = 0;
+		const double SimulateStartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < Frames; Frame++)
+		{
+			const double FrameStartTime = FPlatformTime::Seconds();
+			Projectiles->Tick(1.0f / 60.0f);
+			WorstFrame = FMath::Max(WorstFrame, FPlatformTime::Seconds() - FrameStartTime);
+		}
+		const double SimulateSeconds = FPlatformTime::Seconds() - SimulateStartTime;
+
+		Ar.Logf(TEXT("%d projectiles of %s, %d left after %d frames."), Count, *ProjectileClass->GetName(),
+		        Projectiles->GetProjectileCount(), Frames);
+		Ar.Logf(TEXT("  Firing:     %.3f ms total"), FireSeconds * 1000.0);
+		Ar.Logf(TEXT("  Simulating: %.3f ms per frame, %.3f ms worst"), SimulateSeconds * 1000.0 / Frames, WorstFrame * 1000.0);
+
+		Projectiles->ClearProjectiles();
+	}));
+
+#endif
@@ -0,0 +1,464 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/ProjectileSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "GameplayCueManager.h"
+#include "GameplayEffectAggregator.h"
+#include "Abilities/AscSpatialHashSubsystem.h"
+#include "Abilities/ProjectileBase.h"
+#include "Components/SphereComponent.h"
+#include "Core/TgGameState.h"
+#include "Core/TgPlayerCharacter.h"
+#include "UObject/CoreNet.h"
+
+bool UProjectileSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+	Projectiles.Empty();
+	Payloads.Empty();
+	ProjectileIndexes.Empty();
+	EarlyDespawns.Empty();
+	VisualPool.Empty();
+
+	Super::Deinitialize();
+}
+
+void UProjectileSubsystem::ClearProjectiles()
+{
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; Index--)
+	{
+		RemoveProjectile(Index);
+	}
+}
+
+double UProjectileSubsystem::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
+
+AProjectileBase* UProjectileSubsystem::FireProjectile(const TSubclassOf<AProjectileBase>& ProjectileClass,
+	const TArray<FGameplayEffectSpecHandle>& EffectSpecsOnOverlap, const FVector& Origin, const FVector& Direction,
+	const bool bDestroyOnOverlap, const TArray<AActor*>& ActorsToIgnore, const bool bCreateZone, const FZoneParams& ZoneParams)
+{
+	if (!ProjectileClass) return nullptr;
+
+	const uint32 Id = NextId++;
+
+	//Clients simulate the quantized values they receive, so the server has to simulate the same ones.
+	FVector SpawnOrigin = Origin;
+	FVector SpawnDirection = Direction.GetSafeNormal();
+	const bool bSendEvents = ShouldSendEvents();
+	if (bSendEvents) QuantizeSpawnValues(SpawnOrigin, SpawnDirection);
+
+	const int32 Index = AddProjectile(ProjectileClass, SpawnOrigin, SpawnDirection, Id);
+
+	FProjectilePayload& Payload = Payloads[Index];
+	Payload.EffectSpecs = EffectSpecsOnOverlap;
+	for (AActor* Actor : ActorsToIgnore)
+	{
+		Payload.ActorsToIgnore.Add(Actor);
+	}
+	Payload.bDestroyOnOverlap = bDestroyOnOverlap;
+	Payload.bCreateZone = bCreateZone;
+	Payload.ZoneParams = ZoneParams;
+
+	if (bSendEvents)
+	{
+		FProjectileSpawnEvent& SpawnEvent = PendingSpawnEvents.AddDefaulted_GetRef();
+		SpawnEvent.ProjectileClass = ProjectileClass;
+		SpawnEvent.Origin = SpawnOrigin;
+		SpawnEvent.Direction = SpawnDirection;
+		SpawnEvent.Id = Id;
+		SpawnEvent.ServerSpawnTime = GetServerTime();
+	}
+
+	return Payload.Visual.Get();
+}
+
+void UProjectileSubsystem::ReceiveSpawnEvents(const TArray<FProjectileSpawnEvent>& SpawnEvents)
+{
+	const double ServerTime = GetServerTime();
+	for (const FProjectileSpawnEvent& SpawnEvent : SpawnEvents)
+	{
+		if (!SpawnEvent.ProjectileClass || ProjectileIndexes.Contains(SpawnEvent.Id)) continue;
+		if (EarlyDespawns.Remove(SpawnEvent.Id) > 0) continue;
+
+		//Start where the server's projectile is now, rather than lagging behind it by the latency.
+		const float Age = FMath::Max(0.0, ServerTime - SpawnEvent.ServerSpawnTime);
+		if (Age >= Classes[GetClassIndex(SpawnEvent.ProjectileClass)].Lifetime) continue;
+		AddProjectile(SpawnEvent.ProjectileClass, SpawnEvent.Origin, SpawnEvent.Direction, SpawnEvent.Id, Age);
+	}
+}
+
+void UProjectileSubsystem::ReceiveDespawnEvents(const TArray<uint32>& DespawnEvents)
+{
+	const double Time = GetWorld()->GetTimeSeconds();
+	for (auto It = EarlyDespawns.CreateIterator(); It; ++It)
+	{
+		if (Time - It.Value() > EarlyDespawnMemory) It.RemoveCurrent();
+	}
+
+	for (const uint32 Id : DespawnEvents)
+	{
+		if (const int32* Index = ProjectileIndexes.Find(Id))
+		{
+			RemoveProjectile(*Index);
+		}
+		else
+		{
+			//Either the spawn was dropped or it hasn't arrived yet, in which case it mustn't spawn at all.
+			EarlyDespawns.Add(Id, Time);
+		}
+	}
+}
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Projectiles.Num() == 0 && PendingSpawnEvents.Num() == 0 && PendingDespawnEvents.Num() == 0) return;
+
+	for (FProjectile& Projectile : Projectiles)
+	{
+		Projectile.Age += DeltaTime;
+		Projectile.PreviousLocation = Projectile.Location;
+		UpdateLocation(Projectile);
+	}
+
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		UAscSpatialHashSubsystem* AscHash = GetWorld()->GetSubsystem<UAscSpatialHashSubsystem>();
+		if (AscHash)
+		{
+			AscHash->Update();
+
+			Hits.Reset();
+			for (int32 Index = 0; Index < Projectiles.Num(); Index++)
+			{
+				FindHits(Index, *AscHash);
+			}
+
+			if (Hits.Num() > 0)
+			{
+				FScopedAggregatorOnDirtyBatch AggregatorBatch;
+				FScopedGameplayCueSendContext CueSendContext;
+
+				//Copied, effects can fire more projectiles.
+				const TArray<FProjectileHit> FrameHits = MoveTemp(Hits);
+				for (const FProjectileHit& Hit : FrameHits)
+				{
+					ProcessHit(Hit);
+				}
+			}
+		}
+	}
+
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; Index--)
+	{
+		const FProjectile& Projectile = Projectiles[Index];
+		if (Projectile.Age >= Classes[Projectile.ClassIndex].Lifetime)
+		{
+			//Clients expire projectiles on their own, no event needed.
+			RemoveProjectile(Index);
+			continue;
+		}
+
+		if (AProjectileBase* Visual = Payloads[Index].Visual.Get())
+		{
+			const FVector CurrentVelocity = Projectile.Velocity + FVector(0, 0, Classes[Projectile.ClassIndex].GravityZ * Projectile.Age);
+			Visual->SetActorLocationAndRotation(Projectile.Location, CurrentVelocity.Rotation());
+		}
+	}
+
+	SendEvents();
+}
+
+int32 UProjectileSubsystem::GetClassIndex(UClass* ProjectileClass)
+{
+	const int32 ExistingIndex = Classes.IndexOfByPredicate([ProjectileClass](const FProjectileClass& Class)
+	{
+		return Class.Class == ProjectileClass;
+	});
+	if (ExistingIndex != INDEX_NONE) return ExistingIndex;
+
+	const AProjectileBase* Cdo = ProjectileClass->GetDefaultObject<AProjectileBase>();
+
+	FProjectileClass& NewClass = Classes.AddDefaulted_GetRef();
+	NewClass.Class = ProjectileClass;
+	NewClass.Lifetime = Cdo->DespawnTime;
+	NewClass.bNeedsVisualActor = Cdo->bNeedsVisualActor;
+
+	if (const UProjectileMovementComponent* Movement = Cdo->ProjectileMovementComponent)
+	{
+		NewClass.Speed = Movement->InitialSpeed > 0 ? Movement->InitialSpeed : Movement->MaxSpeed;
+		NewClass.GravityZ = Movement->ProjectileGravityScale * GetWorld()->GetGravityZ();
+	}
+
+	if (const USphereComponent* Sphere = Cast<USphereComponent>(Cdo->CollisionComponent))
+	{
+		NewClass.Radius = Sphere->GetScaledSphereRadius();
+	}
+	else if (Cdo->CollisionComponent)
+	{
+		NewClass.Radius = Cdo->CollisionComponent->CalcBounds(FTransform::Identity).SphereRadius;
+	}
+
+	ClassReferences.Add(ProjectileClass);
+	return Classes.Num() - 1;
+}
+
+int32 UProjectileSubsystem::AddProjectile(UClass* ProjectileClass, const FVector& Origin, const FVector& Direction, uint32 Id, float Age)
+{
+	const int32 ClassIndex = GetClassIndex(ProjectileClass);
+	const FProjectileClass& Class = Classes[ClassIndex];
+
+	FProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Origin = Origin;
+	Projectile.Velocity = Direction.GetSafeNormal() * Class.Speed;
+	Projectile.Age = Age;
+	Projectile.Id = Id;
+	Projectile.ClassIndex = static_cast<uint16>(ClassIndex);
+	UpdateLocation(Projectile);
+	Projectile.PreviousLocation = Projectile.Location;
+
+	FProjectilePayload& Payload = Payloads.AddDefaulted_GetRef();
+	if (Class.bNeedsVisualActor && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		Payload.Visual = AcquireVisual(ProjectileClass, Projectile.Location, Projectile.Velocity.Rotation());
+	}
+
+	const int32 Index = Projectiles.Num() - 1;
+	ProjectileIndexes.Add(Id, Index);
+	return Index;
+}
+
+void UProjectileSubsystem::UpdateLocation(FProjectile& Projectile) const
+{
+	//Closed form, so every machine lands on the same path regardless of frame rate.
+	Projectile.Location = Projectile.Origin + Projectile.Velocity * Projectile.Age
+		+ FVector(0, 0, 0.5f * Classes[Projectile.ClassIndex].GravityZ * Projectile.Age * Projectile.Age);
+}
+
+void UProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+	if (AProjectileBase* Visual = Payloads[Index].Visual.Get())
+	{
+		ReleaseVisual(Visual);
+	}
+
+	ProjectileIndexes.Remove(Projectiles[Index].Id);
+	Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Payloads.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Projectiles.IsValidIndex(Index))
+	{
+		ProjectileIndexes[Projectiles[Index].Id] = Index;
+	}
+}
+
+void UProjectileSubsystem::FindHits(int32 Index, const UAscSpatialHashSubsystem& AscHash)
+{
+	const FProjectile& Projectile = Projectiles[Index];
+	const FProjectilePayload& Payload = Payloads[Index];
+	const float Radius = Classes[Projectile.ClassIndex].Radius;
+
+	FBox Bounds(ForceInit);
+	Bounds += Projectile.PreviousLocation;
+	Bounds += Projectile.Location;
+	Bounds = Bounds.ExpandBy(Radius);
+
+	FProjectileHit FirstHit;
+	float FirstHitDistance = TNumericLimits<float>::Max();
+
+	AscHash.ForEachInBox(Bounds, [&](const UAscSpatialHashSubsystem::FEntry& Entry)
+	{
+		const FVector Closest = FMath::ClosestPointOnSegment(Entry.Location, Projectile.PreviousLocation, Projectile.Location);
+		const float Reach = Radius + Entry.Radius;
+		if (FVector::DistSquared(Closest, Entry.Location) > Reach * Reach) return;
+
+		for (const TWeakObjectPtr<AActor>& IgnoredActor : Payload.ActorsToIgnore)
+		{
+			if (IgnoredActor.Get() == Entry.Avatar) return;
+		}
+		for (const TWeakObjectPtr<const AActor>& HitActor : Payload.HitActors)
+		{
+			if (HitActor.Get() == Entry.Avatar) return;
+		}
+
+		FProjectileHit Hit;
+		Hit.Id = Projectile.Id;
+		Hit.Asc = Entry.Asc;
+		Hit.Avatar = Entry.Avatar;
+		Hit.Normal = (Closest - Entry.Location).GetSafeNormal();
+		Hit.Location = Entry.Location + Hit.Normal * Entry.Radius;
+
+		if (!Payload.bDestroyOnOverlap)
+		{
+			Hits.Add(Hit);
+			return;
+		}
+
+		const float Distance = FVector::DistSquared(Projectile.PreviousLocation, Closest);
+		if (Distance < FirstHitDistance)
+		{
+			FirstHitDistance = Distance;
+			FirstHit = Hit;
+		}
+	});
+
+	if (FirstHit.Asc)
+	{
+		Hits.Add(FirstHit);
+	}
+}
+
+void UProjectileSubsystem::ProcessHit(const FProjectileHit& Hit)
+{
+	const int32* Index = ProjectileIndexes.Find(Hit.Id);
+	if (!Index) return;
+
+	//Copied, applying effects can fire projectiles and move the payloads.
+	FProjectilePayload& Payload = Payloads[*Index];
+	Payload.HitActors.Add(Hit.Avatar);
+	const TArray<FGameplayEffectSpecHandle> EffectSpecs = Payload.EffectSpecs;
+	const bool bDestroyOnOverlap = Payload.bDestroyOnOverlap;
+	const bool bCreateZone = Payload.bCreateZone;
+	const FZoneParams ZoneParams = Payload.ZoneParams;
+
+	if (IsValid(Hit.Asc))
+	{
+		FHitResult HitResult;
+		HitResult.Location = Hit.Location;
+		HitResult.ImpactPoint = Hit.Location;
+		HitResult.Normal = Hit.Normal;
+		HitResult.ImpactNormal = Hit.Normal;
+		HitResult.HitObjectHandle = FActorInstanceHandle(const_cast<AActor*>(Hit.Avatar));
+
+		for (const FGameplayEffectSpecHandle& Spec : EffectSpecs)
+		{
+			if (!Spec.Data) continue;
+
+			Spec.Data->GetContext().AddHitResult(HitResult, true);
+			Hit.Asc->ApplyGameplayEffectSpecToSelf(*Spec.Data.Get());
+		}
+	}
+
+	if (bCreateZone)
+	{
+		AZoneBase::SpawnZone(this, Hit.Location, ZoneParams);
+	}
+
+	if (bDestroyOnOverlap)
+	{
+		if (const int32* CurrentIndex = ProjectileIndexes.Find(Hit.Id))
+		{
+			RemoveProjectile(*CurrentIndex);
+			if (ShouldSendEvents()) PendingDespawnEvents.Add(Hit.Id);
+		}
+	}
+}
+
+AProjectileBase* UProjectileSubsystem::AcquireVisual(UClass* ProjectileClass, const FVector& Location, const FRotator& Rotation)
+{
+	const int32 PooledIndex = VisualPool.IndexOfByPredicate([ProjectileClass](const AProjectileBase* Visual)
+	{
+		return IsValid(Visual) && Visual->GetClass() == ProjectileClass;
+	});
+
+	if (PooledIndex != INDEX_NONE)
+	{
+		AProjectileBase* Visual = VisualPool[PooledIndex];
+		VisualPool.RemoveAtSwap(PooledIndex, 1, EAllowShrinking::No);
+		Visual->SetActorLocationAndRotation(Location, Rotation);
+		Visual->SetVisualActive(true);
+		return Visual;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AProjectileBase* Visual = GetWorld()->SpawnActor<AProjectileBase>(ProjectileClass, Location, Rotation, SpawnParameters);
+	if (Visual)
+	{
+		Visual->SetVisualActive(true);
+	}
+	return Visual;
+}
+
+void UProjectileSubsystem::ReleaseVisual(AProjectileBase* Visual)
+{
+	Visual->SetVisualActive(false);
+	VisualPool.Add(Visual);
+}
+
+bool UProjectileSubsystem::ShouldSendEvents() const
+{
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+void UProjectileSubsystem::QuantizeSpawnValues(FVector& Origin, FVector& Direction)
+{
+	FVector_NetQuantize QuantizedOrigin = Origin;
+	FVector_NetQuantizeNormal QuantizedDirection = Direction;
+
+	bool bSuccess = true;
+	FNetBitWriter Writer(nullptr, 256);
+	QuantizedOrigin.NetSerialize(Writer, nullptr, bSuccess);
+	QuantizedDirection.NetSerialize(Writer, nullptr, bSuccess);
+
+	FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+	QuantizedOrigin.NetSerialize(Reader, nullptr, bSuccess);
+	QuantizedDirection.NetSerialize(Reader, nullptr, bSuccess);
+
+	Origin = QuantizedOrigin;
+	Direction = QuantizedDirection;
+}
+
+void UProjectileSubsystem::SendEvents()
+{
+	if (PendingSpawnEvents.Num() == 0 && PendingDespawnEvents.Num() == 0) return;
+
+	ATgGameState* GameState = GetWorld()->GetGameState<ATgGameState>();
+	if (!GameState)
+	{
+		if (!bWarnedMissingGameState)
+		{
+			UE_LOG(LogTimeGame, Warning, TEXT("Projectiles need a TgGameState to reach clients."));
+			bWarnedMissingGameState = true;
+		}
+		PendingSpawnEvents.Reset();
+		PendingDespawnEvents.Reset();
+		return;
+	}
+
+	TArray<FProjectileSpawnEvent> SpawnChunk;
+	for (int32 Offset = 0; Offset < PendingSpawnEvents.Num(); Offset += MaxEventsPerRpc)
+	{
+		SpawnChunk.Reset();
+		SpawnChunk.Append(PendingSpawnEvents.GetData() + Offset, FMath::Min(MaxEventsPerRpc, PendingSpawnEvents.Num() - Offset));
+		GameState->MulticastProjectileSpawns(SpawnChunk);
+	}
+
+	TArray<uint32> DespawnChunk;
+	for (int32 Offset = 0; Offset < PendingDespawnEvents.Num(); Offset += MaxEventsPerRpc)
+	{
+		DespawnChunk.Reset();
+		DespawnChunk.Append(PendingDespawnEvents.GetData() + Offset, FMath::Min(MaxEventsPerRpc, PendingDespawnEvents.Num() - Offset));
+		GameState->MulticastProjectileDespawns(DespawnChunk);
+	}
+
+	PendingSpawnEvents.Reset();
+	PendingDespawnEvents.Reset();
+}
@@ -3,7 +3,7 @@
 
 #include "Abilities/ZoneBase.h"
 
-#include "AbilitySystemInterface.h"
+#include "Abilities/ZoneSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -13,7 +13,7 @@ FZoneParams::FZoneParams()
 
 AZoneBase::AZoneBase()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	bReplicates = true;
 
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>("SphereComponent");
@@ -21,7 +21,8 @@ AZoneBase::AZoneBase()
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>("StaticMeshComponent");
 	MeshComponent->SetupAttachment(CollisionComponent);
 
-	CollisionComponent->SetGenerateOverlapEvents(true);
+	//Membership is resolved by the UZoneSubsystem instead of overlap events.
+	CollisionComponent->SetGenerateOverlapEvents(false);
 	CollisionComponent->SetNotifyRigidBodyCollision(false);
 
 	MeshComponent->SetGenerateOverlapEvents(false);
@@ -54,53 +55,32 @@ void AZoneBase::BeginPlay()
 {
 	Super::BeginPlay();
 	if (!HasAuthority()) return;
-	CollisionComponent->OnComponentBeginOverlap.AddUniqueDynamic(this, &AZoneBase::OnEnterOverlap);
-	CollisionComponent->OnComponentEndOverlap.AddUniqueDynamic(this, &AZoneBase::OnEndOverlap);
-	PrimaryActorTick.UpdateTickIntervalAndCoolDown(TickInterval);
-}
-
-void AZoneBase::OnEnterOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (!HasAuthority()) return;
-	if (ActorsToIgnore.Contains(Other)) return;
-	if (const IAbilitySystemInterface* TargetAscInterface = Cast<IAbilitySystemInterface>(Other))
+	if (UZoneSubsystem* ZoneSubsystem = GetWorld()->GetSubsystem<UZoneSubsystem>())
 	{
-		if (UAbilitySystemComponent* Asc = TargetAscInterface->GetAbilitySystemComponent())
-		{
-			if (!AscInZone.Contains(Asc)) AscInZone.Add(Asc);
-		}
+		ZoneId = ZoneSubsystem->RegisterZone(this, GetActorLocation(), GetZoneRadius(), OverlapEffectSpecs, ActorsToIgnore,
+		                                     TickInterval, TickCountBeforeDespawn);
 	}
 }
 
-void AZoneBase::OnEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex)
+void AZoneBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (!HasAuthority()) return;
-	if (const IAbilitySystemInterface* TargetAscInterface = Cast<IAbilitySystemInterface>(Other))
+	if (ZoneId != INDEX_NONE)
 	{
-		if (const UAbilitySystemComponent* Asc = TargetAscInterface->GetAbilitySystemComponent())
+		if (UZoneSubsystem* ZoneSubsystem = GetWorld()->GetSubsystem<UZoneSubsystem>())
 		{
-			if (AscInZone.Contains(Asc)) AscInZone.Remove(Asc);
+			ZoneSubsystem->UnregisterZone(this, ZoneId);
 		}
+		ZoneId = INDEX_NONE;
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void AZoneBase::Tick(float DeltaTime)
+float AZoneBase::GetZoneRadius() const
 {
-	Super::Tick(DeltaTime);
-
-	if (!HasAuthority()) return;
-
-	for (UAbilitySystemComponent* Asc : AscInZone)
+	if (const USphereComponent* Sphere = Cast<USphereComponent>(CollisionComponent))
 	{
-		for (FGameplayEffectSpecHandle Spec : OverlapEffectSpecs)
-		{
-			Asc->BP_ApplyGameplayEffectSpecToTarget(Spec, Asc);
-		}
+		return Sphere->GetScaledSphereRadius();
 	}
-	
-	TickCountBeforeDespawn--;
-	if (TickCountBeforeDespawn <= 0) Destroy(true);
+	return CollisionComponent ? CollisionComponent->Bounds.SphereRadius : 0;
 }
-
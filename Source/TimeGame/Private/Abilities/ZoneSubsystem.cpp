@@ -0,0 +1,152 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/ZoneSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "GameplayCueManager.h"
+#include "GameplayEffectAggregator.h"
+#include "Abilities/ZoneBase.h"
+
+bool UZoneSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UZoneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UZoneSubsystem, STATGROUP_Tickables);
+}
+
+int32 UZoneSubsystem::RegisterZone(AZoneBase* Zone, const FVector& Center, float Radius,
+	const TArray<FGameplayEffectSpecHandle>& EffectSpecs, const TArray<AActor*>& ActorsToIgnore, float Interval, int32 PulseCount)
+{
+	const TSharedRef<FZone> NewZone = MakeShared<FZone>();
+	NewZone->Actor = Zone;
+	NewZone->Center = Center;
+	NewZone->Radius = Radius;
+	NewZone->EffectSpecs = EffectSpecs;
+	NewZone->RemainingPulses = PulseCount;
+	for (AActor* Actor : ActorsToIgnore)
+	{
+		NewZone->ActorsToIgnore.Add(Actor);
+	}
+
+	NewZone->Bucket = Buckets.IndexOfByPredicate([Interval](const FBucket& Bucket)
+	{
+		return FMath::IsNearlyEqual(Bucket.Interval, Interval);
+	});
+	if (NewZone->Bucket == INDEX_NONE)
+	{
+		NewZone->Bucket = Buckets.AddDefaulted();
+		Buckets[NewZone->Bucket].Interval = Interval;
+	}
+
+	NewZone->Id = Zones.Add(NewZone);
+	Buckets[NewZone->Bucket].Zones.Add(NewZone->Id);
+	return NewZone->Id;
+}
+
+void UZoneSubsystem::UnregisterZone(const AZoneBase* Zone, int32 ZoneId)
+{
+	//The id may already have been reused if the zone despawned itself.
+	if (!Zones.IsValidIndex(ZoneId) || Zones[ZoneId]->Actor.Get() != Zone) return;
+	RemoveZone(ZoneId);
+}
+
+void UZoneSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Zones.Num() == 0) return;
+
+	TArray<TSharedRef<FZone>, TInlineAllocator<16>> ZonesToPulse;
+	for (FBucket& Bucket : Buckets)
+	{
+		if (Bucket.Zones.Num() == 0) continue;
+
+		//Like an actor tick interval, a bucket pulses at most once per frame.
+		Bucket.Elapsed += DeltaTime;
+		if (Bucket.Elapsed < Bucket.Interval) continue;
+		Bucket.Elapsed = Bucket.Interval > 0 ? FMath::Fmod(Bucket.Elapsed, Bucket.Interval) : 0;
+
+		for (const int32 ZoneId : Bucket.Zones)
+		{
+			ZonesToPulse.Add(Zones[ZoneId]);
+		}
+	}
+
+	if (ZonesToPulse.Num() == 0) return;
+
+	UAscSpatialHashSubsystem* AscHash = GetWorld()->GetSubsystem<UAscSpatialHashSubsystem>();
+	if (!AscHash) return;
+	AscHash->Update();
+
+	{
+		//Gather attribute updates and cues from every zone into one pass.
+		FScopedAggregatorOnDirtyBatch AggregatorBatch;
+		FScopedGameplayCueSendContext CueSendContext;
+
+		for (const TSharedRef<FZone>& Zone : ZonesToPulse)
+		{
+			//Destroyed by an effect of an earlier zone.
+			if (Zone->bRemoved) continue;
+			PulseZone(*Zone, *AscHash);
+		}
+	}
+
+	for (const TSharedRef<FZone>& Zone : ZonesToPulse)
+	{
+		if (Zone->bRemoved || Zone->RemainingPulses > 0) continue;
+
+		RemoveZone(Zone->Id);
+		if (AZoneBase* ZoneActor = Zone->Actor.Get()) ZoneActor->Destroy(true);
+	}
+}
+
+void UZoneSubsystem::PulseZone(FZone& Zone, const UAscSpatialHashSubsystem& AscHash)
+{
+	//Zones can move, be attached or be resized after they registered.
+	if (const AZoneBase* ZoneActor = Zone.Actor.Get())
+	{
+		Zone.Center = ZoneActor->GetActorLocation();
+		Zone.Radius = ZoneActor->GetZoneRadius();
+	}
+
+	const FBox Bounds(Zone.Center - FVector(Zone.Radius), Zone.Center + FVector(Zone.Radius));
+	AscHash.ForEachInBox(Bounds, [this, &Zone](const UAscSpatialHashSubsystem::FEntry& Entry)
+	{
+		ApplyZoneEffects(Zone, Entry);
+	});
+
+	Zone.RemainingPulses--;
+}
+
+void UZoneSubsystem::ApplyZoneEffects(const FZone& Zone, const UAscSpatialHashSubsystem::FEntry& Entry) const
+{
+	const float Reach = Zone.Radius + Entry.Radius;
+	if (FVector::DistSquared(Zone.Center, Entry.Location) > Reach * Reach) return;
+	if (!IsValid(Entry.Asc)) return;
+
+	for (const TWeakObjectPtr<AActor>& IgnoredActor : Zone.ActorsToIgnore)
+	{
+		if (IgnoredActor.Get() == Entry.Avatar) return;
+	}
+
+	for (const FGameplayEffectSpecHandle& Spec : Zone.EffectSpecs)
+	{
+		if (Spec.IsValid())
+		{
+			Entry.Asc->ApplyGameplayEffectSpecToSelf(*Spec.Data.Get());
+		}
+	}
+}
+
+void UZoneSubsystem::RemoveZone(int32 ZoneId)
+{
+	FZone& Zone = *Zones[ZoneId];
+	Zone.bRemoved = true;
+	Buckets[Zone.Bucket].Zones.RemoveSwap(ZoneId, EAllowShrinking::No);
+	Zones.RemoveAt(ZoneId);
+}
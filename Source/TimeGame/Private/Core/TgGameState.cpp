@@ -30,6 +30,27 @@ bool ATgGameState::WorldStateContains(const FGameplayTag Tag) const
 	return WorldStates.Contains(Tag);
 }
 
+void ATgGameState::MulticastProjectileSpawns_Implementation(const TArray<FProjectileSpawnEvent>& SpawnEvents)
+{
+	//The server simulates these already.
+	if (HasAuthority()) return;
+
+	if (UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		ProjectileSubsystem->ReceiveSpawnEvents(SpawnEvents);
+	}
+}
+
+void ATgGameState::MulticastProjectileDespawns_Implementation(const TArray<uint32>& DespawnEvents)
+{
+	if (HasAuthority()) return;
+
+	if (UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		ProjectileSubsystem->ReceiveDespawnEvents(DespawnEvents);
+	}
+}
+
 const ATgAiCharacter* ATgGameState::GetAiCharacterByNameTag(const FGameplayTag NameTag) const
 {
 	if (AiCharacterRegistry.Contains(NameTag))
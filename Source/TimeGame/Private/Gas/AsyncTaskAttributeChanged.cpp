@@ -2,6 +2,8 @@
 
 #include "Gas/AsyncTaskAttributeChanged.h"
 
+#include "Gas/TgAttributeObserverSubsystem.h"
+
 UAsyncTaskAttributeChanged* UAsyncTaskAttributeChanged::ListenForAttributeChange(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAttribute Attribute)
 {
 	UAsyncTaskAttributeChanged* WaitForAttributeChangedTask = NewObject<UAsyncTaskAttributeChanged>();
@@ -14,7 +16,7 @@ UAsyncTaskAttributeChanged* UAsyncTaskAttributeChanged::ListenForAttributeChange
 		return nullptr;
 	}
 
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(WaitForAttributeChangedTask, &UAsyncTaskAttributeChanged::AttributeChanged);
+	WaitForAttributeChangedTask->Observe(Attribute);
 
 	return WaitForAttributeChangedTask;
 }
@@ -33,7 +35,7 @@ UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChan
 
 	for (FGameplayAttribute Attribute : Attributes)
 	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(WaitForAttributeChangedTask, &UAsyncTaskAttributeChanged::AttributeChanged);
+		WaitForAttributeChangedTask->Observe(Attribute);
 	}
 
 	return WaitForAttributeChangedTask;
@@ -41,21 +43,26 @@ UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChan
 
 void UAsyncTaskAttributeChanged::EndTask()
 {
-	if (IsValid(ASC))
+	if (UTgAttributeObserverSubsystem* Observer = UTgAttributeObserverSubsystem::Get(ASC))
 	{
-		ASC->GetGameplayAttributeValueChangeDelegate(AttributeToListenFor).RemoveAll(this);
-
-		for (FGameplayAttribute Attribute : AttributesToListenFor)
-		{
-			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
-		}
+		Observer->StopObserving(this);
 	}
 
 	SetReadyToDestroy();
 	MarkAsGarbage();
 }
 
-void UAsyncTaskAttributeChanged::AttributeChanged(const FOnAttributeChangeData & Data)
+void UAsyncTaskAttributeChanged::AttributeChanged(FGameplayAttribute Attribute, float NewValue, float OldValue)
+{
+	OnAttributeChanged.Broadcast(Attribute, NewValue, OldValue);
+}
+
+void UAsyncTaskAttributeChanged::Observe(FGameplayAttribute Attribute)
 {
-	OnAttributeChanged.Broadcast(Data.Attribute, Data.NewValue, Data.OldValue);
+	UTgAttributeObserverSubsystem* Observer = UTgAttributeObserverSubsystem::Get(ASC);
+	if (!Observer) return;
+
+	FTgObservedAttributeChanged OnChanged;
+	OnChanged.BindDynamic(this, &UAsyncTaskAttributeChanged::AttributeChanged);
+	Observer->ObserveAttribute(ASC, Attribute, OnChanged);
 }
\ No newline at end of file
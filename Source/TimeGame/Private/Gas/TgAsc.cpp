@@ -2,7 +2,56 @@
 
 #include "TimeGame/Public/Gas/TgAsc.h"
 
+#include "Abilities/AscSpatialHashSubsystem.h"
 #include "Core/TgPlayerCharacter.h"
+#include "TimeGame/Public/Gas/TgLifestealEffect.h"
+#include "TimeGame/Public/Gas/TgRegenSubsystem.h"
+
+void FTgCombatEventBatch::Add(const FTgCombatEvent& Event)
+{
+	Events.Add(Event);
+	if (Event.Type == ETgCombatEventType::Damage)
+	{
+		ShieldDamage += Event.ShieldAmount;
+		HealthDamage += Event.HealthAmount;
+	}
+	else
+	{
+		Healing += Event.HealthAmount;
+	}
+}
+
+void FTgCombatEventBatch::Reset()
+{
+	//Keep the allocation, the next frame likely has as many events.
+	Events.Reset();
+	ShieldDamage = 0;
+	HealthDamage = 0;
+	Healing = 0;
+}
+
+bool FTgCombatSummary::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 Values[] = {
+		static_cast<uint32>(FMath::Max(Hits, 0)), static_cast<uint32>(FMath::Max(ShieldDamage, 0)),
+		static_cast<uint32>(FMath::Max(HealthDamage, 0)), static_cast<uint32>(FMath::Max(Healing, 0))
+	};
+	for (uint32& Value : Values)
+	{
+		Ar.SerializeIntPacked(Value);
+	}
+
+	if (Ar.IsLoading())
+	{
+		Hits = static_cast<int32>(Values[0]);
+		ShieldDamage = static_cast<int32>(Values[1]);
+		HealthDamage = static_cast<int32>(Values[2]);
+		Healing = static_cast<int32>(Values[3]);
+	}
+
+	bOutSuccess = true;
+	return true;
+}
 
 UTgAsc::UTgAsc()
 {
@@ -14,6 +63,31 @@ void UTgAsc::BeginPlay()
 
 	if (!GetOwner()->HasAuthority()) return;
 	OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UTgAsc::OnServerActiveGameplayEffectAdded);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UTgAsc::OnServerActiveGameplayEffectRemoved);
+
+	if (UAscSpatialHashSubsystem* AscHash = GetWorld()->GetSubsystem<UAscSpatialHashSubsystem>())
+	{
+		AscHash->RegisterAsc(this);
+	}
+	if (UTgRegenSubsystem* Regen = GetWorld()->GetSubsystem<UTgRegenSubsystem>())
+	{
+		Regen->RegisterAsc(this);
+	}
+}
+
+void UTgAsc::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAscSpatialHashSubsystem* AscHash = GetWorld()->GetSubsystem<UAscSpatialHashSubsystem>())
+	{
+		AscHash->UnregisterAsc(this);
+	}
+	if (UTgRegenSubsystem* Regen = GetWorld()->GetSubsystem<UTgRegenSubsystem>())
+	{
+		Regen->UnregisterAsc(this);
+	}
+	SelectedEffects.Empty();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UTgAsc::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -24,7 +98,16 @@ void UTgAsc::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponent
 void UTgAsc::BroadcastReceiveDamage(UAbilitySystemComponent* Source, const float ProcessedShieldDamage,
 	const float ProcessedHealthDamage, const float OriginalDamage)
 {
-	if (OnReceiveDamage.IsBound())
+	FTgCombatEvent Event;
+	Event.Source = Source;
+	Event.Target = this;
+	Event.Type = ETgCombatEventType::Damage;
+	Event.ShieldAmount = ProcessedShieldDamage;
+	Event.HealthAmount = ProcessedHealthDamage;
+	Event.OriginalAmount = OriginalDamage;
+	RecordCombatEvent(Event);
+
+	if (bBroadcastPerHitEvents && OnReceiveDamage.IsBound())
 	{
 		OnReceiveDamage.Broadcast(Source, ProcessedShieldDamage, ProcessedHealthDamage, OriginalDamage);
 	}
@@ -33,12 +116,126 @@ void UTgAsc::BroadcastReceiveDamage(UAbilitySystemComponent* Source, const float
 void UTgAsc::BroadcastReceiveHealing(UAbilitySystemComponent* Source, const float ProcessedHealing,
 	const float OriginalHealing)
 {
-	if (OnReceiveHealing.IsBound())
+	FTgCombatEvent Event;
+	Event.Source = Source;
+	Event.Target = this;
+	Event.Type = ETgCombatEventType::Healing;
+	Event.HealthAmount = ProcessedHealing;
+	Event.OriginalAmount = OriginalHealing;
+	RecordCombatEvent(Event);
+
+	if (bBroadcastPerHitEvents && OnReceiveHealing.IsBound())
 	{
 		OnReceiveHealing.Broadcast(Source, ProcessedHealing, OriginalHealing);
 	}
 }
 
+void UTgAsc::AddPendingLifesteal(const float ProcessedHealing, const float OriginalHealing)
+{
+	PendingLifesteal += ProcessedHealing;
+	PendingOriginalLifesteal += OriginalHealing;
+
+	if (!LifestealTimerHandle.IsValid())
+	{
+		LifestealTimerHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTgAsc::ApplyPendingLifesteal);
+	}
+}
+
+void UTgAsc::ApplyPendingLifesteal()
+{
+	LifestealTimerHandle.Invalidate();
+
+	const float ProcessedHealing = PendingLifesteal;
+	const float OriginalHealing = PendingOriginalLifesteal;
+	PendingLifesteal = 0;
+	PendingOriginalLifesteal = 0;
+
+	if (OriginalHealing <= 0) return;
+
+	FGameplayEffectSpec Spec(GetDefault<UTgLifestealEffect>(), MakeEffectContext(), 1.0f);
+	Spec.SetSetByCallerMagnitude(UTgLifestealEffect::HealingDataName, ProcessedHealing);
+	ApplyGameplayEffectSpecToSelf(Spec);
+
+	BroadcastReceiveHealing(this, ProcessedHealing, OriginalHealing);
+}
+
+TArray<FTgCombatEvent> UTgAsc::GetCombatLog() const
+{
+	//Oldest first. The head is only past zero once the buffer wrapped.
+	TArray<FTgCombatEvent> OrderedLog;
+	OrderedLog.Reserve(CombatLog.Num());
+	OrderedLog.Append(CombatLog.GetData() + CombatLogHead, CombatLog.Num() - CombatLogHead);
+	OrderedLog.Append(CombatLog.GetData(), CombatLogHead);
+	return OrderedLog;
+}
+
+void UTgAsc::RecordCombatEvent(const FTgCombatEvent& Event)
+{
+	FTgCombatEvent Recorded = Event;
+	Recorded.Time = GetWorld()->GetTimeSeconds();
+	PendingCombatEvents.Add(Recorded);
+
+	if (CombatLogCapacity > 0)
+	{
+		if (CombatLog.Num() != CombatLogCapacity && CombatLogHead != 0)
+		{
+			//Capacity was changed at runtime after the buffer wrapped, unroll it so appending stays in order.
+			CombatLog = GetCombatLog();
+			CombatLogHead = 0;
+		}
+		if (CombatLog.Num() > CombatLogCapacity)
+		{
+			//Capacity was lowered, keep the most recent events.
+			CombatLog.RemoveAt(0, CombatLog.Num() - CombatLogCapacity);
+		}
+
+		if (CombatLog.Num() < CombatLogCapacity)
+		{
+			CombatLog.Add(Recorded);
+		}
+		else
+		{
+			CombatLog[CombatLogHead] = Recorded;
+			CombatLogHead = (CombatLogHead + 1) % CombatLogCapacity;
+		}
+	}
+
+	if (!CombatEventsTimerHandle.IsValid())
+	{
+		CombatEventsTimerHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTgAsc::PublishCombatEvents);
+	}
+}
+
+void UTgAsc::PublishCombatEvents()
+{
+	CombatEventsTimerHandle.Invalidate();
+
+	if (OnCombatEvents.IsBound())
+	{
+		OnCombatEvents.Broadcast(PendingCombatEvents);
+	}
+
+	if (bReplicateCombatSummary && GetOwner()->HasAuthority() && GetNetMode() != NM_Standalone)
+	{
+		FTgCombatSummary Summary;
+		Summary.Hits = PendingCombatEvents.Events.Num();
+		Summary.ShieldDamage = FMath::RoundToInt(PendingCombatEvents.ShieldDamage);
+		Summary.HealthDamage = FMath::RoundToInt(PendingCombatEvents.HealthDamage);
+		Summary.Healing = FMath::RoundToInt(PendingCombatEvents.Healing);
+		MulticastCombatSummary(Summary);
+	}
+
+	PendingCombatEvents.Reset();
+}
+
+void UTgAsc::MulticastCombatSummary_Implementation(const FTgCombatSummary& Summary)
+{
+	if (OnCombatSummary.IsBound())
+	{
+		OnCombatSummary.Broadcast(Summary);
+	}
+}
+
 void UTgAsc::PerformOnHit(UAbilitySystemComponent* Target)
 {
 	if (OnHitRegistry.IsBound())
@@ -48,33 +245,59 @@ void UTgAsc::PerformOnHit(UAbilitySystemComponent* Target)
 }
 
 void UTgAsc::OnServerActiveGameplayEffectAdded(UAbilitySystemComponent* Asc, const FGameplayEffectSpec& Spec,
-	FActiveGameplayEffectHandle EffectHandle) const
+	FActiveGameplayEffectHandle EffectHandle)
 {
 	if (!Spec.Def) return;
 	if (Spec.Def->StackingType != EGameplayEffectStackingType::None) return;
 
-	FGameplayEffectQuery Query = FGameplayEffectQuery();
-	Query.EffectDefinition = Spec.Def.GetClass();
-	
-	TArray<FActiveGameplayEffectHandle> FoundEffects = Asc->GetActiveEffects(Query);
-	if (FoundEffects.Num() <= 1) return;
+	UAbilitySystemComponent* Instigator = Spec.GetContext().GetOriginalInstigatorAbilitySystemComponent();
+	FSelectedEffect* Selected = SelectedEffects.Find(Spec.Def->GetClass());
+	if (!Selected || !GetActiveGameplayEffect(Selected->Handle))
+	{
+		SelectedEffects.Add(Spec.Def->GetClass(), {EffectHandle, Instigator});
+		return;
+	}
+
 	if (!EffectSelectionAttribute.IsValid())
 	{
 		UE_LOG(LogTimeGame, Error, TEXT("EffectSelectionAttribute must be set in the TgAsc."));
 		return;
 	}
-	FGameplayAttribute ScopedEffectSelectionAttribute = EffectSelectionAttribute;
-	FoundEffects.Sort([Asc, ScopedEffectSelectionAttribute](const FActiveGameplayEffectHandle& A, const FActiveGameplayEffectHandle& B)
+
+	//Newer instances win ties, refreshing the effect.
+	if (GetEffectSelectionValue(Instigator) >= GetEffectSelectionValue(Selected->Instigator.Get()))
 	{
-		//Compare the attribute given by the editor.
-		const float ValueA = Asc->GetActiveGameplayEffect(A)->Spec.GetContext().GetOriginalInstigatorAbilitySystemComponent()->GetNumericAttribute(ScopedEffectSelectionAttribute);
-		const float ValueB = Asc->GetActiveGameplayEffect(B)->Spec.GetContext().GetOriginalInstigatorAbilitySystemComponent()->GetNumericAttribute(ScopedEffectSelectionAttribute);
-		return ValueA < ValueB;
-	});
-	FoundEffects.RemoveAt(FoundEffects.Num() - 1, 1, false);
-	for (const FActiveGameplayEffectHandle& FoundEffectHandle : FoundEffects)
+		const FActiveGameplayEffectHandle ReplacedHandle = Selected->Handle;
+		Selected->Handle = EffectHandle;
+		Selected->Instigator = Instigator;
+		RemoveActiveGameplayEffect(ReplacedHandle);
+	}
+	else
 	{
-		Asc->RemoveActiveGameplayEffect(FoundEffectHandle);
+		RemoveActiveGameplayEffect(EffectHandle);
 	}
 }
 
+void UTgAsc::OnServerActiveGameplayEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	if (!Effect.Spec.Def) return;
+
+	const TObjectKey<UClass> EffectClass = Effect.Spec.Def->GetClass();
+	const FSelectedEffect* Selected = SelectedEffects.Find(EffectClass);
+	if (Selected && Selected->Handle == Effect.Handle)
+	{
+		SelectedEffects.Remove(EffectClass);
+	}
+}
+
+FActiveGameplayEffectHandle UTgAsc::GetSelectedEffect(const UClass* EffectClass) const
+{
+	const FSelectedEffect* Selected = SelectedEffects.Find(EffectClass);
+	return Selected ? Selected->Handle : FActiveGameplayEffectHandle();
+}
+
+float UTgAsc::GetEffectSelectionValue(const UAbilitySystemComponent* Instigator) const
+{
+	//Read when contested rather than cached, so it's always the instigator's current value.
+	return Instigator ? Instigator->GetNumericAttribute(EffectSelectionAttribute) : TNumericLimits<float>::Lowest();
+}
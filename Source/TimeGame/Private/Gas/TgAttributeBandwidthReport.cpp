@@ -0,0 +1,68 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/CoreNet.h"
+#include "UObject/UObjectIterator.h"
+#include "TimeGame/Public/Gas/TgAttributeReplication.h"
+#include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Tg.Net.AttributeBandwidth [Players]
+ * Estimates the bytes a full update of each character's attributes costs the server across all connections,
+ * before replication policies (every attribute as two floats to every player) and with the current policies.
+ * Uses the current values of the attribute sets in the world, so run it during a match.
+ * Property handles and packet headers are the same either way and aren't counted.
+ * Changes smaller than an attribute's precision aren't sent at all, which this doesn't include.
+ */
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TgAttributeBandwidthReport(
+	TEXT("Tg.Net.AttributeBandwidth"),
+	TEXT("Estimate replicated bytes per character before and after attribute replication policies. Args: [Players=64]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 Players = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+		const UTgAttributeReplicationSettings* Settings = GetDefault<UTgAttributeReplicationSettings>();
+
+		int32 CharacterCount = 0;
+		int64 BaselineBits = 0;
+		int64 PolicyBits = 0;
+		for (TObjectIterator<UTgCreatureAttributeSet> It; It; ++It)
+		{
+			UTgCreatureAttributeSet* AttributeSet = *It;
+			if (AttributeSet->IsTemplate() || AttributeSet->GetWorld() != World) continue;
+			CharacterCount++;
+
+			for (TFieldIterator<FStructProperty> PropertyIt(AttributeSet->GetClass()); PropertyIt; ++PropertyIt)
+			{
+				if (!PropertyIt->HasAnyPropertyFlags(CPF_Net) || !PropertyIt->Struct->IsChildOf(FTgAttributeData::StaticStruct())) continue;
+
+				FTgAttributeData Data = *PropertyIt->ContainerPtrToValuePtr<FTgAttributeData>(AttributeSet);
+				FNetBitWriter Writer(128);
+				bool bSuccess = true;
+				Data.NetSerialize(Writer, nullptr, bSuccess);
+
+				const FTgAttributeReplicationPolicy* Policy = Settings->FindPolicy(FGameplayAttribute(*PropertyIt));
+				const int32 Receivers = Policy && Policy->bOwnerOnly ? 1 : Players;
+				BaselineBits += 2 * 32 * Players;
+				PolicyBits += Writer.GetNumBits() * Receivers;
+			}
+		}
+
+		if (CharacterCount == 0)
+		{
+			Ar.Log(TEXT("No attribute sets in this world. Run this during a match."));
+			return;
+		}
+
+		const double BaselineBytes = BaselineBits / 8.0 / CharacterCount;
+		const double PolicyBytes = PolicyBits / 8.0 / CharacterCount;
+		Ar.Logf(TEXT("Full attribute update per character to %d players, averaged over %d characters:"), Players, CharacterCount);
+		Ar.Logf(TEXT("  Before policies: %.0f bytes"), BaselineBytes);
+		Ar.Logf(TEXT("  With policies:   %.0f bytes (%.0f%%)"), PolicyBytes, BaselineBytes > 0 ? PolicyBytes * 100.0 / BaselineBytes : 0.0);
+		Ar.Logf(TEXT("  Whole match:     %.1f KB before, %.1f KB with policies"), BaselineBytes * Players / 1024.0, PolicyBytes * Players / 1024.0);
+	}));
+
+#endif
@@ -0,0 +1,174 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TimeGame/Public/Gas/TgAttributeObserverSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+bool UTgAttributeObserverSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UTgAttributeObserverSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTgAttributeObserverSubsystem, STATGROUP_Tickables);
+}
+
+void UTgAttributeObserverSubsystem::Deinitialize()
+{
+	for (auto It = Observed.CreateIterator(); It; ++It)
+	{
+		if (UAbilitySystemComponent* Asc = It->Asc.Get())
+		{
+			Asc->GetGameplayAttributeValueChangeDelegate(It->Attribute).Remove(It->ChangeHandle);
+		}
+	}
+	Observed.Empty();
+	ObservedIds.Empty();
+	DirtyIds.Empty();
+
+	Super::Deinitialize();
+}
+
+UTgAttributeObserverSubsystem* UTgAttributeObserverSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = WorldContext ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTgAttributeObserverSubsystem>() : nullptr;
+}
+
+void UTgAttributeObserverSubsystem::ObserveAttribute(UAbilitySystemComponent* Asc, FGameplayAttribute Attribute,
+	FTgObservedAttributeChanged OnChanged, float MinInterval)
+{
+	if (!IsValid(Asc) || !Attribute.IsValid() || !OnChanged.IsBound()) return;
+
+	const TPair<TObjectKey<UAbilitySystemComponent>, FGameplayAttribute> Key(Asc, Attribute);
+	int32 ObservedId = INDEX_NONE;
+	if (const int32* FoundId = ObservedIds.Find(Key))
+	{
+		ObservedId = *FoundId;
+	}
+	else
+	{
+		ObservedId = Observed.Add(FObservedAttribute());
+		FObservedAttribute& NewObserved = Observed[ObservedId];
+		NewObserved.Asc = Asc;
+		NewObserved.AscKey = Asc;
+		NewObserved.Attribute = Attribute;
+		NewObserved.Value = Asc->GetNumericAttribute(Attribute);
+		NewObserved.ChangeHandle = Asc->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(
+			this, &UTgAttributeObserverSubsystem::OnAttributeChanged, ObservedId);
+		ObservedIds.Add(Key, ObservedId);
+	}
+
+	FObservedAttribute& Entry = Observed[ObservedId];
+	FListener& Listener = Entry.Listeners.AddDefaulted_GetRef();
+	Listener.OnChanged = OnChanged;
+	Listener.MinInterval = FMath::Max(MinInterval, 0.0f);
+	Listener.NotifiedValue = Entry.Value;
+}
+
+void UTgAttributeObserverSubsystem::StopObserving(const UObject* Listener)
+{
+	if (!Listener) return;
+
+	//Only unbound here, the listeners may be in the middle of being notified.
+	for (auto It = Observed.CreateIterator(); It; ++It)
+	{
+		for (FListener& CurrentListener : It->Listeners)
+		{
+			if (CurrentListener.OnChanged.GetUObject() != Listener) continue;
+			CurrentListener.OnChanged.Unbind();
+			MarkDirty(It.GetIndex());
+		}
+	}
+}
+
+void UTgAttributeObserverSubsystem::OnAttributeChanged(const FOnAttributeChangeData& Data, int32 ObservedId)
+{
+	Observed[ObservedId].Value = Data.NewValue;
+	MarkDirty(ObservedId);
+}
+
+void UTgAttributeObserverSubsystem::MarkDirty(int32 ObservedId)
+{
+	FObservedAttribute& Entry = Observed[ObservedId];
+	if (Entry.bDirty) return;
+	Entry.bDirty = true;
+	DirtyIds.Add(ObservedId);
+}
+
+void UTgAttributeObserverSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (DirtyIds.Num() == 0) return;
+
+	//Listeners can change attributes when notified, which is picked up next frame.
+	const TArray<int32> IdsToNotify = MoveTemp(DirtyIds);
+
+	const double Time = GetWorld()->GetRealTimeSeconds();
+	for (const int32 ObservedId : IdsToNotify)
+	{
+		if (!Observed.IsValidIndex(ObservedId)) continue;
+		Observed[ObservedId].bDirty = false;
+
+		if (Notify(ObservedId, Time))
+		{
+			MarkDirty(ObservedId);
+		}
+	}
+}
+
+bool UTgAttributeObserverSubsystem::Notify(int32 ObservedId, double Time)
+{
+	bool bWaiting = false;
+
+	//Looked up again after every notification, as listeners can observe more attributes from it.
+	for (int32 Index = 0; Index < Observed[ObservedId].Listeners.Num(); Index++)
+	{
+		FObservedAttribute& Entry = Observed[ObservedId];
+		FListener& Listener = Entry.Listeners[Index];
+		if (!Listener.OnChanged.IsBound() || Listener.NotifiedValue == Entry.Value) continue;
+
+		if (Time < Listener.NextNotifyTime)
+		{
+			bWaiting = true;
+			continue;
+		}
+
+		const FGameplayAttribute Attribute = Entry.Attribute;
+		const float OldValue = Listener.NotifiedValue;
+		const float NewValue = Entry.Value;
+		const FTgObservedAttributeChanged OnChanged = Listener.OnChanged;
+		Listener.NotifiedValue = NewValue;
+		Listener.NextNotifyTime = Time + Listener.MinInterval;
+		OnChanged.ExecuteIfBound(Attribute, NewValue, OldValue);
+	}
+
+	FObservedAttribute& Entry = Observed[ObservedId];
+	Entry.Listeners.RemoveAll([](const FListener& Listener)
+	{
+		return !Listener.OnChanged.IsBound();
+	});
+	if (Entry.Listeners.Num() == 0 || !Entry.Asc.IsValid())
+	{
+		RemoveObserved(ObservedId);
+		return false;
+	}
+	return bWaiting;
+}
+
+void UTgAttributeObserverSubsystem::RemoveObserved(int32 ObservedId)
+{
+	FObservedAttribute& Entry = Observed[ObservedId];
+	if (UAbilitySystemComponent* Asc = Entry.Asc.Get())
+	{
+		Asc->GetGameplayAttributeValueChangeDelegate(Entry.Attribute).Remove(Entry.ChangeHandle);
+	}
+	ObservedIds.Remove(TPair<TObjectKey<UAbilitySystemComponent>, FGameplayAttribute>(Entry.AscKey, Entry.Attribute));
+	Observed.RemoveAt(ObservedId);
+}
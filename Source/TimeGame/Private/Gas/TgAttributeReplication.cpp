@@ -0,0 +1,105 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TimeGame/Public/Gas/TgAttributeReplication.h"
+
+#include "Core/TgPlayerCharacter.h"
+
+bool FTgAttributeData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	float Base = GetBaseValue();
+	float Current = GetCurrentValue();
+	SerializeValue(Ar, Base);
+	SerializeValue(Ar, Current);
+
+	if (Ar.IsLoading())
+	{
+		SetBaseValue(Base);
+		SetCurrentValue(Current);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FTgAttributeData::Identical(const FTgAttributeData* Other, uint32 PortFlags) const
+{
+	return Quantize(GetBaseValue()) == Quantize(Other->GetBaseValue())
+		&& Quantize(GetCurrentValue()) == Quantize(Other->GetCurrentValue());
+}
+
+void FTgAttributeData::SerializeValue(FArchive& Ar, float& Value) const
+{
+	//Values too large to count in steps are sent as floats.
+	uint8 bQuantized = 0;
+	int32 Steps = 0;
+	if (Ar.IsSaving() && Precision > 0)
+	{
+		const double RoundedSteps = FMath::RoundToDouble(Value / Precision);
+		if (FMath::Abs(RoundedSteps) < MAX_int32)
+		{
+			bQuantized = 1;
+			Steps = static_cast<int32>(RoundedSteps);
+		}
+	}
+	Ar.SerializeBits(&bQuantized, 1);
+
+	if (!bQuantized)
+	{
+		Ar << Value;
+		return;
+	}
+
+	//Zigzag encoded so small negative values stay small when packed.
+	uint32 PackedSteps = (static_cast<uint32>(Steps) << 1) ^ static_cast<uint32>(Steps >> 31);
+	Ar.SerializeIntPacked(PackedSteps);
+	if (Ar.IsLoading())
+	{
+		Steps = static_cast<int32>(PackedSteps >> 1) ^ -static_cast<int32>(PackedSteps & 1);
+		Value = Steps * Precision;
+	}
+}
+
+float FTgAttributeData::Quantize(float Value) const
+{
+	return Precision > 0 ? FMath::RoundToFloat(Value / Precision) * Precision : Value;
+}
+
+const FTgAttributeReplicationPolicy* UTgAttributeReplicationSettings::FindPolicy(const FGameplayAttribute& Attribute) const
+{
+	return Policies.FindByPredicate([&Attribute](const FTgAttributeReplicationPolicy& Policy)
+	{
+		return Policy.Attribute == Attribute;
+	});
+}
+
+FDoRepLifetimeParams UTgAttributeReplicationSettings::GetReplicationParams(const FGameplayAttribute& Attribute) const
+{
+	FDoRepLifetimeParams Params;
+	Params.Condition = COND_None;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
+
+	if (const FTgAttributeReplicationPolicy* Policy = FindPolicy(Attribute))
+	{
+		Params.Condition = Policy->bOwnerOnly ? COND_OwnerOnly : COND_None;
+		Params.RepNotifyCondition = Policy->bNotifyOnlyOnChange ? REPNOTIFY_OnChanged : REPNOTIFY_Always;
+	}
+	return Params;
+}
+
+void UTgAttributeReplicationSettings::ApplyPrecision(UAttributeSet* AttributeSet) const
+{
+	for (const FTgAttributeReplicationPolicy& Policy : Policies)
+	{
+		if (Policy.Precision <= 0 || !Policy.Attribute.IsValid()) continue;
+		if (!AttributeSet->IsA(Policy.Attribute.GetAttributeSetClass())) continue;
+
+		const FStructProperty* Property = CastField<FStructProperty>(Policy.Attribute.GetUProperty());
+		if (!Property || !Property->Struct->IsChildOf(FTgAttributeData::StaticStruct()))
+		{
+			UE_LOG(LogTimeGame, Error, TEXT("%s can't be quantized as it isn't an FTgAttributeData."), *Policy.Attribute.GetName());
+			continue;
+		}
+		Property->ContainerPtrToValuePtr<FTgAttributeData>(AttributeSet)->Precision = Policy.Precision;
+	}
+}
@@ -4,33 +4,43 @@
 
 #include "Net/UnrealNetwork.h"
 
+void UTgCreatureAttributeSet::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	GetDefault<UTgAttributeReplicationSettings>()->ApplyPrecision(this);
+}
+
 void UTgCreatureAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, HealthRegen, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Energy, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, MaxEnergy, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, EnergyRegen, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Shield, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Ingenuity, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Intelligence, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Arcane, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Telekinesis, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, CooldownReduction, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, PhysicalArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, FireArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, FrostArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, ElectricalArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, AlchemicalArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, MagicalArmor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, Lifesteal, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, MovementSpeed, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, HealMultiplier, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, DamageOutgoingMultiplier, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UTgCreatureAttributeSet, DamageIncomingMultiplier, COND_None, REPNOTIFY_Always);
+	//Owner only, notify and precision per attribute are set in the project settings.
+	const UTgAttributeReplicationSettings* Settings = GetDefault<UTgAttributeReplicationSettings>();
+
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Health, Settings->GetReplicationParams(GetHealthAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, MaxHealth, Settings->GetReplicationParams(GetMaxHealthAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, HealthRegen, Settings->GetReplicationParams(GetHealthRegenAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Energy, Settings->GetReplicationParams(GetEnergyAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, MaxEnergy, Settings->GetReplicationParams(GetMaxEnergyAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, EnergyRegen, Settings->GetReplicationParams(GetEnergyRegenAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Shield, Settings->GetReplicationParams(GetShieldAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Ingenuity, Settings->GetReplicationParams(GetIngenuityAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Intelligence, Settings->GetReplicationParams(GetIntelligenceAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Arcane, Settings->GetReplicationParams(GetArcaneAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Telekinesis, Settings->GetReplicationParams(GetTelekinesisAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, CooldownReduction, Settings->GetReplicationParams(GetCooldownReductionAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, PhysicalArmor, Settings->GetReplicationParams(GetPhysicalArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, FireArmor, Settings->GetReplicationParams(GetFireArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, FrostArmor, Settings->GetReplicationParams(GetFrostArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, ElectricalArmor, Settings->GetReplicationParams(GetElectricalArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, AlchemicalArmor, Settings->GetReplicationParams(GetAlchemicalArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, MagicalArmor, Settings->GetReplicationParams(GetMagicalArmorAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, Lifesteal, Settings->GetReplicationParams(GetLifestealAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, MovementSpeed, Settings->GetReplicationParams(GetMovementSpeedAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, HealMultiplier, Settings->GetReplicationParams(GetHealMultiplierAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, DamageOutgoingMultiplier, Settings->GetReplicationParams(GetDamageOutgoingMultiplierAttribute()));
+	DOREPLIFETIME_WITH_PARAMS(UTgCreatureAttributeSet, DamageIncomingMultiplier, Settings->GetReplicationParams(GetDamageIncomingMultiplierAttribute()));
 }
 
 void UTgCreatureAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
@@ -108,117 +118,117 @@ void UTgCreatureAttributeSet::PreAttributeChange(const FGameplayAttribute& Attri
 	}
 }
 
-void UTgCreatureAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
+void UTgCreatureAttributeSet::OnRep_Health(const FTgAttributeData& OldHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Health, OldHealth);
 }
 
-void UTgCreatureAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
+void UTgCreatureAttributeSet::OnRep_MaxHealth(const FTgAttributeData& OldMaxHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, MaxHealth, OldMaxHealth);
 }
 
-void UTgCreatureAttributeSet::OnRep_HealthRegen(const FGameplayAttributeData& OldHealthRegen)
+void UTgCreatureAttributeSet::OnRep_HealthRegen(const FTgAttributeData& OldHealthRegen)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, HealthRegen, OldHealthRegen);
 }
 
-void UTgCreatureAttributeSet::OnRep_Energy(const FGameplayAttributeData& OldEnergy)
+void UTgCreatureAttributeSet::OnRep_Energy(const FTgAttributeData& OldEnergy)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Energy, OldEnergy);
 }
 
-void UTgCreatureAttributeSet::OnRep_MaxEnergy(const FGameplayAttributeData& OldMaxEnergy)
+void UTgCreatureAttributeSet::OnRep_MaxEnergy(const FTgAttributeData& OldMaxEnergy)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, MaxEnergy, OldMaxEnergy);
 }
 
-void UTgCreatureAttributeSet::OnRep_EnergyRegen(const FGameplayAttributeData& OldEnergyRegen)
+void UTgCreatureAttributeSet::OnRep_EnergyRegen(const FTgAttributeData& OldEnergyRegen)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, EnergyRegen, OldEnergyRegen);
 }
 
-void UTgCreatureAttributeSet::OnRep_Shield(const FGameplayAttributeData& OldShield)
+void UTgCreatureAttributeSet::OnRep_Shield(const FTgAttributeData& OldShield)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Shield, OldShield);
 }
 
-void UTgCreatureAttributeSet::OnRep_Ingenuity(const FGameplayAttributeData& OldIngenuity)
+void UTgCreatureAttributeSet::OnRep_Ingenuity(const FTgAttributeData& OldIngenuity)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Ingenuity, OldIngenuity);
 }
 
-void UTgCreatureAttributeSet::OnRep_Intelligence(const FGameplayAttributeData& OldIntelligence)
+void UTgCreatureAttributeSet::OnRep_Intelligence(const FTgAttributeData& OldIntelligence)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Intelligence, OldIntelligence);
 }
 
-void UTgCreatureAttributeSet::OnRep_Arcane(const FGameplayAttributeData& OldArcane)
+void UTgCreatureAttributeSet::OnRep_Arcane(const FTgAttributeData& OldArcane)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Arcane, OldArcane);
 }
 
-void UTgCreatureAttributeSet::OnRep_Telekinesis(const FGameplayAttributeData& OldTelekinesis)
+void UTgCreatureAttributeSet::OnRep_Telekinesis(const FTgAttributeData& OldTelekinesis)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Telekinesis, OldTelekinesis);
 }
 
-void UTgCreatureAttributeSet::OnRep_CooldownReduction(const FGameplayAttributeData& OldCooldownReduction)
+void UTgCreatureAttributeSet::OnRep_CooldownReduction(const FTgAttributeData& OldCooldownReduction)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, CooldownReduction, OldCooldownReduction);
 }
 
-void UTgCreatureAttributeSet::OnRep_PhysicalArmor(const FGameplayAttributeData& OldPhysicalArmor)
+void UTgCreatureAttributeSet::OnRep_PhysicalArmor(const FTgAttributeData& OldPhysicalArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, PhysicalArmor, OldPhysicalArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_FireArmor(const FGameplayAttributeData& OldFireArmor)
+void UTgCreatureAttributeSet::OnRep_FireArmor(const FTgAttributeData& OldFireArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, FireArmor, OldFireArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_FrostArmor(const FGameplayAttributeData& OldFrostArmor)
+void UTgCreatureAttributeSet::OnRep_FrostArmor(const FTgAttributeData& OldFrostArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, FrostArmor, OldFrostArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_ElectricalArmor(const FGameplayAttributeData& OldElectricalArmor)
+void UTgCreatureAttributeSet::OnRep_ElectricalArmor(const FTgAttributeData& OldElectricalArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, ElectricalArmor, OldElectricalArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_AlchemicalArmor(const FGameplayAttributeData& OldAlchemicalArmor)
+void UTgCreatureAttributeSet::OnRep_AlchemicalArmor(const FTgAttributeData& OldAlchemicalArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, AlchemicalArmor, OldAlchemicalArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_MagicalArmor(const FGameplayAttributeData& OldMagicalArmor)
+void UTgCreatureAttributeSet::OnRep_MagicalArmor(const FTgAttributeData& OldMagicalArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, MagicalArmor, OldMagicalArmor);
 }
 
-void UTgCreatureAttributeSet::OnRep_Lifesteal(const FGameplayAttributeData& OldLifesteal)
+void UTgCreatureAttributeSet::OnRep_Lifesteal(const FTgAttributeData& OldLifesteal)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, Lifesteal, OldLifesteal);
 }
 
-void UTgCreatureAttributeSet::OnRep_MovementSpeed(const FGameplayAttributeData& OldMovementSpeed)
+void UTgCreatureAttributeSet::OnRep_MovementSpeed(const FTgAttributeData& OldMovementSpeed)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, MovementSpeed, OldMovementSpeed);
 }
 
-void UTgCreatureAttributeSet::OnRep_HealMultiplier(const FGameplayAttributeData& OldHealMultiplier)
+void UTgCreatureAttributeSet::OnRep_HealMultiplier(const FTgAttributeData& OldHealMultiplier)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, HealMultiplier, OldHealMultiplier);
 }
 
-void UTgCreatureAttributeSet::OnRep_DamageOutgoingMultiplier(const FGameplayAttributeData& OldDamageOutgoingMultiplier)
+void UTgCreatureAttributeSet::OnRep_DamageOutgoingMultiplier(const FTgAttributeData& OldDamageOutgoingMultiplier)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, DamageOutgoingMultiplier, OldDamageOutgoingMultiplier);
 }
 
-void UTgCreatureAttributeSet::OnRep_DamageIncomingMultiplier(const FGameplayAttributeData& OldDamageIncomingMultiplier)
+void UTgCreatureAttributeSet::OnRep_DamageIncomingMultiplier(const FTgAttributeData& OldDamageIncomingMultiplier)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UTgCreatureAttributeSet, DamageIncomingMultiplier, OldDamageIncomingMultiplier);
 }
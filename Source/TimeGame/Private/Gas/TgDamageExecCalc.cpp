@@ -5,6 +5,7 @@
 
 #include "TimeGame/Public/Gas/TgAsc.h"
 #include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+#include "TimeGame/Public/Gas/TgDamageTypeRegistry.h"
 #include "TimeGame/Public/Gas/TgHealingExecCalc.h"
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
@@ -13,12 +14,6 @@ struct FTgDamageStatics
 	DECLARE_ATTRIBUTE_CAPTUREDEF(Health);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(HealMultiplier);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(Shield);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(PhysicalArmor);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(FireArmor);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(FrostArmor);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(ElectricalArmor);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AlchemicalArmor);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(MagicalArmor);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(Lifesteal);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(DamageOutgoingMultiplier);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(DamageIncomingMultiplier);
@@ -28,12 +23,6 @@ struct FTgDamageStatics
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, Health, Target, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, HealMultiplier, Target, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, Shield, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, PhysicalArmor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, FireArmor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, FrostArmor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, ElectricalArmor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, AlchemicalArmor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, MagicalArmor, Target, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, Lifesteal, Source, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, DamageOutgoingMultiplier, Source, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UTgCreatureAttributeSet, DamageIncomingMultiplier, Target, false);
@@ -49,12 +38,6 @@ static const FTgDamageStatics& DamageStatics()
 UTgDamageExecCalc::UTgDamageExecCalc()
 {
 	RelevantAttributesToCapture.Add(DamageStatics().ShieldDef);
-	RelevantAttributesToCapture.Add(DamageStatics().PhysicalArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().FireArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().FrostArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().ElectricalArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().AlchemicalArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().MagicalArmorDef);
 	RelevantAttributesToCapture.Add(DamageStatics().LifestealDef);
 	RelevantAttributesToCapture.Add(DamageStatics().DamageOutgoingMultiplierDef);
 	RelevantAttributesToCapture.Add(DamageStatics().DamageIncomingMultiplierDef);
@@ -62,12 +45,23 @@ UTgDamageExecCalc::UTgDamageExecCalc()
 	RelevantAttributesToCapture.Add(DamageStatics().HealMultiplierDef);
 }
 
+void UTgDamageExecCalc::GetAttributeCaptureDefinitions(TArray<FGameplayEffectAttributeCaptureDefinition>& OutCaptureDefinitions) const
+{
+	Super::GetAttributeCaptureDefinitions(OutCaptureDefinitions);
+
+	//Resistances come from the damage type registry.
+	for (const FTgDamagePipeline::FDamageType& DamageType : FTgDamagePipeline::Get().DamageTypes)
+	{
+		OutCaptureDefinitions.AddUnique(DamageType.ResistanceDef);
+	}
+}
+
 void UTgDamageExecCalc::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
                                                FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
-	float Damage = FMath::Max<float>(
-		Spec.GetSetByCallerMagnitude(FGameplayTag::RequestGameplayTag(FName("Data.Damage")), false, -1.0f), 0.0f);
+	const FTgDamagePipeline& Pipeline = FTgDamagePipeline::Get();
+	float Damage = FMath::Max<float>(Spec.GetSetByCallerMagnitude(Pipeline.DamageMagnitudeTag, false, -1.0f), 0.0f);
 
 	float OriginalDamage = Damage;
 
@@ -99,67 +93,16 @@ void UTgDamageExecCalc::Execute_Implementation(const FGameplayEffectCustomExecut
 
 	OriginalDamage *= DamageOutgoingMultiplier;
 
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Physical"))))
-	{
-		float PhysicalArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().PhysicalArmorDef,
-		                                                           EvaluationParameters, PhysicalArmor);
-		PhysicalArmor = FMath::Clamp(PhysicalArmor, 0, 0.8);
-		Damage *= 1.0 - PhysicalArmor;
-	}
-
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Fire"))))
+	for (const FTgDamagePipeline::FDamageType& DamageType : Pipeline.DamageTypes)
 	{
-		float FireArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().FireArmorDef, EvaluationParameters,
-		                                                           FireArmor);
-		FireArmor = FMath::Clamp(FireArmor, 0, 0.8);
-		Damage *= 1.0 - FireArmor;
-	}
-
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Frost"))))
-	{
-		float FrostArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().FrostArmorDef, EvaluationParameters,
-		                                                           FrostArmor);
-		FrostArmor = FMath::Clamp(FrostArmor, 0, 0.8);
-		Damage *= 1.0 - FrostArmor;
-	}
-
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Electrical"))))
-	{
-		float ElectricalArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().ElectricalArmorDef,
-		                                                           EvaluationParameters, ElectricalArmor);
-		ElectricalArmor = FMath::Clamp(ElectricalArmor, 0, 0.8);
-		Damage *= 1.0 - ElectricalArmor;
-	}
-
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Alchemical"))))
-	{
-		float AlchemicalArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().AlchemicalArmorDef,
-		                                                           EvaluationParameters, AlchemicalArmor);
-		AlchemicalArmor = FMath::Clamp(AlchemicalArmor, 0, 0.8);
-		Damage *= 1.0 - AlchemicalArmor;
-	}
-
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Magical"))))
-	{
-		float MagicalArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().MagicalArmorDef,
-		                                                           EvaluationParameters, MagicalArmor);
-		MagicalArmor = FMath::Clamp(MagicalArmor, 0, 0.8);
-		Damage *= 1.0 - MagicalArmor;
-	}
+		if (!SpecAssetTags.HasTag(DamageType.DamageTag))
+		{
+			continue;
+		}
 
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Magical"))))
-	{
-		float MagicalArmor = 0;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().MagicalArmorDef,
-		                                                           EvaluationParameters, MagicalArmor);
-		MagicalArmor = FMath::Clamp(MagicalArmor, 0, 0.8);
-		Damage *= 1.0 - MagicalArmor;
+		float Resistance = 0;
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageType.ResistanceDef, EvaluationParameters, Resistance);
+		Damage *= 1.0 - Pipeline.GetMitigation(DamageType, Resistance);
 	}
 
 	float ShieldedDamage = 0;
@@ -169,7 +112,7 @@ void UTgDamageExecCalc::Execute_Implementation(const FGameplayEffectCustomExecut
 	ShieldedDamage = FMath::Min<float>(Shield, Damage);
 	Damage -= ShieldedDamage;
 	
-	if (SpecAssetTags.HasTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.CanLifesteal"))))
+	if (SpecAssetTags.HasTag(Pipeline.LifestealTag))
 	{
 		float Lifesteal = 0;
 		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().LifestealDef,
@@ -183,21 +126,10 @@ void UTgDamageExecCalc::Execute_Implementation(const FGameplayEffectCustomExecut
 		HealMultiplier = FMath::Max<float>(0, HealMultiplier);
 		const float ProcessedStolenHealth = StolenHealth * HealMultiplier;
 
-		UGameplayEffect* GELifesteal = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("Lifesteal")));
-		GELifesteal->DurationPolicy = EGameplayEffectDurationType::Instant;
-
-		int32 Idx = GELifesteal->Modifiers.Num();
-		GELifesteal->Modifiers.SetNum(Idx + 1);
-		FGameplayModifierInfo& Info = GELifesteal->Modifiers[Idx];
-		Info.ModifierMagnitude = FScalableFloat(ProcessedStolenHealth);
-		Info.ModifierOp = EGameplayModOp::Additive;
-		Info.Attribute = UTgCreatureAttributeSet::GetHealthAttribute();
-
-		SourceAbilitySystemComponent->ApplyGameplayEffectToSelf(GELifesteal, 1.0f, SourceAbilitySystemComponent->MakeEffectContext());
-		//Broadcast healing.
+		//Summed and applied once per frame by the source.
 		if (UTgAsc* SourceAsc = Cast<UTgAsc>(SourceAbilitySystemComponent))
 		{
-			SourceAsc->BroadcastReceiveHealing(SourceAsc, ProcessedStolenHealth, StolenHealth);
+			SourceAsc->AddPendingLifesteal(ProcessedStolenHealth, StolenHealth);
 		}
 	}
 
@@ -0,0 +1,135 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TimeGame/Public/Gas/TgDamageTypeRegistry.h"
+
+#include "Core/TgPlayerCharacter.h"
+#include "Curves/CurveFloat.h"
+#include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+
+#if WITH_EDITOR
+void UTgDamageTypeRegistry::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FTgDamagePipeline::Rebuild();
+}
+#endif
+
+const FTgDamagePipeline& FTgDamagePipeline::Get()
+{
+	FTgDamagePipeline& Pipeline = GetMutable();
+	if (!Pipeline.bBuilt)
+	{
+		Rebuild();
+	}
+	return Pipeline;
+}
+
+FTgDamagePipeline& FTgDamagePipeline::GetMutable()
+{
+	static FTgDamagePipeline Pipeline;
+	return Pipeline;
+}
+
+void FTgDamagePipeline::Rebuild()
+{
+	FTgDamagePipeline& Pipeline = GetMutable();
+	Pipeline.DamageTypes.Reset();
+	Pipeline.HealingTypes.Reset();
+	Pipeline.Registry.Reset();
+	Pipeline.bBuilt = true;
+
+	const UTgDamageSettings* Settings = GetDefault<UTgDamageSettings>();
+	if (UTgDamageTypeRegistry* LoadedRegistry = Settings->DamageTypeRegistry.LoadSynchronous())
+	{
+		Pipeline.Registry.Reset(LoadedRegistry);
+		Pipeline.BuildFromRegistry(*LoadedRegistry);
+		return;
+	}
+
+	if (!Settings->DamageTypeRegistry.IsNull())
+	{
+		UE_LOG(LogTimeGame, Error, TEXT("Damage type registry %s could not be loaded. Using built in damage types."),
+		       *Settings->DamageTypeRegistry.ToString());
+	}
+	Pipeline.BuildDefaults();
+}
+
+void FTgDamagePipeline::Reset()
+{
+	FTgDamagePipeline& Pipeline = GetMutable();
+	Pipeline.DamageTypes.Empty();
+	Pipeline.HealingTypes.Empty();
+	Pipeline.Registry.Reset();
+	Pipeline.bBuilt = false;
+}
+
+float FTgDamagePipeline::GetMitigation(const FDamageType& DamageType, float Resistance) const
+{
+	const float Mitigation = DamageType.MitigationCurve ? DamageType.MitigationCurve->GetFloatValue(Resistance) : Resistance;
+	return FMath::Clamp(Mitigation, 0.0f, DamageType.MaxMitigation);
+}
+
+void FTgDamagePipeline::BuildFromRegistry(const UTgDamageTypeRegistry& InRegistry)
+{
+	DamageMagnitudeTag = InRegistry.DamageMagnitudeTag;
+	LifestealTag = InRegistry.LifestealTag;
+	HealingMagnitudeTag = InRegistry.HealingMagnitudeTag;
+
+	for (const FTgDamageType& DamageType : InRegistry.DamageTypes)
+	{
+		if (!DamageType.DamageTag.IsValid() || !DamageType.ResistanceAttribute.IsValid())
+		{
+			UE_LOG(LogTimeGame, Error, TEXT("Damage type %s in %s needs a damage tag and a resistance attribute."),
+			       *DamageType.DamageTag.ToString(), *InRegistry.GetName());
+			continue;
+		}
+
+		FDamageType& Resolved = DamageTypes.AddDefaulted_GetRef();
+		Resolved.DamageTag = DamageType.DamageTag;
+		Resolved.ResistanceDef = FGameplayEffectAttributeCaptureDefinition(DamageType.ResistanceAttribute,
+		                                                                   EGameplayEffectAttributeCaptureSource::Target, false);
+		Resolved.MitigationCurve = DamageType.MitigationCurve;
+		Resolved.MaxMitigation = DamageType.MaxMitigation;
+	}
+
+	for (const FTgHealingType& HealingType : InRegistry.HealingTypes)
+	{
+		if (!HealingType.HealingTag.IsValid() || !HealingType.MultiplierAttribute.IsValid())
+		{
+			UE_LOG(LogTimeGame, Error, TEXT("Healing type %s in %s needs a healing tag and a multiplier attribute."),
+			       *HealingType.HealingTag.ToString(), *InRegistry.GetName());
+			continue;
+		}
+
+		FHealingType& Resolved = HealingTypes.AddDefaulted_GetRef();
+		Resolved.HealingTag = HealingType.HealingTag;
+		Resolved.MultiplierDef = FGameplayEffectAttributeCaptureDefinition(HealingType.MultiplierAttribute,
+		                                                                   EGameplayEffectAttributeCaptureSource::Target, false);
+	}
+}
+
+void FTgDamagePipeline::BuildDefaults()
+{
+	DamageMagnitudeTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"), false);
+	LifestealTag = FGameplayTag::RequestGameplayTag(FName("Effect.Damage.CanLifesteal"), false);
+	HealingMagnitudeTag = FGameplayTag::RequestGameplayTag(FName("Data.Healing"), false);
+
+	const TPair<const TCHAR*, FGameplayAttribute> DefaultTypes[] = {
+		{TEXT("Effect.Damage.Physical"), UTgCreatureAttributeSet::GetPhysicalArmorAttribute()},
+		{TEXT("Effect.Damage.Fire"), UTgCreatureAttributeSet::GetFireArmorAttribute()},
+		{TEXT("Effect.Damage.Frost"), UTgCreatureAttributeSet::GetFrostArmorAttribute()},
+		{TEXT("Effect.Damage.Electrical"), UTgCreatureAttributeSet::GetElectricalArmorAttribute()},
+		{TEXT("Effect.Damage.Alchemical"), UTgCreatureAttributeSet::GetAlchemicalArmorAttribute()},
+		{TEXT("Effect.Damage.Magical"), UTgCreatureAttributeSet::GetMagicalArmorAttribute()}
+	};
+
+	for (const TPair<const TCHAR*, FGameplayAttribute>& DefaultType : DefaultTypes)
+	{
+		FDamageType& Resolved = DamageTypes.AddDefaulted_GetRef();
+		Resolved.DamageTag = FGameplayTag::RequestGameplayTag(FName(DefaultType.Key), false);
+		Resolved.ResistanceDef = FGameplayEffectAttributeCaptureDefinition(DefaultType.Value,
+		                                                                   EGameplayEffectAttributeCaptureSource::Target, false);
+	}
+}
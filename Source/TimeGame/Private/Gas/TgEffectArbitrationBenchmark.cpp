@@ -0,0 +1,88 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "TimeGame/Public/Gas/TgAsc.h"
+#include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Tg.Benchmark.EffectArbitration [Auras] [Rounds]
+ * Applies the same non stacking aura from Auras instigators with random selection values,
+ * Rounds times, and reports the time spent per application including arbitration.
+ * Needs a server or standalone world, as arbitration only runs with authority.
+ */
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TgEffectArbitrationBenchmark(
+	TEXT("Tg.Benchmark.EffectArbitration"),
+	TEXT("Time applying a non stacking aura from many instigators. Args: [Auras=50] [Rounds=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			Ar.Log(TEXT("Run this in a server or standalone game world."));
+			return;
+		}
+
+		const int32 AuraCount = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50;
+		const int32 Rounds = Args.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+		const FGameplayAttribute SelectionAttribute = UTgCreatureAttributeSet::GetIntelligenceAttribute();
+
+		auto SpawnAscActor = [World, &SelectionAttribute](float SelectionValue)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			UTgAsc* Asc = NewObject<UTgAsc>(Actor);
+			Asc->EffectSelectionAttribute = SelectionAttribute;
+			Asc->RegisterComponent();
+			Asc->InitAbilityActorInfo(Actor, Actor);
+			Asc->AddSpawnedAttribute(NewObject<UTgCreatureAttributeSet>(Actor));
+			Asc->SetNumericAttributeBase(SelectionAttribute, SelectionValue);
+			return Asc;
+		};
+
+		UTgAsc* TargetAsc = SpawnAscActor(0);
+		FRandomStream Random(AuraCount);
+		TArray<UTgAsc*> Instigators;
+		for (int32 Index = 0; Index < AuraCount; Index++)
+		{
+			Instigators.Add(SpawnAscActor(Random.FRandRange(0, 100)));
+		}
+
+		UGameplayEffect* Aura = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("BenchmarkAura"));
+		Aura->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+		double Seconds = 0;
+		for (int32 Round = 0; Round < Rounds; Round++)
+		{
+			//A different order every round, so the winner arrives at a different point.
+			for (int32 Index = Instigators.Num() - 1; Index > 0; Index--)
+			{
+				Instigators.Swap(Index, Random.RandRange(0, Index));
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (UTgAsc* Instigator : Instigators)
+			{
+				Instigator->ApplyGameplayEffectToTarget(Aura, TargetAsc, 1, Instigator->MakeEffectContext());
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+
+			//Only the winner is left.
+			TargetAsc->RemoveActiveGameplayEffect(TargetAsc->GetSelectedEffect(Aura->GetClass()));
+		}
+
+		const int32 Applications = AuraCount * Rounds;
+		Ar.Logf(TEXT("%d auras x %d rounds: %.3f ms total, %.2f us per application."), AuraCount, Rounds, Seconds * 1000.0,
+		        Seconds * 1000000.0 / Applications);
+
+		TargetAsc->GetOwner()->Destroy();
+		for (UTgAsc* Instigator : Instigators)
+		{
+			Instigator->GetOwner()->Destroy();
+		}
+	}));
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "TimeGame/Public/Gas/TgAsc.h"
 #include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+#include "TimeGame/Public/Gas/TgDamageTypeRegistry.h"
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
 struct FTgHealingStatics
@@ -31,12 +32,23 @@ UTgHealingExecCalc::UTgHealingExecCalc()
 	RelevantAttributesToCapture.Add(HealingStatics().HealMultiplierDef);
 }
 
+void UTgHealingExecCalc::GetAttributeCaptureDefinitions(TArray<FGameplayEffectAttributeCaptureDefinition>& OutCaptureDefinitions) const
+{
+	Super::GetAttributeCaptureDefinitions(OutCaptureDefinitions);
+
+	//Healing type multipliers come from the damage type registry.
+	for (const FTgDamagePipeline::FHealingType& HealingType : FTgDamagePipeline::Get().HealingTypes)
+	{
+		OutCaptureDefinitions.AddUnique(HealingType.MultiplierDef);
+	}
+}
+
 void UTgHealingExecCalc::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
 	FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
-	float Healing = FMath::Max<float>(
-		Spec.GetSetByCallerMagnitude(FGameplayTag::RequestGameplayTag(FName("Data.Healing")), false, -1.0f), 0.0f);
+	const FTgDamagePipeline& Pipeline = FTgDamagePipeline::Get();
+	float Healing = FMath::Max<float>(Spec.GetSetByCallerMagnitude(Pipeline.HealingMagnitudeTag, false, -1.0f), 0.0f);
 
 	const float OriginalHealing = Healing;
 
@@ -58,6 +70,24 @@ void UTgHealingExecCalc::Execute_Implementation(const FGameplayEffectCustomExecu
 
 	Healing *= HealMultiplier;
 
+	if (Pipeline.HealingTypes.IsValidIndex(0))
+	{
+		FGameplayTagContainer SpecAssetTags;
+		Spec.GetAllAssetTags(SpecAssetTags);
+
+		for (const FTgDamagePipeline::FHealingType& HealingType : Pipeline.HealingTypes)
+		{
+			if (!SpecAssetTags.HasTag(HealingType.HealingTag))
+			{
+				continue;
+			}
+
+			float TypeMultiplier = 0;
+			ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(HealingType.MultiplierDef, EvaluationParameters, TypeMultiplier);
+			Healing *= FMath::Max<float>(TypeMultiplier, 0);
+		}
+	}
+
 	//Output healing
 	OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(HealingStatics().HealthProperty, EGameplayModOp::Additive, Healing));
 
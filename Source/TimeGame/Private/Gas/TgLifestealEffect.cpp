@@ -0,0 +1,21 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TimeGame/Public/Gas/TgLifestealEffect.h"
+
+#include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+
+const FName UTgLifestealEffect::HealingDataName = FName("Lifesteal");
+
+UTgLifestealEffect::UTgLifestealEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FSetByCallerFloat SetByCaller;
+	SetByCaller.DataName = HealingDataName;
+
+	FGameplayModifierInfo& Info = Modifiers.AddDefaulted_GetRef();
+	Info.Attribute = UTgCreatureAttributeSet::GetHealthAttribute();
+	Info.ModifierOp = EGameplayModOp::Additive;
+	Info.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+}
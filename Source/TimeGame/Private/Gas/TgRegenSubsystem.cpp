@@ -0,0 +1,174 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TimeGame/Public/Gas/TgRegenSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "GameplayEffectAggregator.h"
+#include "TimeGame/Public/Gas/TgCreatureAttributeSet.h"
+
+bool UTgRegenSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return bEnabled && World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UTgRegenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTgRegenSubsystem, STATGROUP_Tickables);
+}
+
+TArray<FGameplayAttribute, TFixedAllocator<6>> UTgRegenSubsystem::GetWakeAttributes()
+{
+	return {
+		UTgCreatureAttributeSet::GetHealthAttribute(), UTgCreatureAttributeSet::GetMaxHealthAttribute(),
+		UTgCreatureAttributeSet::GetHealthRegenAttribute(), UTgCreatureAttributeSet::GetEnergyAttribute(),
+		UTgCreatureAttributeSet::GetMaxEnergyAttribute(), UTgCreatureAttributeSet::GetEnergyRegenAttribute()
+	};
+}
+
+void UTgRegenSubsystem::RegisterAsc(UAbilitySystemComponent* Asc)
+{
+	if (!Asc || EntryIds.Contains(Asc)) return;
+
+	const int32 EntryId = Entries.Add(FEntry());
+	Entries[EntryId].Asc = Asc;
+	EntryIds.Add(Asc, EntryId);
+
+	for (const FGameplayAttribute& Attribute : GetWakeAttributes())
+	{
+		Asc->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UTgRegenSubsystem::OnWakeAttributeChanged, EntryId);
+	}
+	Resume(EntryId);
+}
+
+void UTgRegenSubsystem::UnregisterAsc(UAbilitySystemComponent* Asc)
+{
+	int32 EntryId = INDEX_NONE;
+	if (!EntryIds.RemoveAndCopyValue(Asc, EntryId)) return;
+
+	if (Asc)
+	{
+		for (const FGameplayAttribute& Attribute : GetWakeAttributes())
+		{
+			Asc->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
+		}
+	}
+	Suspend(EntryId);
+	Entries.RemoveAt(EntryId);
+}
+
+void UTgRegenSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Capped while nothing regenerates, so a resumed entry doesn't wait a whole interval
+	//but also isn't paid out the regen of the time it was suspended.
+	Elapsed += DeltaTime;
+	if (Active.Num() == 0)
+	{
+		Elapsed = FMath::Min(Elapsed, RegenInterval);
+		return;
+	}
+	if (Elapsed < RegenInterval) return;
+
+	//Like the zone buckets, one pass per frame covering every whole interval that passed.
+	const float Remainder = RegenInterval > 0 ? FMath::Fmod(Elapsed, RegenInterval) : 0;
+	const float RegenTime = Elapsed - Remainder;
+	Elapsed = Remainder;
+	Regenerate(RegenTime);
+}
+
+void UTgRegenSubsystem::Regenerate(float DeltaTime)
+{
+	//Attribute change callbacks can apply effects or destroy actors, so every
+	//aggregator update is held until all base values have been written.
+	FScopedAggregatorOnDirtyBatch AggregatorBatch;
+
+	//Backwards, so suspending an entry only swaps in one that was already visited.
+	for (int32 Index = Active.Num() - 1; Index >= 0; Index--)
+	{
+		//Entries unregistered by an earlier entry's callbacks.
+		if (!Active.IsValidIndex(Index)) continue;
+
+		const int32 EntryId = Active[Index];
+		FEntry& Entry = Entries[EntryId];
+		UAbilitySystemComponent* Asc = Entry.Asc.Get();
+		if (!Asc)
+		{
+			Suspend(EntryId);
+			continue;
+		}
+
+		//Sets can be added after the ASC began play, changing one of its attributes resumes the entry.
+		const UTgCreatureAttributeSet* AttributeSet = Entry.AttributeSet.Get();
+		if (!AttributeSet)
+		{
+			AttributeSet = Asc->GetSet<UTgCreatureAttributeSet>();
+			Entry.AttributeSet = AttributeSet;
+			if (!AttributeSet)
+			{
+				Suspend(EntryId);
+				continue;
+			}
+		}
+
+		//Dead creatures don't regenerate, reviving them changes health and resumes the entry.
+		if (AttributeSet->GetHealth() <= 0)
+		{
+			Suspend(EntryId);
+			continue;
+		}
+
+		const bool bHealthRegenerating = RegenerateAttribute(*Asc, UTgCreatureAttributeSet::GetHealthAttribute(), AttributeSet->GetHealth(),
+		                                                     AttributeSet->GetMaxHealth(), AttributeSet->GetHealthRegen() * DeltaTime);
+		const bool bEnergyRegenerating = RegenerateAttribute(*Asc, UTgCreatureAttributeSet::GetEnergyAttribute(), AttributeSet->GetEnergy(),
+		                                                     AttributeSet->GetMaxEnergy(), AttributeSet->GetEnergyRegen() * DeltaTime);
+
+		//The callbacks of the writes above may have unregistered it.
+		if (!bHealthRegenerating && !bEnergyRegenerating && Entries.IsValidIndex(EntryId) && Entries[EntryId].Asc.Get() == Asc)
+		{
+			Suspend(EntryId);
+		}
+	}
+}
+
+bool UTgRegenSubsystem::RegenerateAttribute(UAbilitySystemComponent& Asc, const FGameplayAttribute& Attribute, float Value,
+	float MaxValue, float Amount)
+{
+	//Clamped here, so PreAttributeChange never has to. Regen never lowers a value that is already above max.
+	const float NewValue = Amount > 0 ? FMath::Max(Value, FMath::Min(Value + Amount, MaxValue)) : FMath::Max(Value + Amount, 0.0f);
+	if (NewValue == Value) return false;
+
+	//Regen goes into the base value, modifiers on the attribute still apply on top.
+	Asc.SetNumericAttributeBase(Attribute, Asc.GetNumericAttributeBase(Attribute) + NewValue - Value);
+	return NewValue > 0 && NewValue < MaxValue;
+}
+
+void UTgRegenSubsystem::OnWakeAttributeChanged(const FOnAttributeChangeData& Data, int32 EntryId)
+{
+	Resume(EntryId);
+}
+
+void UTgRegenSubsystem::Resume(int32 EntryId)
+{
+	if (!Entries.IsValidIndex(EntryId)) return;
+
+	FEntry& Entry = Entries[EntryId];
+	if (Entry.ActiveIndex != INDEX_NONE) return;
+	Entry.ActiveIndex = Active.Add(EntryId);
+}
+
+void UTgRegenSubsystem::Suspend(int32 EntryId)
+{
+	FEntry& Entry = Entries[EntryId];
+	if (Entry.ActiveIndex == INDEX_NONE) return;
+
+	const int32 ActiveIndex = Entry.ActiveIndex;
+	Entry.ActiveIndex = INDEX_NONE;
+	Active.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+	if (Active.IsValidIndex(ActiveIndex))
+	{
+		Entries[Active[ActiveIndex]].ActiveIndex = ActiveIndex;
+	}
+}
@@ -5,25 +5,42 @@
 
 #include "AbilitySystemComponent.h"
 #include "Core/TgPlayerCharacter.h"
+#include "Net/UnrealNetwork.h"
 
 FAbilityBinding::FAbilityBinding(): InputAction(nullptr), ActivationType()
 {
 }
 
-bool FAbilityBinding::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+void FAbilityBinding::PostReplicatedAdd(const FAbilityBindingArray& InArraySerializer)
 {
-	Ar << AbilityClass;
-	UObject* ActionToSerialize = InputAction;
-	Map->SerializeObject(Ar, UInputAction::StaticClass(), ActionToSerialize);
-	InputAction = Cast<UInputAction>(ActionToSerialize);
-	Ar << ActivationType;
-	return bOutSuccess;
+	//A dirty map is rebuilt with this binding anyway.
+	if (InArraySerializer.Owner->bInputBindingsDirty) return;
+	InArraySerializer.Owner->AddInputBinding(*this);
+}
+
+void FAbilityBinding::PostReplicatedChange(const FAbilityBindingArray& InArraySerializer)
+{
+	InArraySerializer.Owner->bInputBindingsDirty = true;
+}
+
+void FAbilityBinding::PreReplicatedRemove(const FAbilityBindingArray& InArraySerializer)
+{
+	//Still in Items at this point, so the map is rebuilt on the next input instead.
+	InArraySerializer.Owner->bInputBindingsDirty = true;
 }
 
 UAbilityManagerComponent::UAbilityManagerComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	SetIsReplicated(true);
+	AbilityBindings.Owner = this;
+}
+
+void UAbilityManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UAbilityManagerComponent, AbilityBindings, COND_OwnerOnly);
 }
 
 void UAbilityManagerComponent::GrantAndBindActiveAbility(const TSubclassOf<UGameplayAbility>& Ability,
@@ -41,15 +58,16 @@ void UAbilityManagerComponent::GrantAndBindActiveAbility(const TSubclassOf<UGame
 		return;
 	}
 	
-	ServerGrantedAbilities.Add(Ability, Asc->GiveAbility(FGameplayAbilitySpec(Ability)));
+	const FGameplayAbilitySpecHandle SpecHandle = Asc->GiveAbility(FGameplayAbilitySpec(Ability));
+	ServerGrantedAbilities.Add(Ability, SpecHandle);
 
-	FAbilityBinding Binding;
+	FAbilityBinding& Binding = AbilityBindings.Items.AddDefaulted_GetRef();
 	Binding.AbilityClass = Ability;
 	Binding.InputAction = InputAction;
 	Binding.ActivationType = ActivationType;
-	AbilityBindings.Add(Binding);
-
-	UpdateAbilityBindings(AbilityBindings);
+	Binding.SpecHandle = SpecHandle;
+	AbilityBindings.MarkItemDirty(Binding);
+	AddInputBinding(Binding);
 }
 
 void UAbilityManagerComponent::RemoveActiveAbility(const TSubclassOf<UGameplayAbility>& Ability)
@@ -70,16 +88,17 @@ void UAbilityManagerComponent::RemoveActiveAbility(const TSubclassOf<UGameplayAb
 	Asc->ClearAbility(ServerGrantedAbilities[Ability]);
 	ServerGrantedAbilities.Remove(Ability);
 
-	for (int16 i = AbilityBindings.Num() - 1; i >= 0; i--)
+	for (int16 i = AbilityBindings.Items.Num() - 1; i >= 0; i--)
 	{
-		if (AbilityBindings[i].AbilityClass == Ability)
+		if (AbilityBindings.Items[i].AbilityClass == Ability)
 		{
-			AbilityBindings.RemoveAt(i);
+			AbilityBindings.Items.RemoveAt(i);
+			AbilityBindings.MarkArrayDirty();
 			break;
 		}
 	}
 
-	UpdateAbilityBindings(AbilityBindings);
+	RebuildInputBindings();
 }
 
 float UAbilityManagerComponent::GetCooldown(const TSubclassOf<UGameplayAbility>& Ability) const
@@ -96,15 +115,32 @@ float UAbilityManagerComponent::GetCooldown(const TSubclassOf<UGameplayAbility>&
 
 void UAbilityManagerComponent::OnInput(const UInputAction* InputAction, const EInputActionActivationType ActivationType)
 {
-	for (const FAbilityBinding& Binding : AbilityBindings)
+	if (bInputBindingsDirty)
 	{
-		if (Binding.InputAction == InputAction && Binding.ActivationType == ActivationType)
-		{
-			UAbilitySystemComponent* Asc = GetAsc();
-			if (!Asc) return;
-			Asc->TryActivateAbilityByClass(Binding.AbilityClass);
-			return;
-		}
+		RebuildInputBindings();
+	}
+
+	const FGameplayAbilitySpecHandle* SpecHandle = InputBindings.Find(FInputBindingKey(InputAction, ActivationType));
+	if (!SpecHandle) return;
+	UAbilitySystemComponent* Asc = GetAsc();
+	if (!Asc) return;
+	Asc->TryActivateAbility(*SpecHandle);
+}
+
+void UAbilityManagerComponent::AddInputBinding(const FAbilityBinding& Binding)
+{
+	//The earliest binding of an input wins.
+	if (!Binding.InputAction) return;
+	InputBindings.FindOrAdd(FInputBindingKey(Binding.InputAction, Binding.ActivationType), Binding.SpecHandle);
+}
+
+void UAbilityManagerComponent::RebuildInputBindings()
+{
+	bInputBindingsDirty = false;
+	InputBindings.Reset();
+	for (const FAbilityBinding& Binding : AbilityBindings.Items)
+	{
+		AddInputBinding(Binding);
 	}
 }
 
@@ -145,11 +181,6 @@ void UAbilityManagerComponent::RemovePassiveAbility(const TSubclassOf<UGameplayA
 	ServerGrantedAbilities.Remove(Ability);
 }
 
-void UAbilityManagerComponent::UpdateAbilityBindings_Implementation(const TArray<FAbilityBinding>& InAbilityBindings)
-{
-	AbilityBindings = InAbilityBindings;
-}
-
 void UAbilityManagerComponent::BeginPlay()
 {
 	Super::BeginPlay();
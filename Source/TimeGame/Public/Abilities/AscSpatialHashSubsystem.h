@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AscSpatialHashSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * Server side grid of the avatars of every registered ASC, for zones and projectiles
+ * to find their targets without physics overlaps.
+ * Rebuilt at most once per frame, the first time it's used.
+ */
+UCLASS()
+class TIMEGAME_API UAscSpatialHashSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	struct FEntry
+	{
+		UAbilitySystemComponent* Asc = nullptr;
+		const AActor* Avatar = nullptr;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0;
+		FIntVector Cell = FIntVector::ZeroValue;
+	};
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	void RegisterAsc(UAbilitySystemComponent* Asc);
+
+	void UnregisterAsc(UAbilitySystemComponent* Asc);
+
+	//Rebuild the grid if it hasn't been this frame.
+	void Update();
+
+	//Calls Func for every entry whose avatar could touch the box.
+	template <typename FuncType>
+	void ForEachInBox(const FBox& Box, FuncType&& Func) const;
+
+	//Size of a grid cell, roughly the size of a typical zone.
+	static constexpr float CellSize = 500.0f;
+
+private:
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> Ascs;
+
+	//Sorted by cell, Cells maps a cell to its first entry and entry count.
+	TArray<FEntry> Entries;
+
+	TMap<FIntVector, TPair<int32, int32>> Cells;
+
+	float MaxRadius = 0;
+
+	uint64 BuiltFrame = 0;
+
+	static FIntVector GetCell(const FVector& Location);
+};
+
+template <typename FuncType>
+void UAscSpatialHashSubsystem::ForEachInBox(const FBox& Box, FuncType&& Func) const
+{
+	const FIntVector MinCell = GetCell(Box.Min - FVector(MaxRadius));
+	const FIntVector MaxCell = GetCell(Box.Max + FVector(MaxRadius));
+	const int64 CellCount = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+
+	//A huge box touches more cells than there are occupied ones, just visit everything.
+	if (CellCount > Cells.Num())
+	{
+		for (const FEntry& Entry : Entries)
+		{
+			Func(Entry);
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TPair<int32, int32>* Range = Cells.Find(FIntVector(X, Y, Z));
+				if (!Range) continue;
+
+				for (int32 Index = Range->Key; Index < Range->Key + Range->Value; Index++)
+				{
+					Func(Entries[Index]);
+				}
+			}
+		}
+	}
+}
@@ -10,25 +10,35 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "ProjectileBase.generated.h"
 
+/**
+ * Settings and visuals of a projectile. Projectiles are simulated by the UProjectileSubsystem,
+ * this actor only follows one around if bNeedsVisualActor is set, and is reused afterwards.
+ */
 UCLASS()
 class TIMEGAME_API AProjectileBase : public AActor
 {
 	GENERATED_BODY()
 
+	friend class UProjectileSubsystem;
+
 public:
 	AProjectileBase();
-	
+
+	//Returns the visual actor of the projectile, which is null on a dedicated server or if the class doesn't need one.
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (WorldContext = "WorldContextObject", AutoCreateRefTerm = "EffectSpecsOnOverlap, ProjectileClass, InActorsToIgnore, InZoneParams"))
 	static AProjectileBase* SpawnProjectile(UObject* WorldContextObject, const TSubclassOf<AProjectileBase>& ProjectileClass,
 	                                        const TArray<FGameplayEffectSpecHandle>& EffectSpecsOnOverlap, const FVector& Origin,
 	                                        const FVector& Direction, const bool bInDestroyOnOverlap, const TArray<AActor*>& InActorsToIgnore, const bool bInCreateZone, const FZoneParams& InZoneParams);
-	
+
+	//Shows or hides the actor when it's taken from or returned to the pool.
+	void SetVisualActive(const bool bActive);
+
 protected:
-	virtual void BeginPlay() override;
-	
+	//Only its shape is used, as the radius the projectile hits with.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	UPrimitiveComponent* CollisionComponent;
 
+	//Only its settings are used, speed and gravity scale.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	UProjectileMovementComponent* ProjectileMovementComponent;
 
@@ -38,23 +48,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	UStaticMeshComponent* MeshComponent;
 
-	TArray<FGameplayEffectSpecHandle> OverlapEffectSpecs;
-
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float DespawnTime = 5.0;
 
-	UPROPERTY()
-	TArray<AActor*> ActorsToIgnore;
+	//Projectiles without anything to show can skip the actor entirely.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bNeedsVisualActor = true;
 
-	bool bDestroyOnOverlap;
-
-	bool bCreateZone;
-
-	FZoneParams ZoneParams;
-
-	UFUNCTION()
-	void OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-public:
-	virtual void Tick(float DeltaTime) override;
+	//Called when the actor starts following a projectile, to reset trails and effects.
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnVisualActivated();
 };
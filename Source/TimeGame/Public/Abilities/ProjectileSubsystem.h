@@ -0,0 +1,184 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Abilities/ZoneBase.h"
+#include "Engine/NetSerialization.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectileSubsystem.generated.h"
+
+class AProjectileBase;
+
+//Everything a client needs to simulate a projectile the server fired.
+USTRUCT()
+struct TIMEGAME_API FProjectileSpawnEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AProjectileBase> ProjectileClass;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	//Also the seed for anything random about the projectile.
+	UPROPERTY()
+	uint32 Id = 0;
+
+	//Server world time the projectile was fired at, clients fast forward it by the time since.
+	UPROPERTY()
+	double ServerSpawnTime = 0;
+};
+
+/**
+ * Simulates every projectile in the world as plain data.
+ * Projectiles follow a closed form path from their origin, so the server and clients
+ * end up in the same place without replicating movement. The server sends a spawn
+ * event when a projectile is fired and a despawn event when it hits something,
+ * batched per frame through ATgGameState. Spawns are unreliable, as a late one is
+ * useless, despawns are reliable so a dropped packet can't leave a ghost projectile.
+ * Hits are only checked on the server, against the UAscSpatialHashSubsystem.
+ * Projectile actors are only used for visuals, taken from a pool, and never
+ * spawned on a dedicated server.
+ */
+UCLASS()
+class TIMEGAME_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	//Returns the visual actor of the projectile, if it has one on this machine.
+	AProjectileBase* FireProjectile(const TSubclassOf<AProjectileBase>& ProjectileClass, const TArray<FGameplayEffectSpecHandle>& EffectSpecsOnOverlap,
+	                                const FVector& Origin, const FVector& Direction, const bool bDestroyOnOverlap,
+	                                const TArray<AActor*>& ActorsToIgnore, const bool bCreateZone, const FZoneParams& ZoneParams);
+
+	//Called on clients with the events the server sent.
+	void ReceiveSpawnEvents(const TArray<FProjectileSpawnEvent>& SpawnEvents);
+
+	void ReceiveDespawnEvents(const TArray<uint32>& DespawnEvents);
+
+	int32 GetProjectileCount() const { return Projectiles.Num(); }
+
+	void ClearProjectiles();
+
+	//Most events sent in a single RPC, to stay within the size of a bunch.
+	static constexpr int32 MaxEventsPerRpc = 64;
+
+private:
+	//Settings read once from the class default object.
+	struct FProjectileClass
+	{
+		UClass* Class = nullptr;
+		float Speed = 0;
+		float GravityZ = 0;
+		float Radius = 0;
+		float Lifetime = 0;
+		bool bNeedsVisualActor = true;
+	};
+
+	//Hot data, kept small and contiguous.
+	struct FProjectile
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		FVector Location = FVector::ZeroVector;
+		FVector PreviousLocation = FVector::ZeroVector;
+		float Age = 0;
+		uint32 Id = 0;
+		uint16 ClassIndex = 0;
+	};
+
+	//Cold data, same index as its projectile.
+	struct FProjectilePayload
+	{
+		TArray<FGameplayEffectSpecHandle> EffectSpecs;
+		TArray<TWeakObjectPtr<AActor>> ActorsToIgnore;
+		//Actors already hit, a projectile that passes through hits everything once.
+		TArray<TWeakObjectPtr<const AActor>> HitActors;
+		FZoneParams ZoneParams;
+		bool bDestroyOnOverlap = false;
+		bool bCreateZone = false;
+		TWeakObjectPtr<AProjectileBase> Visual;
+	};
+
+	struct FProjectileHit
+	{
+		uint32 Id = 0;
+		UAbilitySystemComponent* Asc = nullptr;
+		const AActor* Avatar = nullptr;
+		FVector Location = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;
+	};
+
+	TArray<FProjectileClass> Classes;
+
+	//Keeps the classes in Classes loaded.
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> ClassReferences;
+
+	TArray<FProjectile> Projectiles;
+
+	TArray<FProjectilePayload> Payloads;
+
+	TMap<uint32, int32> ProjectileIndexes;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AProjectileBase>> VisualPool;
+
+	uint32 NextId = 1;
+
+	TArray<FProjectileSpawnEvent> PendingSpawnEvents;
+
+	TArray<uint32> PendingDespawnEvents;
+
+	//Client side, ids whose reliable despawn arrived before their unreliable spawn, with the time they arrived.
+	TMap<uint32, double> EarlyDespawns;
+
+	//How long an early despawn is remembered, longer than any spawn event can be late.
+	static constexpr double EarlyDespawnMemory = 10.0;
+
+	TArray<FProjectileHit> Hits;
+
+	bool bWarnedMissingGameState = false;
+
+	int32 GetClassIndex(UClass* ProjectileClass);
+
+	//Age is above zero for projectiles fired earlier on the server.
+	int32 AddProjectile(UClass* ProjectileClass, const FVector& Origin, const FVector& Direction, uint32 Id, float Age = 0);
+
+	//Move the projectile to where it is at its Age.
+	void UpdateLocation(FProjectile& Projectile) const;
+
+	double GetServerTime() const;
+
+	void RemoveProjectile(int32 Index);
+
+	//Adds what the projectile touched since last frame to Hits. Only the first target for projectiles destroyed on overlap.
+	void FindHits(int32 Index, const class UAscSpatialHashSubsystem& AscHash);
+
+	void ProcessHit(const FProjectileHit& Hit);
+
+	AProjectileBase* AcquireVisual(UClass* ProjectileClass, const FVector& Location, const FRotator& Rotation);
+
+	void ReleaseVisual(AProjectileBase* Visual);
+
+	bool ShouldSendEvents() const;
+
+	//Round the values through the serialization of FProjectileSpawnEvent, so they match what clients receive.
+	static void QuantizeSpawnValues(FVector& Origin, FVector& Direction);
+
+	void SendEvents();
+};
@@ -44,9 +44,14 @@ public:
 		meta = (WorldContext = "WorldContextObject"))
 	static AZoneBase* SpawnZone(UObject* WorldContextObject, const FVector& Location, const FZoneParams& Params);
 
+	//Radius the zone affects, taken from the collision component.
+	float GetZoneRadius() const;
+
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	UPrimitiveComponent* CollisionComponent;
 
@@ -55,24 +60,16 @@ protected:
 
 	TArray<FGameplayEffectSpecHandle> OverlapEffectSpecs;
 
+	//Zones with the same interval are pulsed together by the UZoneSubsystem.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.0))
 	float TickInterval = 0.5;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0))
 	int TickCountBeforeDespawn = 10;
-
-	UPROPERTY()
-	TSet<UAbilitySystemComponent*> AscInZone;
 	
 	UPROPERTY()
 	TArray<AActor*> ActorsToIgnore;
 
-	UFUNCTION()
-	void OnEnterOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-	void OnEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* Other, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
-public:
-	virtual void Tick(float DeltaTime) override;
+	//Id in the UZoneSubsystem, only set on the server.
+	int32 ZoneId = INDEX_NONE;
 };
@@ -0,0 +1,70 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Abilities/AscSpatialHashSubsystem.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ZoneSubsystem.generated.h"
+
+class AZoneBase;
+
+/**
+ * Server side owner of every active zone.
+ * Zones are kept as plain data and pulsed together, grouped into buckets by their
+ * tick interval, instead of each zone actor ticking and tracking overlaps on its own.
+ * Membership is resolved through the UAscSpatialHashSubsystem.
+ */
+UCLASS()
+class TIMEGAME_API UZoneSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	//Returns the id to unregister the zone with.
+	int32 RegisterZone(AZoneBase* Zone, const FVector& Center, float Radius, const TArray<FGameplayEffectSpecHandle>& EffectSpecs,
+	                   const TArray<AActor*>& ActorsToIgnore, float Interval, int32 PulseCount);
+
+	void UnregisterZone(const AZoneBase* Zone, int32 ZoneId);
+
+private:
+	struct FZone
+	{
+		TWeakObjectPtr<AZoneBase> Actor;
+		//Refreshed from the actor every pulse.
+		FVector Center = FVector::ZeroVector;
+		float Radius = 0;
+		TArray<FGameplayEffectSpecHandle> EffectSpecs;
+		TArray<TWeakObjectPtr<AActor>> ActorsToIgnore;
+		int32 RemainingPulses = 0;
+		int32 Bucket = INDEX_NONE;
+		int32 Id = INDEX_NONE;
+		bool bRemoved = false;
+	};
+
+	//Zones sharing a tick interval pulse on the same frame.
+	struct FBucket
+	{
+		float Interval = 0;
+		float Elapsed = 0;
+		TArray<int32> Zones;
+	};
+
+	//Shared so zones stay alive if applying an effect spawns or destroys zones mid pulse.
+	TSparseArray<TSharedRef<FZone>> Zones;
+
+	TArray<FBucket> Buckets;
+
+	void PulseZone(FZone& Zone, const UAscSpatialHashSubsystem& AscHash);
+
+	void ApplyZoneEffects(const FZone& Zone, const UAscSpatialHashSubsystem::FEntry& Entry) const;
+
+	void RemoveZone(int32 ZoneId);
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Abilities/ProjectileSubsystem.h"
 #include "GameFramework/GameState.h"
 #include "TgGameState.generated.h"
 
@@ -44,6 +45,14 @@ public:
 
 	void RegisterAiCharacter(const FGameplayTag& NameTag, ATgAiCharacter* Character);
 
+	//Projectiles fired this frame, for clients to simulate. See UProjectileSubsystem.
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileSpawns(const TArray<FProjectileSpawnEvent>& SpawnEvents);
+
+	//Projectiles that hit something this frame.
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastProjectileDespawns(const TArray<uint32>& DespawnEvents);
+
 protected:
 	UPROPERTY()
 	TMap<FGameplayTag, int32> WorldStates;
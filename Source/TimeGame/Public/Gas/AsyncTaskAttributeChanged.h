@@ -12,6 +12,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeChanged, FGameplayAtt
 /**
  * Blueprint node to automatically register a listener for all attribute changes in an AbilitySystemComponent.
  * Useful to use in UI.
+ * Changes are collapsed per frame by the UTgAttributeObserverSubsystem. Widgets can call ObserveAttribute
+ * on the subsystem directly, which doesn't need an object per listener.
  */
 UCLASS(BlueprintType, meta=(ExposedAsyncProxy = AsyncTask))
 class TIMEGAME_API UAsyncTaskAttributeChanged : public UBlueprintAsyncActionBase
@@ -43,5 +45,8 @@ protected:
 	FGameplayAttribute AttributeToListenFor;
 	TArray<FGameplayAttribute> AttributesToListenFor;
 
-	void AttributeChanged(const FOnAttributeChangeData& Data);
+	UFUNCTION()
+	void AttributeChanged(FGameplayAttribute Attribute, float NewValue, float OldValue);
+
+	void Observe(FGameplayAttribute Attribute);
 };
@@ -4,12 +4,107 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "TimerManager.h"
+#include "UObject/ObjectKey.h"
 #include "TgAsc.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnReceiveDamage, UAbilitySystemComponent*, Source, float, ProcessedShieldDamage, float, ProcessedHealthDamage, float, OriginalDamage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnReceiveHealing, UAbilitySystemComponent*, Source, float, ProcessedHealing, float, OriginalHealing);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHit, UAbilitySystemComponent*, Source, UAbilitySystemComponent*, Target);
 
+UENUM(BlueprintType)
+enum class ETgCombatEventType : uint8
+{
+	Damage,
+	Healing
+};
+
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgCombatEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UAbilitySystemComponent> Source = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UAbilitySystemComponent> Target = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	ETgCombatEventType Type = ETgCombatEventType::Damage;
+
+	//Damage taken by the shield. Always 0 for healing.
+	UPROPERTY(BlueprintReadOnly)
+	float ShieldAmount = 0;
+
+	//Damage taken by or healing given to health.
+	UPROPERTY(BlueprintReadOnly)
+	float HealthAmount = 0;
+
+	//Amount before the target's multipliers and resistances.
+	UPROPERTY(BlueprintReadOnly)
+	float OriginalAmount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Time = 0;
+};
+
+//Every combat event an ASC received in one frame.
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgCombatEventBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FTgCombatEvent> Events;
+
+	UPROPERTY(BlueprintReadOnly)
+	float ShieldDamage = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float HealthDamage = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Healing = 0;
+
+	void Add(const FTgCombatEvent& Event);
+
+	void Reset();
+};
+
+//Totals of a batch sent to clients for damage numbers. Amounts are rounded and packed.
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgCombatSummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Hits = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 ShieldDamage = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 HealthDamage = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Healing = 0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTgCombatSummary> : public TStructOpsTypeTraitsBase2<FTgCombatSummary>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatEvents, const FTgCombatEventBatch&, Batch);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatSummary, const FTgCombatSummary&, Summary);
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class TIMEGAME_API UTgAsc : public UAbilitySystemComponent
 {
@@ -21,6 +116,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 	                           FActorComponentTickFunction* ThisTickFunction) override;
@@ -34,6 +131,26 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnHit OnHitRegistry;
 
+	//Everything received this frame, broadcast once at the start of the next tick.
+	UPROPERTY(BlueprintAssignable)
+	FOnCombatEvents OnCombatEvents;
+
+	//Received on every client the owner is relevant to if bReplicateCombatSummary is set.
+	UPROPERTY(BlueprintAssignable)
+	FOnCombatSummary OnCombatSummary;
+
+	//Also broadcast OnReceiveDamage and OnReceiveHealing for every hit. Turn off once listeners use OnCombatEvents.
+	UPROPERTY(EditAnywhere)
+	bool bBroadcastPerHitEvents = true;
+
+	//Send each frame's totals unreliably to clients, for damage numbers.
+	UPROPERTY(EditAnywhere)
+	bool bReplicateCombatSummary = false;
+
+	//How many of the latest combat events are kept in the combat log.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	int32 CombatLogCapacity = 64;
+
 	//Effects where their source has the highest value has the staying power.
 	UPROPERTY(EditAnywhere)
 	FGameplayAttribute EffectSelectionAttribute = FGameplayAttribute();
@@ -42,9 +159,63 @@ public:
 
 	void BroadcastReceiveHealing(UAbilitySystemComponent* Source, const float ProcessedHealing, const float OriginalHealing);
 
+	//Lifesteal from every hit this frame is applied to self as a single heal next tick.
+	void AddPendingLifesteal(const float ProcessedHealing, const float OriginalHealing);
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	void PerformOnHit(UAbilitySystemComponent* Target);
 
+	//Latest combat events, oldest first.
+	UFUNCTION(BlueprintCallable)
+	TArray<FTgCombatEvent> GetCombatLog() const;
+
 	UFUNCTION()
-	void OnServerActiveGameplayEffectAdded(UAbilitySystemComponent* Asc, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle EffectHandle) const;
+	void OnServerActiveGameplayEffectAdded(UAbilitySystemComponent* Asc, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle EffectHandle);
+
+	void OnServerActiveGameplayEffectRemoved(const FActiveGameplayEffect& Effect);
+
+	//Active instance of a non stacking effect class, null if there is none.
+	FActiveGameplayEffectHandle GetSelectedEffect(const UClass* EffectClass) const;
+
+private:
+	struct FSelectedEffect
+	{
+		FActiveGameplayEffectHandle Handle;
+		TWeakObjectPtr<UAbilitySystemComponent> Instigator;
+	};
+
+	/**
+	 * The one active instance of each non stacking effect class. Every other instance
+	 * is removed when added, so deciding which one stays is a single comparison
+	 * against the instigator of the current one.
+	 */
+	TMap<TObjectKey<UClass>, FSelectedEffect> SelectedEffects;
+
+	float GetEffectSelectionValue(const UAbilitySystemComponent* Instigator) const;
+
+	float PendingLifesteal = 0;
+
+	float PendingOriginalLifesteal = 0;
+
+	FTimerHandle LifestealTimerHandle;
+
+	void ApplyPendingLifesteal();
+
+	//Ring buffer, CombatLogHead is the next slot to write once it's full.
+	UPROPERTY(Transient)
+	TArray<FTgCombatEvent> CombatLog;
+
+	int32 CombatLogHead = 0;
+
+	UPROPERTY(Transient)
+	FTgCombatEventBatch PendingCombatEvents;
+
+	FTimerHandle CombatEventsTimerHandle;
+
+	void RecordCombatEvent(const FTgCombatEvent& Event);
+
+	void PublishCombatEvents();
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastCombatSummary(const FTgCombatSummary& Summary);
 };
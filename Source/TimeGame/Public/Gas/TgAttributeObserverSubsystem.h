@@ -0,0 +1,87 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TgAttributeObserverSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+struct FOnAttributeChangeData;
+
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FTgObservedAttributeChanged, FGameplayAttribute, Attribute, float, NewValue, float, OldValue);
+
+/**
+ * Attribute change notifications for UI.
+ * Every change of an observed attribute during a frame is collapsed into one notification per listener,
+ * from the value the listener last saw to the latest one, sent on the subsystem's tick.
+ * Each ASC and attribute pair binds to the ASC once, however many widgets observe it.
+ */
+UCLASS()
+class TIMEGAME_API UTgAttributeObserverSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+	static UTgAttributeObserverSubsystem* Get(const UObject* WorldContext);
+
+	/**
+	 * Call OnChanged when the attribute changed, at most once per frame.
+	 * A MinInterval above zero throttles the notifications further, for stats that don't need to update immediately.
+	 * The listener is the object OnChanged is bound to and is removed with it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Attributes", meta = (AdvancedDisplay = "MinInterval"))
+	void ObserveAttribute(UAbilitySystemComponent* Asc, FGameplayAttribute Attribute, FTgObservedAttributeChanged OnChanged, float MinInterval = 0);
+
+	//Stop every notification bound to the listener, for UMG widgets in their Destruct event.
+	UFUNCTION(BlueprintCallable, Category = "Attributes")
+	void StopObserving(const UObject* Listener);
+
+private:
+	struct FListener
+	{
+		FTgObservedAttributeChanged OnChanged;
+		float MinInterval = 0;
+		double NextNotifyTime = 0;
+
+		//Value the listener was last notified of.
+		float NotifiedValue = 0;
+	};
+
+	struct FObservedAttribute
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> Asc;
+		TObjectKey<UAbilitySystemComponent> AscKey;
+		FGameplayAttribute Attribute;
+		FDelegateHandle ChangeHandle;
+		float Value = 0;
+		bool bDirty = false;
+		TArray<FListener> Listeners;
+	};
+
+	TSparseArray<FObservedAttribute> Observed;
+
+	TMap<TPair<TObjectKey<UAbilitySystemComponent>, FGameplayAttribute>, int32> ObservedIds;
+
+	//Pairs that changed, or have listeners that were throttled or removed.
+	TArray<int32> DirtyIds;
+
+	void OnAttributeChanged(const FOnAttributeChangeData& Data, int32 ObservedId);
+
+	void MarkDirty(int32 ObservedId);
+
+	//Notify the listeners that are due. Returns true if any are still waiting for their interval.
+	bool Notify(int32 ObservedId, double Time);
+
+	void RemoveObserved(int32 ObservedId);
+};
@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Engine/DeveloperSettings.h"
+#include "Net/UnrealNetwork.h"
+#include "TgAttributeReplication.generated.h"
+
+/**
+ * Attribute data that can be quantized when replicated.
+ * Values are sent as a packed number of Precision steps, so small stats take a byte or two instead of a full float.
+ */
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgAttributeData : public FGameplayAttributeData
+{
+	GENERATED_BODY()
+
+	FTgAttributeData()
+	{
+	}
+
+	FTgAttributeData(float DefaultValue) : FGameplayAttributeData(DefaultValue)
+	{
+	}
+
+	//Values are replicated rounded to this step. Zero replicates them unchanged. Set from UTgAttributeReplicationSettings.
+	float Precision = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	//Values within the same step are identical, so changes smaller than the precision aren't replicated.
+	bool Identical(const FTgAttributeData* Other, uint32 PortFlags) const;
+
+private:
+	void SerializeValue(FArchive& Ar, float& Value) const;
+
+	float Quantize(float Value) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTgAttributeData> : public TStructOpsTypeTraitsBase2<FTgAttributeData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdentical = true
+	};
+};
+
+USTRUCT()
+struct TIMEGAME_API FTgAttributeReplicationPolicy
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	FGameplayAttribute Attribute;
+
+	//Only replicate to the owning player, for stats that only their own UI needs.
+	UPROPERTY(EditAnywhere)
+	bool bOwnerOnly = false;
+
+	//Only call the rep notify when the value changed. Keep this off for attributes changed by predicted effects,
+	//as the client needs the notify to reconcile even if the server value matches the last replicated one.
+	UPROPERTY(EditAnywhere)
+	bool bNotifyOnlyOnChange = false;
+
+	//See FTgAttributeData::Precision.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	float Precision = 0;
+};
+
+/**
+ * How each attribute is replicated. Attributes without a policy replicate to everyone,
+ * always notify and aren't quantized.
+ * Client and server must use the same policies, and changes only apply after a restart
+ * as replicated properties are registered once per class.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Attribute Replication"))
+class TIMEGAME_API UTgAttributeReplicationSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	TArray<FTgAttributeReplicationPolicy> Policies;
+
+	const FTgAttributeReplicationPolicy* FindPolicy(const FGameplayAttribute& Attribute) const;
+
+	FDoRepLifetimeParams GetReplicationParams(const FGameplayAttribute& Attribute) const;
+
+	//Set the precision of every FTgAttributeData in the attribute set that has a policy.
+	void ApplyPrecision(UAttributeSet* AttributeSet) const;
+};
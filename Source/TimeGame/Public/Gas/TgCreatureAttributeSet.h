@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
 #include "AttributeSet.h"
+#include "TimeGame/Public/Gas/TgAttributeReplication.h"
 #include "TgCreatureAttributeSet.generated.h"
 
 // Uses macros from AttributeSet.h
@@ -24,6 +25,8 @@ class TIMEGAME_API UTgCreatureAttributeSet : public UAttributeSet
 
 public:
 	
+	virtual void PostInitProperties() override;
+
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
@@ -31,207 +34,207 @@ public:
 	//Health
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Health)
-	FGameplayAttributeData Health;
+	FTgAttributeData Health;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Health)
 
 	UFUNCTION()
-	virtual void OnRep_Health(const FGameplayAttributeData& OldHealth);
+	virtual void OnRep_Health(const FTgAttributeData& OldHealth);
 	
 	//MaxHealth
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxHealth)
-	FGameplayAttributeData MaxHealth;
+	FTgAttributeData MaxHealth;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, MaxHealth)
 
 	UFUNCTION()
-	virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
+	virtual void OnRep_MaxHealth(const FTgAttributeData& OldMaxHealth);
 
 	//HealthRegen
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_HealthRegen)
-	FGameplayAttributeData HealthRegen;
+	FTgAttributeData HealthRegen;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, HealthRegen)
 
 	UFUNCTION()
-	virtual void OnRep_HealthRegen(const FGameplayAttributeData& OldHealthRegen);
+	virtual void OnRep_HealthRegen(const FTgAttributeData& OldHealthRegen);
 
 	//Energy
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Energy)
-	FGameplayAttributeData Energy;
+	FTgAttributeData Energy;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Energy)
 
 	UFUNCTION()
-	virtual void OnRep_Energy(const FGameplayAttributeData& OldEnergy);
+	virtual void OnRep_Energy(const FTgAttributeData& OldEnergy);
 	
 	//MaxEnergy
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxEnergy)
-	FGameplayAttributeData MaxEnergy;
+	FTgAttributeData MaxEnergy;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, MaxEnergy)
 
 	UFUNCTION()
-	virtual void OnRep_MaxEnergy(const FGameplayAttributeData& OldMaxEnergy);
+	virtual void OnRep_MaxEnergy(const FTgAttributeData& OldMaxEnergy);
 
 	//EnergyRegen
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_EnergyRegen)
-	FGameplayAttributeData EnergyRegen;
+	FTgAttributeData EnergyRegen;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, EnergyRegen)
 
 	UFUNCTION()
-	virtual void OnRep_EnergyRegen(const FGameplayAttributeData& OldEnergyRegen);
+	virtual void OnRep_EnergyRegen(const FTgAttributeData& OldEnergyRegen);
 
 	//Shield
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Shield)
-	FGameplayAttributeData Shield;
+	FTgAttributeData Shield;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Shield)
 
 	UFUNCTION()
-	virtual void OnRep_Shield(const FGameplayAttributeData& OldShield);
+	virtual void OnRep_Shield(const FTgAttributeData& OldShield);
 	
 	//Ingenuity
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Ingenuity)
-	FGameplayAttributeData Ingenuity;
+	FTgAttributeData Ingenuity;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Ingenuity)
 
 	UFUNCTION()
-	virtual void OnRep_Ingenuity(const FGameplayAttributeData& OldIngenuity);
+	virtual void OnRep_Ingenuity(const FTgAttributeData& OldIngenuity);
 
 	//Intelligence
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Intelligence)
-	FGameplayAttributeData Intelligence;
+	FTgAttributeData Intelligence;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Intelligence)
 
 	UFUNCTION()
-	virtual void OnRep_Intelligence(const FGameplayAttributeData& OldIntelligence);
+	virtual void OnRep_Intelligence(const FTgAttributeData& OldIntelligence);
 
 	//Arcane
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Arcane)
-	FGameplayAttributeData Arcane;
+	FTgAttributeData Arcane;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Arcane)
 
 	UFUNCTION()
-	virtual void OnRep_Arcane(const FGameplayAttributeData& OldArcane);
+	virtual void OnRep_Arcane(const FTgAttributeData& OldArcane);
 
 	//Telekinesis
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Telekinesis)
-	FGameplayAttributeData Telekinesis;
+	FTgAttributeData Telekinesis;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Telekinesis)
 
 	UFUNCTION()
-	virtual void OnRep_Telekinesis(const FGameplayAttributeData& OldTelekinesis);
+	virtual void OnRep_Telekinesis(const FTgAttributeData& OldTelekinesis);
 
 	//CooldownReduction
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_CooldownReduction)
-	FGameplayAttributeData CooldownReduction;
+	FTgAttributeData CooldownReduction;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, CooldownReduction)
 
 	UFUNCTION()
-	virtual void OnRep_CooldownReduction(const FGameplayAttributeData& OldCooldownReduction);
+	virtual void OnRep_CooldownReduction(const FTgAttributeData& OldCooldownReduction);
 
 	//PhysicalArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_PhysicalArmor)
-	FGameplayAttributeData PhysicalArmor;
+	FTgAttributeData PhysicalArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, PhysicalArmor)
 
 	UFUNCTION()
-	virtual void OnRep_PhysicalArmor(const FGameplayAttributeData& OldPhysicalArmor);
+	virtual void OnRep_PhysicalArmor(const FTgAttributeData& OldPhysicalArmor);
 
 	//FireArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_FireArmor)
-	FGameplayAttributeData FireArmor;
+	FTgAttributeData FireArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, FireArmor)
 
 	UFUNCTION()
-	virtual void OnRep_FireArmor(const FGameplayAttributeData& OldFireArmor);
+	virtual void OnRep_FireArmor(const FTgAttributeData& OldFireArmor);
 
 	//FrostArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_FrostArmor)
-	FGameplayAttributeData FrostArmor;
+	FTgAttributeData FrostArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, FrostArmor)
 
 	UFUNCTION()
-	virtual void OnRep_FrostArmor(const FGameplayAttributeData& OldFrostArmor);
+	virtual void OnRep_FrostArmor(const FTgAttributeData& OldFrostArmor);
 
 	//ElectricalArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_ElectricalArmor)
-	FGameplayAttributeData ElectricalArmor;
+	FTgAttributeData ElectricalArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, ElectricalArmor)
 
 	UFUNCTION()
-	virtual void OnRep_ElectricalArmor(const FGameplayAttributeData& OldElectricalArmor);
+	virtual void OnRep_ElectricalArmor(const FTgAttributeData& OldElectricalArmor);
 
 	//AlchemicalArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_AlchemicalArmor)
-	FGameplayAttributeData AlchemicalArmor;
+	FTgAttributeData AlchemicalArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, AlchemicalArmor)
 
 	UFUNCTION()
-	virtual void OnRep_AlchemicalArmor(const FGameplayAttributeData& OldAlchemicalArmor);
+	virtual void OnRep_AlchemicalArmor(const FTgAttributeData& OldAlchemicalArmor);
 
 	//MagicalArmor
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MagicalArmor)
-	FGameplayAttributeData MagicalArmor;
+	FTgAttributeData MagicalArmor;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, MagicalArmor)
 
 	UFUNCTION()
-	virtual void OnRep_MagicalArmor(const FGameplayAttributeData& OldMagicalArmor);
+	virtual void OnRep_MagicalArmor(const FTgAttributeData& OldMagicalArmor);
 
 	//Lifesteal
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Lifesteal)
-	FGameplayAttributeData Lifesteal;
+	FTgAttributeData Lifesteal;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, Lifesteal)
 
 	UFUNCTION()
-	virtual void OnRep_Lifesteal(const FGameplayAttributeData& OldLifesteal);
+	virtual void OnRep_Lifesteal(const FTgAttributeData& OldLifesteal);
 
 	//MovementSpeed
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MovementSpeed)
-	FGameplayAttributeData MovementSpeed;
+	FTgAttributeData MovementSpeed;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, MovementSpeed)
 
 	UFUNCTION()
-	virtual void OnRep_MovementSpeed(const FGameplayAttributeData& OldMovementSpeed);
+	virtual void OnRep_MovementSpeed(const FTgAttributeData& OldMovementSpeed);
 
 	//HealMultiplier
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_HealMultiplier)
-	FGameplayAttributeData HealMultiplier;
+	FTgAttributeData HealMultiplier;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, HealMultiplier)
 
 	UFUNCTION()
-	virtual void OnRep_HealMultiplier(const FGameplayAttributeData& OldHealMultiplier);
+	virtual void OnRep_HealMultiplier(const FTgAttributeData& OldHealMultiplier);
 
 	//DamageOutgoingMultiplier
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_DamageOutgoingMultiplier)
-	FGameplayAttributeData DamageOutgoingMultiplier;
+	FTgAttributeData DamageOutgoingMultiplier;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, DamageOutgoingMultiplier)
 
 	UFUNCTION()
-	virtual void OnRep_DamageOutgoingMultiplier(const FGameplayAttributeData& OldDamageOutgoingMultiplier);
+	virtual void OnRep_DamageOutgoingMultiplier(const FTgAttributeData& OldDamageOutgoingMultiplier);
 
 	//DamageIncomingMultiplier
 	
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_DamageIncomingMultiplier)
-	FGameplayAttributeData DamageIncomingMultiplier;
+	FTgAttributeData DamageIncomingMultiplier;
 	ATTRIBUTE_ACCESSORS(UTgCreatureAttributeSet, DamageIncomingMultiplier)
 
 	UFUNCTION()
-	virtual void OnRep_DamageIncomingMultiplier(const FGameplayAttributeData& OldDamageIncomingMultiplier);
+	virtual void OnRep_DamageIncomingMultiplier(const FTgAttributeData& OldDamageIncomingMultiplier);
 };
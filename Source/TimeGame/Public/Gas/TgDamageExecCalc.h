@@ -15,4 +15,6 @@ public:
 	UTgDamageExecCalc();
 
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+
+	virtual void GetAttributeCaptureDefinitions(TArray<FGameplayEffectAttributeCaptureDefinition>& OutCaptureDefinitions) const override;
 };
@@ -0,0 +1,144 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "GameplayEffectTypes.h"
+#include "GameplayTagContainer.h"
+#include "Engine/DataAsset.h"
+#include "Engine/DeveloperSettings.h"
+#include "UObject/StrongObjectPtr.h"
+#include "TgDamageTypeRegistry.generated.h"
+
+class UCurveFloat;
+
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgDamageType
+{
+	GENERATED_BODY()
+
+	//Effects with this asset tag deal this type of damage.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayTag DamageTag;
+
+	//Target attribute that resists this type of damage.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayAttribute ResistanceAttribute;
+
+	//Maps resistance to the fraction of damage removed. If not set, resistance is used directly.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TObjectPtr<UCurveFloat> MitigationCurve;
+
+	//Upper limit of the fraction of damage removed.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1))
+	float MaxMitigation = 0.8f;
+};
+
+USTRUCT(BlueprintType)
+struct TIMEGAME_API FTgHealingType
+{
+	GENERATED_BODY()
+
+	//Effects with this asset tag apply this type of healing.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayTag HealingTag;
+
+	//Target attribute that the healing is multiplied by.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayAttribute MultiplierAttribute;
+};
+
+/**
+ * Damage and healing types used by UTgDamageExecCalc and UTgHealingExecCalc.
+ * Adding an element only needs a new entry here and a matching armor attribute.
+ */
+UCLASS(BlueprintType)
+class TIMEGAME_API UTgDamageTypeRegistry : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//Set by caller magnitude holding the damage.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	FGameplayTag DamageMagnitudeTag;
+
+	//Damage from effects with this asset tag heals the source by its Lifesteal.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	FGameplayTag LifestealTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	TArray<FTgDamageType> DamageTypes;
+
+	//Set by caller magnitude holding the healing.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Healing")
+	FGameplayTag HealingMagnitudeTag;
+
+	//Applied on top of HealMultiplier, which applies to all healing.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Healing")
+	TArray<FTgHealingType> HealingTypes;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
+
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Damage Types"))
+class TIMEGAME_API UTgDamageSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	//If not set, the built in physical, fire, frost, electrical, alchemical and magical types are used.
+	UPROPERTY(Config, EditAnywhere, Category = "Damage")
+	TSoftObjectPtr<UTgDamageTypeRegistry> DamageTypeRegistry;
+};
+
+/**
+ * The registry resolved to tag and attribute capture handles, so the exec calcs
+ * don't look anything up by name while executing.
+ * Built once at startup and rebuilt when the registry asset is edited.
+ */
+struct TIMEGAME_API FTgDamagePipeline
+{
+	struct FDamageType
+	{
+		FGameplayTag DamageTag;
+		FGameplayEffectAttributeCaptureDefinition ResistanceDef;
+		const UCurveFloat* MitigationCurve = nullptr;
+		float MaxMitigation = 0.8f;
+	};
+
+	struct FHealingType
+	{
+		FGameplayTag HealingTag;
+		FGameplayEffectAttributeCaptureDefinition MultiplierDef;
+	};
+
+	FGameplayTag DamageMagnitudeTag;
+	FGameplayTag LifestealTag;
+	TArray<FDamageType> DamageTypes;
+
+	FGameplayTag HealingMagnitudeTag;
+	TArray<FHealingType> HealingTypes;
+
+	static const FTgDamagePipeline& Get();
+
+	static void Rebuild();
+
+	static void Reset();
+
+	//Fraction of damage removed for a resistance value.
+	float GetMitigation(const FDamageType& DamageType, float Resistance) const;
+
+private:
+	TStrongObjectPtr<UTgDamageTypeRegistry> Registry;
+
+	bool bBuilt = false;
+
+	void BuildFromRegistry(const UTgDamageTypeRegistry& InRegistry);
+
+	void BuildDefaults();
+
+	static FTgDamagePipeline& GetMutable();
+};
@@ -0,0 +1,23 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "TgLifestealEffect.generated.h"
+
+/**
+ * Instant Health gain applied by UTgAsc for lifesteal.
+ * The amount is passed as a set by caller magnitude, so the class default
+ * object is applied directly and no effect is created per hit.
+ */
+UCLASS()
+class TIMEGAME_API UTgLifestealEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UTgLifestealEffect();
+
+	static const FName HealingDataName;
+};
@@ -0,0 +1,79 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TgRegenSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UTgCreatureAttributeSet;
+struct FGameplayAttribute;
+struct FOnAttributeChangeData;
+
+/**
+ * Server side health and energy regeneration for every registered ASC.
+ * Regen is applied to all regenerating ASCs in one pass at a fixed rate, instead of a periodic effect per creature.
+ * ASCs that are full, or have no regen, are suspended until one of the attributes involved changes.
+ * Off unless bEnabled is set, regen is a gameplay change and not every game mode wants it.
+ * Settings are in the [/Script/TimeGame.TgRegenSubsystem] section of DefaultGame.ini.
+ */
+UCLASS(Config = Game)
+class TIMEGAME_API UTgRegenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterAsc(UAbilitySystemComponent* Asc);
+
+	void UnregisterAsc(UAbilitySystemComponent* Asc);
+
+	//Only created if true, so ASCs don't regenerate unless design asks for it.
+	UPROPERTY(Config)
+	bool bEnabled = false;
+
+	//Seconds between regen passes. Regen per second is the same at any rate.
+	UPROPERTY(Config)
+	float RegenInterval = 0.25f;
+
+	int32 GetRegeneratingCount() const { return Active.Num(); }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> Asc;
+		TWeakObjectPtr<const UTgCreatureAttributeSet> AttributeSet;
+
+		//Index in Active, INDEX_NONE while suspended.
+		int32 ActiveIndex = INDEX_NONE;
+	};
+
+	TSparseArray<FEntry> Entries;
+
+	TMap<TObjectKey<UAbilitySystemComponent>, int32> EntryIds;
+
+	//Ids of the entries that are regenerating, the only ones visited each pass.
+	TArray<int32> Active;
+
+	float Elapsed = 0;
+
+	void Regenerate(float DeltaTime);
+
+	//Returns false once the attribute can't regenerate any further.
+	static bool RegenerateAttribute(UAbilitySystemComponent& Asc, const FGameplayAttribute& Attribute, float Value, float MaxValue, float Amount);
+
+	static TArray<FGameplayAttribute, TFixedAllocator<6>> GetWakeAttributes();
+
+	void OnWakeAttributeChanged(const FOnAttributeChangeData& Data, int32 EntryId);
+
+	void Resume(int32 EntryId);
+
+	void Suspend(int32 EntryId);
+};
@@ -7,9 +7,13 @@
 #include "InputAction.h"
 #include "Abilities/GameplayAbility.h"
 #include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/ObjectKey.h"
 #include "AbilityManagerComponent.generated.h"
 
 class ATgPlayerCharacter;
+class UAbilityManagerComponent;
+struct FAbilityBindingArray;
 
 UENUM(BlueprintType)
 enum class EInputActionActivationType : uint8
@@ -19,28 +23,55 @@ enum class EInputActionActivationType : uint8
 };
 
 USTRUCT(BlueprintType)
-struct FAbilityBinding
+struct FAbilityBinding : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 	
+	UPROPERTY()
 	TSubclassOf<UGameplayAbility> AbilityClass;
 
 	UPROPERTY()
 	UInputAction* InputAction;
 
+	UPROPERTY()
 	EInputActionActivationType ActivationType;
 
+	//Spec granted by the server, which has the same handle on the owning client.
+	UPROPERTY()
+	FGameplayAbilitySpecHandle SpecHandle;
+
 	FAbilityBinding();
 
-	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	void PostReplicatedAdd(const FAbilityBindingArray& InArraySerializer);
+
+	void PostReplicatedChange(const FAbilityBindingArray& InArraySerializer);
+
+	void PreReplicatedRemove(const FAbilityBindingArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FAbilityBindingArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FAbilityBinding> Items;
+
+	UPROPERTY(NotReplicated)
+	UAbilityManagerComponent* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FastArrayDeltaSerialize<FAbilityBinding, FAbilityBindingArray>(Items, DeltaParams, *this);
+	}
 };
 
 template<>
-struct TStructOpsTypeTraits<FAbilityBinding> : public TStructOpsTypeTraitsBase2<FAbilityBinding>
+struct TStructOpsTypeTraits<FAbilityBindingArray> : public TStructOpsTypeTraitsBase2<FAbilityBindingArray>
 {
 	enum
 	{
-		WithNetSerializer = true,
+		WithNetDeltaSerializer = true,
 	};
 };
 
@@ -63,9 +94,6 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	void RemoveActiveAbility(const TSubclassOf<UGameplayAbility>& Ability);
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable)
-	void UpdateAbilityBindings(const TArray<FAbilityBinding>& InAbilityBindings);
-
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	float GetCooldown(const TSubclassOf<UGameplayAbility>& Ability) const;
 
@@ -83,7 +111,11 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	void RemoveInfiniteEffect(const TSubclassOf<UGameplayEffect>& Effect);
 	
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
+	friend struct FAbilityBinding;
+
 	virtual void BeginPlay() override;
 
 	UPROPERTY()
@@ -92,8 +124,21 @@ protected:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayEffect>, FActiveGameplayEffectHandle> ServerGrantedEffects;
 
-	UPROPERTY()
-	TArray<FAbilityBinding> AbilityBindings;
+	//Only the owning player activates abilities through bindings.
+	UPROPERTY(Replicated)
+	FAbilityBindingArray AbilityBindings;
+
+	using FInputBindingKey = TPair<TObjectKey<UInputAction>, EInputActionActivationType>;
+
+	//Spec to activate for an input, built from AbilityBindings on the server and the owning client.
+	TMap<FInputBindingKey, FGameplayAbilitySpecHandle> InputBindings;
+
+	//Set when bindings were changed or removed by replication.
+	bool bInputBindingsDirty = false;
+
+	void AddInputBinding(const FAbilityBinding& Binding);
+
+	void RebuildInputBindings();
 
 	UPROPERTY()
 	ATgPlayerCharacter* PlayerCharacter;
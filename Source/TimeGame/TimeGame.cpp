@@ -1,7 +1,27 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TimeGame/TimeGame.h"
+#include "Gas/TgDamageTypeRegistry.h"
+#include "Misc/CoreDelegates.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TimeGame, "TimeGame" );
- 
\ No newline at end of file
+class FTimeGameModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		//Assets can't be loaded yet, resolve the damage types once the engine is up.
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&FTgDamagePipeline::Rebuild);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		FTgDamagePipeline::Reset();
+	}
+
+private:
+	FDelegateHandle PostEngineInitHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FTimeGameModule, TimeGame, "TimeGame" );